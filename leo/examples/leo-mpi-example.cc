@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/leo-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LeoMpiExample");
+
+/*
+ * Partitions a +Grid constellation across MPI ranks by orbital plane and
+ * echoes UDP packets between a satellite of the first plane and one of the
+ * last plane. Run it with e.g.
+ *
+ *   ./ns3 run leo-mpi-example --command-template="mpirun -np 4 %s"
+ */
+
+uint64_t echoed = 0;
+
+static void
+EchoRx (Ptr<const Packet> packet)
+{
+  echoed ++;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t planes = 24;
+  uint32_t sats = 22;
+  double altitude = 550;
+  double inclination = 53;
+  double duration = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("planes", "Number of orbital planes", planes);
+  cmd.AddValue ("sats", "Number of satellites in each plane", sats);
+  cmd.AddValue ("altitude", "Altitude of the orbits in km", altitude);
+  cmd.AddValue ("inclination", "Inclination of the orbits in degrees", inclination);
+  cmd.AddValue ("duration", "Duration of the simulation in seconds", duration);
+  cmd.AddValue ("precision", "ns3::GeoLeoOrbitMobility::Precision");
+  cmd.Parse (argc, argv);
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+  MpiInterface::Enable (&argc, &argv);
+  uint32_t rank = MpiInterface::GetSystemId ();
+
+  LeoOrbit shell (altitude, inclination, planes, sats);
+  LeoPlanePartitioner partitioner;
+  partitioner.SetNSystems (MpiInterface::GetSize ());
+  partitioner.BoundLookAhead ({ shell });
+
+  // every rank builds the whole constellation, and only simulates its planes
+  LeoOrbitNodeHelper orbit;
+  orbit.SetPartitioner (partitioner);
+  NodeContainer satellites = orbit.Install (shell);
+
+  IslHelper islCh;
+  NetDeviceContainer islNet = islCh.InstallGrid (satellites, shell);
+
+  LeoSnapshotRoutingHelper routing;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (routing);
+  stack.Install (satellites);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer islIp = ipv4.Assign (islNet);
+
+  ArpCacheHelper arpCache;
+  arpCache.Install (islNet, islIp);
+
+  Ptr<Node> client = satellites.Get (0);
+  Ptr<Node> server = satellites.Get (satellites.GetN () - 1);
+  Ipv4Address serverAddress = server->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+  uint16_t port = 9;
+
+  // applications only run on the rank that simulates their node
+  if (server->GetSystemId () == rank)
+    {
+      UdpEchoServerHelper echoServer (port);
+      ApplicationContainer apps = echoServer.Install (server);
+      apps.Start (Seconds (0.0));
+      apps.Stop (Seconds (duration));
+    }
+  if (client->GetSystemId () == rank)
+    {
+      UdpEchoClientHelper echoClient (serverAddress, port);
+      echoClient.SetAttribute ("MaxPackets", UintegerValue (duration * 10));
+      echoClient.SetAttribute ("Interval", TimeValue (MilliSeconds (100)));
+      echoClient.SetAttribute ("PacketSize", UintegerValue (512));
+      ApplicationContainer apps = echoClient.Install (client);
+      apps.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&EchoRx));
+      apps.Start (Seconds (1.0));
+      apps.Stop (Seconds (duration));
+    }
+
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+
+  if (client->GetSystemId () == rank)
+    {
+      std::cout << "rank " << rank << ": " << echoed << " packets echoed from node "
+                << server->GetId () << " on rank " << server->GetSystemId () << std::endl;
+    }
+
+  Simulator::Destroy ();
+  MpiInterface::Disable ();
+  return 0;
+}
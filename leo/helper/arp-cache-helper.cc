@@ -20,7 +20,8 @@
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/log.h"
-#include "../model/leo-mock-net-device.h"
+#include "../model/mock-channel.h"
+#include "../model/mock-net-device.h"
 
 #include "arp-cache-helper.h"
 
@@ -33,45 +34,23 @@ void
 ArpCacheHelper::Install (NetDeviceContainer &devices, Ipv4InterfaceContainer &interfaces) const
 {
   NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (devices.GetN () == interfaces.GetN (), "One interface is needed for each device");
 
   for (size_t i = 0; i < devices.GetN (); i ++)
     {
-      Ptr<NetDevice> dev = devices.Get (i);
-      Ptr<Node> node = dev->GetNode ();
-      NS_LOG_INFO ("Preparing ARP cache of " << node);
-      Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol> ();
-      int32_t ifIndex = ipv4->GetInterfaceForDevice (dev);
-      Ptr<Ipv4Interface> interface = ipv4->GetInterface (ifIndex);
-      Ptr<ArpCache> cache = interface->GetArpCache ();
-
-      for (uint32_t j = 0; j < devices.GetN (); j++)
+      Ptr<MockNetDevice> dev = DynamicCast<MockNetDevice> (devices.Get (i));
+      if (dev == nullptr)
         {
-          // every other device, that is not of same "type"
-          Ptr<NetDevice> otherDevice = devices.Get (j);
-          Ptr<LeoMockNetDevice> leoDev = DynamicCast<LeoMockNetDevice> (dev);
-          Ptr<LeoMockNetDevice> otherLeoDev = DynamicCast<LeoMockNetDevice> (otherDevice);
-          if (i == j || (leoDev != nullptr
-              && otherLeoDev != nullptr
-              && leoDev->GetDeviceType () == otherLeoDev->GetDeviceType ()))
-            {
-              continue;
-            }
-          Address address = otherDevice->GetAddress (); // MAC
-
-          // and associated address
-          uint32_t otherIfIndex = otherDevice->GetIfIndex ();
-          Ipv4Address ipaddr = interfaces.GetAddress (otherIfIndex, 0); // IP
+          NS_LOG_WARN ("Device " << devices.Get (i) << " is not a MockNetDevice, skipping it");
+          continue;
+        }
+      Ptr<MockChannel> channel = DynamicCast<MockChannel> (dev->GetChannel ());
+      NS_ASSERT_MSG (channel != nullptr, "Device " << dev << " is not attached to a MockChannel");
 
-          // update cache
-          ArpCache::Entry* entry = cache->Lookup (ipaddr);
-          if (entry == 0)
-            {
-              entry = cache->Add (ipaddr);
-            }
-          entry->SetMacAddress (address);
+      Ipv4Address ipaddr = interfaces.GetAddress (i, 0);
+      channel->AddNeighbor (ipaddr, dev);
 
-	  NS_LOG_DEBUG ("Added entry for " << address);
-      	}
+      NS_LOG_DEBUG ("Added entry for " << ipaddr << " at " << dev->GetAddress ());
     }
 }
 
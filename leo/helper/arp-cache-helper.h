@@ -35,15 +35,21 @@ namespace ns3 {
 
 /**
  * \ingroup leo
- * \brief Prepares the ARP cache, so the addresses do not have to be queried
+ * \brief Prepares the address resolution, so the addresses do not have to be
+ * queried over the channel
+ *
+ * Each address is added once to the neighbour table of the MockChannel of
+ * its device. The devices answer ARP requests from that table on demand, so
+ * the ARP caches only hold the neighbours that are actually used.
  */
 class ArpCacheHelper
 {
 public:
   /**
-   * \brief Install the addresses of the interfaces into the ARP caches of the devices
-   * \param devices devices
-   * \param interfaces interfaces
+   * \brief Install the addresses of the interfaces into the neighbour tables of
+   * the channels of the devices
+   * \param devices MockNetDevices
+   * \param interfaces interfaces, in the same order of the devices
    */
   void Install (NetDeviceContainer &devices, Ipv4InterfaceContainer &interfaces) const;
 
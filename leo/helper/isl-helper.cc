@@ -30,6 +30,9 @@
 #include "ns3/names.h"
 #include "ns3/trace-helper.h"
 #include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "ns3/propagation-loss-model.h"
 
 #include "../model/mock-net-device.h"
 #include "../model/isl-mock-channel.h"
@@ -39,7 +42,50 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("IslHelper");
 
+/**
+ * \brief Create a copy of a chain of propagation loss models
+ * \param loss the first model of the chain
+ * \return the first model of the copy, with the same types and attributes
+ */
+static Ptr<PropagationLossModel>
+CopyPropagationLoss (Ptr<PropagationLossModel> loss)
+{
+  if (loss == nullptr)
+    {
+      return nullptr;
+    }
+
+  ObjectFactory factory;
+  factory.SetTypeId (loss->GetInstanceTypeId ());
+  for (TypeId tid = loss->GetInstanceTypeId (); tid != Object::GetTypeId (); tid = tid.GetParent ())
+    {
+      for (std::size_t i = 0; i < tid.GetAttributeN (); i ++)
+        {
+          TypeId::AttributeInformation info = tid.GetAttribute (i);
+          if (!(info.flags & TypeId::ATTR_GET) || !(info.flags & TypeId::ATTR_CONSTRUCT)
+              || !info.accessor->HasGetter () || !info.accessor->HasSetter ())
+            {
+              continue;
+            }
+          Ptr<AttributeValue> value = info.checker->Create ();
+          if (info.accessor->Get (PeekPointer (loss), *value))
+            {
+              factory.Set (info.name, *value);
+            }
+        }
+    }
+
+  Ptr<PropagationLossModel> copy = factory.Create<PropagationLossModel> ();
+  Ptr<PropagationLossModel> next = CopyPropagationLoss (loss->GetNext ());
+  if (next != nullptr)
+    {
+      copy->SetNext (next);
+    }
+  return copy;
+}
+
 IslHelper::IslHelper ()
+  : m_seamRange (5000000.0)
 {
   m_queueFactory.SetTypeId ("ns3::DropTailQueue<Packet>");
   m_deviceFactory.SetTypeId ("ns3::MockNetDevice");
@@ -224,6 +270,19 @@ IslHelper::Install (NodeContainer c)
   return Install (nodes);
 }
 
+Ptr<MockNetDevice>
+IslHelper::InstallDevice (Ptr<Node> node, Ptr<MockChannel> channel)
+{
+  NS_LOG_DEBUG ("Adding device for node " << node->GetId ());
+  Ptr<MockNetDevice> dev = m_deviceFactory.Create<MockNetDevice> ();
+  dev->SetAddress (Mac48Address::Allocate ());
+  node->AddDevice (dev);
+  Ptr<Queue<Packet> > queue = m_queueFactory.Create<Queue<Packet> > ();
+  dev->SetQueue (queue);
+  dev->Attach (channel);
+  return dev;
+}
+
 NetDeviceContainer
 IslHelper::Install (std::vector<Ptr<Node> > &nodes)
 {
@@ -235,19 +294,97 @@ IslHelper::Install (std::vector<Ptr<Node> > &nodes)
 
   for (Ptr<Node> node: nodes)
   {
-    NS_LOG_DEBUG ("Adding device for node " << node->GetId ());
-    Ptr<MockNetDevice> dev = m_deviceFactory.Create<MockNetDevice> ();
-    dev->SetAddress (Mac48Address::Allocate ());
-    node->AddDevice (dev);
-    Ptr<Queue<Packet> > queue = m_queueFactory.Create<Queue<Packet> > ();
-    dev->SetQueue (queue);
-    dev->Attach (channel);
-    container.Add (dev);
+    container.Add (InstallDevice (node, channel));
   }
 
   return container;
 }
 
+void
+IslHelper::SetSeamRange (double range)
+{
+  m_seamRange = range;
+}
+
+void
+IslHelper::InstallLink (Ptr<Node> a, Ptr<Node> b, bool rangeLimited, NetDeviceContainer &container)
+{
+  NS_LOG_FUNCTION (this << a->GetId () << b->GetId () << rangeLimited);
+
+  Ptr<MockChannel> channel = m_channelFactory.Create<MockChannel> ();
+  if (rangeLimited)
+    {
+      // the satellites across the seam fly in opposite directions, so the
+      // link is only usable while they are close enough. The loss model set
+      // through the channel factory is shared by every channel, so the seam
+      // gets a copy of its chain, with the range limit at the end.
+      Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel> ();
+      range->SetAttribute ("MaxRange", DoubleValue (m_seamRange));
+      Ptr<PropagationLossModel> loss = CopyPropagationLoss (channel->GetPropagationLoss ());
+      if (loss == nullptr)
+        {
+          loss = range;
+        }
+      else
+        {
+          Ptr<PropagationLossModel> last = loss;
+          while (last->GetNext () != nullptr)
+            {
+              last = last->GetNext ();
+            }
+          last->SetNext (range);
+        }
+      channel->SetPropagationLoss (loss);
+    }
+
+  container.Add (InstallDevice (a, channel));
+  container.Add (InstallDevice (b, channel));
+}
+
+NetDeviceContainer
+IslHelper::InstallGrid (NodeContainer c, uint32_t planes, uint32_t satsPerPlane, SeamMode seam)
+{
+  NS_LOG_FUNCTION (this << planes << satsPerPlane << seam);
+  NS_ABORT_MSG_IF (c.GetN () != planes * satsPerPlane,
+                   "IslHelper::InstallGrid(): expected " << planes * satsPerPlane
+                   << " satellites, got " << c.GetN ());
+
+  NetDeviceContainer container;
+  for (uint32_t plane = 0; plane < planes; plane ++)
+    {
+      for (uint32_t slot = 0; slot < satsPerPlane; slot ++)
+        {
+          Ptr<Node> sat = c.Get (plane * satsPerPlane + slot);
+
+          // intra-plane link to the next satellite, closing the ring without
+          // linking the same pair twice in planes with two satellites
+          if (slot + 1 < satsPerPlane || satsPerPlane > 2)
+            {
+              InstallLink (sat, c.Get (plane * satsPerPlane + (slot + 1) % satsPerPlane), false, container);
+            }
+
+          // inter-plane link to the same slot in the next plane
+          if (plane + 1 < planes)
+            {
+              InstallLink (sat, c.Get ((plane + 1) * satsPerPlane + slot), false, container);
+            }
+          else if (planes > 2 && seam != SEAM_NONE)
+            {
+              InstallLink (sat, c.Get (slot), seam == SEAM_DYNAMIC, container);
+            }
+        }
+    }
+
+  NS_LOG_DEBUG ("Installed " << container.GetN () / 2 << " ISLs for " << c.GetN () << " satellites");
+  return container;
+}
+
+NetDeviceContainer
+IslHelper::InstallGrid (NodeContainer c, const LeoOrbit &orbit, SeamMode seam)
+{
+  return InstallGrid (c, orbit.planes, orbit.sats, seam);
+}
+
 NetDeviceContainer
 IslHelper::Install (std::vector<std::string> &names)
 {
@@ -26,6 +26,7 @@
 #include <ns3/node-container.h>
 
 #include <ns3/trace-helper.h>
+#include <ns3/leo-orbit.h>
 
 /**
  * \file
@@ -37,6 +38,8 @@ namespace ns3 {
 
 class NetDevice;
 class Node;
+class MockChannel;
+class MockNetDevice;
 
 /**
  * \ingroup leo
@@ -46,6 +49,16 @@ class IslHelper : public PcapHelperForDevice,
 	                   public AsciiTraceHelperForDevice
 {
 public:
+  /**
+   * How the links between the last and the first plane of a +Grid are handled
+   */
+  enum SeamMode
+  {
+    SEAM_NONE,     /**< No links across the seam */
+    SEAM_STATIC,   /**< Permanent links across the seam */
+    SEAM_DYNAMIC   /**< Links across the seam that only carry traffic within the seam range */
+  };
+
   /**
    * Create a IslHelper to make life easier when creating ISL networks.
    */
@@ -130,6 +143,40 @@ public:
    */
   NetDeviceContainer Install (std::vector<std::string> &nodes);
 
+  /**
+   * \param c satellites, ordered by plane and then by slot in the plane, as
+   * created by LeoOrbitNodeHelper
+   * \param planes number of orbital planes
+   * \param satsPerPlane number of satellites in each plane
+   * \param seam handling of the links between the last and the first plane
+   * \return a NetDeviceContainer with the two devices of each link, in link order
+   *
+   * This method builds a +Grid topology: each satellite is linked to the
+   * previous and the next satellite of its plane and to the satellites in
+   * the same slot of the neighbouring planes. Each link gets its own
+   * ns3::IslMockChannel with two ns3::MockNetDevice, so broadcasts and LOS
+   * checks only involve the neighbours instead of the whole constellation.
+   */
+  NetDeviceContainer InstallGrid (NodeContainer c,
+                                  uint32_t planes,
+                                  uint32_t satsPerPlane,
+                                  SeamMode seam = SEAM_STATIC);
+
+  /**
+   * \param c satellites of one shell, as created by LeoOrbitNodeHelper
+   * \param orbit the orbit definition of the shell
+   * \param seam handling of the links between the last and the first plane
+   * \return a NetDeviceContainer with the two devices of each link, in link order
+   *
+   * Saves you from having to pass the size of the grid.
+   */
+  NetDeviceContainer InstallGrid (NodeContainer c, const LeoOrbit &orbit, SeamMode seam = SEAM_STATIC);
+
+  /**
+   * \param range maximum distance in meters at which SEAM_DYNAMIC links carry traffic
+   */
+  void SetSeamRange (double range);
+
   /**
    * \brief Enable pcap output the indicated net device.
    *
@@ -161,6 +208,24 @@ public:
     bool explicitFilename);
 
 private:
+  /**
+   * \brief Create a device with its queue on a node and attach it to a channel
+   * \param node the node
+   * \param channel the channel
+   * \return the device
+   */
+  Ptr<MockNetDevice> InstallDevice (Ptr<Node> node, Ptr<MockChannel> channel);
+
+  /**
+   * \brief Create a point to point link between two satellites
+   * \param a first satellite
+   * \param b second satellite
+   * \param rangeLimited whether the link only carries traffic within the seam range
+   * \param container container to add the two devices to
+   */
+  void InstallLink (Ptr<Node> a, Ptr<Node> b, bool rangeLimited, NetDeviceContainer &container);
+
+  double m_seamRange;                   //!< Range of SEAM_DYNAMIC links in meters
   ObjectFactory m_queueFactory;         //!< Queue Factory
   ObjectFactory m_channelFactory;       //!< Channel Factory
   ObjectFactory m_deviceFactory;        //!< Device Factory
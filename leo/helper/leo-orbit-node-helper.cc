@@ -56,8 +56,12 @@ LeoOrbitNodeHelper::Install(const LeoOrbit& orbit)
 {
     NS_LOG_FUNCTION(this << orbit);
 
+    // Satellites of a plane belong to the same rank
     NodeContainer c;
-    c.Create(orbit.sats * orbit.planes);
+    for (uint32_t plane = 0; plane < orbit.planes; plane++)
+    {
+        c.Create(orbit.sats, m_partitioner.GetSystemId(plane, orbit.planes));
+    }
 
     // Calculate spacing between orbital planes and satellites
     double longitudeSpacing = 360.0 / orbit.planes; // degrees
@@ -155,6 +159,12 @@ LeoOrbitNodeHelper::SetPrecision(Time precision)
     m_precision = precision;
 }
 
+void
+LeoOrbitNodeHelper::SetPartitioner(const LeoPlanePartitioner& partitioner)
+{
+    m_partitioner = partitioner;
+}
+
 NodeContainer
 LeoOrbitNodeHelper::Install(const std::string& orbitFile)
 {
@@ -20,6 +20,7 @@
 #define LEO_ORBIT_NODE_HELPER_H
 
 #include "ns3/leo-orbit.h"
+#include "ns3/leo-plane-partitioner.h"
 #include "ns3/node-container.h"
 #include "ns3/nstime.h"
 #include "ns3/object-factory.h"
@@ -89,11 +90,20 @@ class LeoOrbitNodeHelper
 
     void SetPrecision(Time precision);
 
+    /**
+     * Set the assignment of the planes to MPI ranks
+     *
+     * \param partitioner the partitioner
+     */
+    void SetPartitioner(const LeoPlanePartitioner& partitioner);
+
   private:
     /// Factory for nodes
     ObjectFactory m_nodeFactory;
     // Precision of the position allocator
     Time m_precision = Seconds(1.0); // Default precision
+    /// Assignment of the planes to ranks
+    LeoPlanePartitioner m_partitioner;
 };
 
 }; // namespace ns3
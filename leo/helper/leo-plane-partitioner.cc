@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "leo-plane-partitioner.h"
+
+#include "ns3/geographic-positions.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#ifdef NS3_MPI
+#include "ns3/distributed-simulator-impl.h"
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+NS_LOG_COMPONENT_DEFINE("LeoPlanePartitioner");
+
+/// Speed of the ConstantSpeedPropagationDelayModel of the channels in m/s
+static const double LEO_SPEED_OF_LIGHT = 299792458.0;
+
+LeoPlanePartitioner::LeoPlanePartitioner()
+    : m_nSystems(1)
+{
+}
+
+void
+LeoPlanePartitioner::SetNSystems(uint32_t n)
+{
+    NS_ABORT_MSG_IF(n == 0, "LeoPlanePartitioner needs at least one system");
+    m_nSystems = n;
+}
+
+uint32_t
+LeoPlanePartitioner::GetNSystems() const
+{
+    return m_nSystems;
+}
+
+uint32_t
+LeoPlanePartitioner::GetSystemId(uint32_t plane, uint32_t planes) const
+{
+    NS_ASSERT(plane < planes);
+    return static_cast<uint64_t>(plane) * m_nSystems / planes;
+}
+
+Time
+LeoPlanePartitioner::GetLookAhead(const std::vector<LeoOrbit>& orbits)
+{
+    double distance = std::numeric_limits<double>::infinity();
+    for (const LeoOrbit& orbit : orbits)
+    {
+        // ground nodes are closest to a satellite right below it
+        double altitude = orbit.alt * 1000.0;
+        distance = std::min(distance, altitude);
+
+        if (orbit.planes < 2)
+        {
+            continue;
+        }
+        // satellites in the same slot of adjacent planes are closest where
+        // the planes cross, at their highest latitude
+        double radius = GeographicPositions::EARTH_SPHERE_RADIUS + altitude;
+        double inc = orbit.inc * M_PI / 180.0;
+        double raan = 2 * M_PI / orbit.planes;
+        double cosAngle = std::pow(std::cos(inc), 2) * std::cos(raan) + std::pow(std::sin(inc), 2);
+        double angle = std::acos(std::min(1.0, cosAngle));
+        distance = std::min(distance, 2 * radius * std::sin(angle / 2));
+    }
+
+    NS_ABORT_MSG_IF(distance <= 0.0,
+                    "Satellites of adjacent planes meet, there is no lookahead between ranks");
+    return Seconds(distance / LEO_SPEED_OF_LIGHT);
+}
+
+void
+LeoPlanePartitioner::BoundLookAhead(const std::vector<LeoOrbit>& orbits) const
+{
+    Time lookAhead = GetLookAhead(orbits);
+    NS_LOG_FUNCTION(this << lookAhead);
+#ifdef NS3_MPI
+    Ptr<DistributedSimulatorImpl> impl =
+        DynamicCast<DistributedSimulatorImpl>(Simulator::GetImplementation());
+    if (impl != nullptr)
+    {
+        impl->BoundLookAhead(lookAhead);
+        NS_LOG_INFO("rank " << MpiInterface::GetSystemId() << " lookahead bound to "
+                            << lookAhead.As(Time::MS));
+        return;
+    }
+    NS_LOG_WARN("The simulator is not a DistributedSimulatorImpl, lookahead not bound");
+#else
+    NS_LOG_WARN("Built without MPI, lookahead not bound");
+#endif
+}
+
+}; // namespace ns3
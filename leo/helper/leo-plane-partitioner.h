@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LEO_PLANE_PARTITIONER_H
+#define LEO_PLANE_PARTITIONER_H
+
+#include "ns3/leo-orbit.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup leo
+ * Declares LeoPlanePartitioner
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup leo
+ * \brief Assigns the orbital planes of a constellation to MPI ranks
+ *
+ * Each rank simulates a contiguous block of planes, so the intra-plane ISLs
+ * and most inter-plane ISLs of a +Grid stay within one rank. Only the links
+ * at the borders of the blocks and the links to ground nodes cross ranks.
+ *
+ * The lookahead of the distributed simulator is derived from the shortest
+ * of those links: the altitude of the lowest orbit for ground links, and the
+ * closest approach of the satellites in the same slot of adjacent planes for
+ * ISLs. MockChannels are not point-to-point, so the simulator does not find
+ * that bound by itself.
+ */
+class LeoPlanePartitioner
+{
+  public:
+    /// constructor
+    LeoPlanePartitioner();
+
+    /**
+     * \brief Set the number of ranks
+     * \param n number of ranks, usually MpiInterface::GetSize ()
+     */
+    void SetNSystems(uint32_t n);
+
+    /**
+     * \brief Get the number of ranks
+     * \return number of ranks
+     */
+    uint32_t GetNSystems() const;
+
+    /**
+     * \brief Get the rank simulating a plane
+     * \param plane index of the plane
+     * \param planes number of planes of the orbit
+     * \return the system id of the satellites of the plane
+     */
+    uint32_t GetSystemId(uint32_t plane, uint32_t planes) const;
+
+    /**
+     * \brief Get the shortest propagation delay of a link between two ranks
+     * \param orbits orbits of the constellation, connected as a +Grid
+     * \return the lookahead
+     */
+    static Time GetLookAhead(const std::vector<LeoOrbit>& orbits);
+
+    /**
+     * \brief Bound the lookahead of the distributed simulator
+     *
+     * Must be called before the simulation starts, on every rank.
+     *
+     * \param orbits orbits of the constellation, connected as a +Grid
+     */
+    void BoundLookAhead(const std::vector<LeoOrbit>& orbits) const;
+
+  private:
+    /// Number of ranks
+    uint32_t m_nSystems;
+};
+
+}; // namespace ns3
+
+#endif
@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "leo-snapshot-routing-helper.h"
+
+#include "ns3/leo-snapshot-routing.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LeoSnapshotRoutingHelper");
+
+LeoSnapshotRoutingHelper::LeoSnapshotRoutingHelper ()
+  : m_snapshots (CreateObject<LeoRoutingSnapshots> ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LeoSnapshotRoutingHelper*
+LeoSnapshotRoutingHelper::Copy (void) const
+{
+  return new LeoSnapshotRoutingHelper (*this);
+}
+
+Ptr<Ipv4RoutingProtocol>
+LeoSnapshotRoutingHelper::Create (Ptr<Node> node) const
+{
+  NS_LOG_FUNCTION (this << node->GetId ());
+  Ptr<LeoSnapshotRouting> routing = CreateObject<LeoSnapshotRouting> ();
+  routing->SetSnapshots (m_snapshots);
+  return routing;
+}
+
+void
+LeoSnapshotRoutingHelper::SetAttribute (std::string name, const AttributeValue &value)
+{
+  m_snapshots->SetAttribute (name, value);
+}
+
+Ptr<LeoRoutingSnapshots>
+LeoSnapshotRoutingHelper::GetSnapshots (void) const
+{
+  return m_snapshots;
+}
+
+}; /* namespace ns3 */
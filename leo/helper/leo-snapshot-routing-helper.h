@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LEO_SNAPSHOT_ROUTING_HELPER_H
+#define LEO_SNAPSHOT_ROUTING_HELPER_H
+
+#include "ns3/internet-module.h"
+#include "ns3/leo-routing-snapshots.h"
+
+#include <string>
+
+/**
+ * \file
+ * \ingroup leo
+ * Declares LeoSnapshotRoutingHelper
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup leo
+ * \brief Installs LeoSnapshotRouting on the nodes of a constellation
+ *
+ * The helper and its copies share one LeoRoutingSnapshots, so all the nodes
+ * installed through the same InternetStackHelper use the same tables.
+ */
+class LeoSnapshotRoutingHelper : public Ipv4RoutingHelper
+{
+public:
+  /// constructor
+  LeoSnapshotRoutingHelper ();
+
+  LeoSnapshotRoutingHelper* Copy (void) const override;
+  Ptr<Ipv4RoutingProtocol> Create (Ptr<Node> node) const override;
+
+  /**
+   * \brief Set an attribute of the shared LeoRoutingSnapshots
+   * \param name name of the attribute
+   * \param value value of the attribute
+   */
+  void SetAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * \brief Get the tables shared by the nodes
+   * \return the tables
+   */
+  Ptr<LeoRoutingSnapshots> GetSnapshots (void) const;
+
+private:
+  Ptr<LeoRoutingSnapshots> m_snapshots; ///< Tables shared by the nodes
+};
+
+}; /* namespace ns3 */
+
+#endif /* LEO_SNAPSHOT_ROUTING_HELPER_H */
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ADAPTIVE_UPDATE_POLICY_H
+#define ADAPTIVE_UPDATE_POLICY_H
+
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup leo
+ *
+ * Declaration of AdaptiveUpdatePolicy
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup leo
+ * \brief Schedule of the CourseChange notifications of a continuous mobility model
+ *
+ * Instead of notifying CourseChange at a fixed Precision, a model using this
+ * policy computes its position on demand and only checks it at the times given
+ * by GetNextDelay. It notifies CourseChange when Check finds that the node has
+ * moved by at least a tolerance since the last notification.
+ *
+ * The next check is placed when the node would have covered the remaining
+ * distance to the tolerance at the highest of the speed reported by the model
+ * and the speed observed between the last two checks, and at most a maximum
+ * interval later. Stationary and slow nodes are therefore checked rarely, and
+ * fast nodes about once per tolerance travelled.
+ */
+class AdaptiveUpdatePolicy
+{
+  public:
+    /**
+     * \brief Record the position of a CourseChange notification
+     * \param position the geocentric position in meters
+     * \param now the current time
+     */
+    void Notified(const Vector& position, Time now)
+    {
+        m_notified = position;
+        m_last = position;
+        m_lastTime = now;
+        m_displacement = 0;
+    }
+
+    /**
+     * \brief Check the position of the node
+     * \param position the geocentric position in meters
+     * \param now the current time
+     * \param tolerance the distance the node may move before notifying, in meters
+     * \return true iff CourseChange has to be notified
+     */
+    bool Check(const Vector& position, Time now, double tolerance)
+    {
+        double dt = (now - m_lastTime).GetSeconds();
+        if (dt > 0)
+        {
+            m_observedSpeed = CalculateDistance(position, m_last) / dt;
+            m_sampled = true;
+        }
+        m_last = position;
+        m_lastTime = now;
+        m_displacement = CalculateDistance(position, m_notified);
+        return m_displacement >= tolerance;
+    }
+
+    /**
+     * \brief Whether the speed has been observed between two checks
+     * \return true iff a check has happened after the last one or the last notification
+     */
+    bool HasObservedSpeed() const
+    {
+        return m_sampled;
+    }
+
+    /**
+     * \brief Get the delay to the next check
+     * \param speed the speed reported by the model, in m/s
+     * \param tolerance the distance the node may move before notifying, in meters
+     * \param maxInterval the longest time between two checks
+     * \return the delay, never zero
+     */
+    Time GetNextDelay(double speed, double tolerance, Time maxInterval) const
+    {
+        speed = std::max(speed, m_observedSpeed);
+        Time delay = maxInterval;
+        if (speed > 0)
+        {
+            delay = std::min(delay, Seconds((tolerance - m_displacement) / speed));
+        }
+        return std::max(delay, TimeStep(1));
+    }
+
+  private:
+    Vector m_notified;          ///< Position at the last notification
+    Vector m_last;              ///< Position at the last check
+    Time m_lastTime;            ///< Time of the last check
+    double m_displacement = 0;  ///< Distance from m_notified at the last check
+    double m_observedSpeed = 0; ///< Speed between the last two checks, in m/s
+    bool m_sampled = false;     ///< Whether m_observedSpeed has been measured
+};
+
+} // namespace ns3
+
+#endif /* ADAPTIVE_UPDATE_POLICY_H */
@@ -64,6 +64,21 @@ GeoLeoOrbitMobility::GetTypeId()
                       TimeValue(Seconds(1)),
                       MakeTimeAccessor(&GeoLeoOrbitMobility::SetPrecision),
                       MakeTimeChecker())
+        .AddAttribute("CourseChangeTolerance",
+                      "If positive, positions are computed on demand and CourseChange is only "
+                      "notified once the satellite has moved by this distance in meters. The "
+                      "position is checked when the satellite is expected to have covered it, "
+                      "instead of at each Precision. 0 means fixed Precision updates",
+                      DoubleValue(0.0),
+                      MakeDoubleAccessor(&GeoLeoOrbitMobility::SetCourseChangeTolerance,
+                                         &GeoLeoOrbitMobility::GetCourseChangeTolerance),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("MaxUpdateInterval",
+                      "The longest time between two position checks when CourseChangeTolerance "
+                      "is positive",
+                      TimeValue(Seconds(60)),
+                      MakeTimeAccessor(&GeoLeoOrbitMobility::m_maxUpdateInterval),
+                      MakeTimeChecker())
         .AddAttribute("Longitude",
                       "The longitude offset of the satellite in degrees",
                       DoubleValue(0.0),
@@ -455,6 +470,8 @@ GeoLeoOrbitMobility::Update()
 {
     // Use classical orbital model
     m_position = CalcPosition(Simulator::Now());
+    m_nUpdates++;
+    m_positionCache.Invalidate();
 
     NotifyCourseChange();
     if (m_updateEvent.IsPending())
@@ -462,12 +479,42 @@ GeoLeoOrbitMobility::Update()
         Simulator::Cancel(m_updateEvent);
         m_updateEvent = EventId(); // Reset the event
     }
-    if (m_precision > Seconds(0))
+    if (m_courseChangeTolerance > 0)
+    {
+        m_adaptiveUpdate.Notified(m_position, Simulator::Now());
+        m_updateEvent = Simulator::Schedule(
+            m_adaptiveUpdate.GetNextDelay(GetSpeed(), m_courseChangeTolerance, m_maxUpdateInterval),
+            &GeoLeoOrbitMobility::CheckCourseChange,
+            this);
+    }
+    else if (m_precision > Seconds(0))
     {
         m_updateEvent = Simulator::Schedule(m_precision, &GeoLeoOrbitMobility::Update, this);
     }
 }
 
+void
+GeoLeoOrbitMobility::CheckCourseChange()
+{
+    if (m_adaptiveUpdate.Check(DoGetPosition(PositionType::GEOCENTRIC),
+                               Simulator::Now(),
+                               m_courseChangeTolerance))
+    {
+        Update();
+        return;
+    }
+    m_updateEvent = Simulator::Schedule(
+        m_adaptiveUpdate.GetNextDelay(GetSpeed(), m_courseChangeTolerance, m_maxUpdateInterval),
+        &GeoLeoOrbitMobility::CheckCourseChange,
+        this);
+}
+
+bool
+GeoLeoOrbitMobility::IsOnDemand() const
+{
+    return m_precision == Time(0) || m_courseChangeTolerance > 0;
+}
+
 void
 GeoLeoOrbitMobility::SetPrecision(Time precision)
 {
@@ -475,6 +522,19 @@ GeoLeoOrbitMobility::SetPrecision(Time precision)
     Update();
 }
 
+void
+GeoLeoOrbitMobility::SetCourseChangeTolerance(double tolerance)
+{
+    m_courseChangeTolerance = tolerance;
+    Update();
+}
+
+double
+GeoLeoOrbitMobility::GetCourseChangeTolerance() const
+{
+    return m_courseChangeTolerance;
+}
+
 double
 GeoLeoOrbitMobility::GetAltitude() const
 {
@@ -505,33 +565,44 @@ GeoLeoOrbitMobility::SetInclination(double incl)
 Vector
 GeoLeoOrbitMobility::DoGetPosition(PositionType type) const
 {
-    Vector geocentricPos;
-    if (m_precision == Time(0))
+    // Positions computed on demand change with time, the others at each Update
+    int64_t key = IsOnDemand() ? Simulator::Now().GetTimeStep() : m_nUpdates;
+    Vector position;
+    m_positionCache.SetFrame(GetEarthSpheroidType(), GetGeographicReferencePoint());
+    if (m_positionCache.Get(key, type, position))
     {
-        // Calculate position on-demand using classical model
-        geocentricPos = CalcPosition(Simulator::Now());
-    }
-    else
-    {
-        geocentricPos = m_position;
+        return position;
     }
 
     switch (type)
     {
     case PositionType::GEOCENTRIC:
-        return geocentricPos;
+        if (IsOnDemand())
+        {
+            // Calculate position on-demand using classical model
+            return m_positionCache.Set(key, type, CalcPosition(Simulator::Now()));
+        }
+        return m_positionCache.Set(key, type, m_position);
     case PositionType::GEOGRAPHIC:
-        return GeographicPositions::CartesianToGeographicCoordinates(geocentricPos,
-                                                                     GetEarthSpheroidType());
+        return m_positionCache.Set(
+            key,
+            type,
+            GeographicPositions::CartesianToGeographicCoordinates(
+                DoGetPosition(PositionType::GEOCENTRIC),
+                GetEarthSpheroidType()));
     case PositionType::TOPOCENTRIC:
-        return CartesianToTopocentric(geocentricPos,
-                                      GetGeographicReferencePoint(),
-                                      GetEarthSpheroidType());
+        return m_positionCache.Set(key,
+                                   type,
+                                   CartesianToTopocentric(DoGetPosition(PositionType::GEOCENTRIC),
+                                                          GetGeographicReferencePoint(),
+                                                          GetEarthSpheroidType()));
     case PositionType::PROJECTED:
-        return GeographicPositions::GeographicToProjectedCoordinates(
-            GeographicPositions::CartesianToGeographicCoordinates(geocentricPos,
-                                                                  GetEarthSpheroidType()),
-            GetEarthSpheroidType());
+        return m_positionCache.Set(
+            key,
+            type,
+            GeographicPositions::GeographicToProjectedCoordinates(
+                DoGetPosition(PositionType::GEOGRAPHIC),
+                GetEarthSpheroidType()));
 
     default:
         NS_FATAL_ERROR("Unknown/unsupported position type");
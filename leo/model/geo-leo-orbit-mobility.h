@@ -19,7 +19,9 @@
 #ifndef LEO_CIRCULAR_ORBIT_MOBILITY_MODEL_H
 #define LEO_CIRCULAR_ORBIT_MOBILITY_MODEL_H
 
+#include "ns3/adaptive-update-policy.h"
 #include "ns3/geocentric-mobility-model.h"
+#include "ns3/geocentric-position-cache.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/nstime.h"
@@ -226,6 +228,13 @@ class GeoLeoOrbitMobility : public GeocentricMobilityModel
 
     EventId m_updateEvent = EventId(); ///< Event for periodic updates
 
+    int64_t m_nUpdates = 0;                          ///< Number of calls to Update
+    mutable GeocentricPositionCache m_positionCache; ///< Position in each requested frame
+
+    double m_courseChangeTolerance = 0;     ///< Distance before notifying CourseChange, in m
+    Time m_maxUpdateInterval = Seconds(60); ///< Longest time between two position checks
+    AdaptiveUpdatePolicy m_adaptiveUpdate;  ///< Schedule of the position checks
+
     /**
      * \brief Implementation of DoGetPosition for the GeocentricMobilityModel interface
      * \param type the coordinate type to return
@@ -257,6 +266,18 @@ class GeoLeoOrbitMobility : public GeocentricMobilityModel
      */
     void SetPrecision(Time precision);
 
+    /**
+     * \brief Set the distance before notifying CourseChange (and schedule next update)
+     * \param tolerance the distance in meters, 0 for fixed Precision updates
+     */
+    void SetCourseChangeTolerance(double tolerance);
+
+    /**
+     * \brief Get the distance before notifying CourseChange
+     * \return the distance in meters
+     */
+    double GetCourseChangeTolerance() const;
+
     /**
      * \brief Get the normal vector of the orbital plane
      */
@@ -299,6 +320,18 @@ class GeoLeoOrbitMobility : public GeocentricMobilityModel
      */
     void Update();
 
+    /**
+     * \brief Update the position if the satellite has moved by more than
+     * CourseChangeTolerance, otherwise schedule the next check
+     */
+    void CheckCourseChange();
+
+    /**
+     * \brief Whether positions are computed at each query rather than at each Update
+     * \return true if Precision is 0 or CourseChangeTolerance is positive
+     */
+    bool IsOnDemand() const;
+
     /**
      * \brief Initialize classical orbital parameters from TLE data
      * Uses SGP4 once to get position at start time, then extracts orbital parameters
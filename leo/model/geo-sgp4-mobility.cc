@@ -21,10 +21,13 @@
 #include <libsgp4/Tle.h>
 #include "leo-orbit.h"
 
+#include "ns3/double.h"
 #include "ns3/geographic-positions.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -45,6 +48,21 @@ GeoSGP4Mobility::GetTypeId()
                       TimeValue(Seconds(1)),
                       MakeTimeAccessor(&GeoSGP4Mobility::SetPrecision),
                       MakeTimeChecker())
+        .AddAttribute("CourseChangeTolerance",
+                      "If positive, positions are computed on demand and CourseChange is only "
+                      "notified once the satellite has moved by this distance in meters. The "
+                      "position is checked when the satellite is expected to have covered it, "
+                      "instead of at each Precision. 0 means fixed Precision updates",
+                      DoubleValue(0.0),
+                      MakeDoubleAccessor(&GeoSGP4Mobility::SetCourseChangeTolerance,
+                                         &GeoSGP4Mobility::GetCourseChangeTolerance),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("MaxUpdateInterval",
+                      "The longest time between two position checks when CourseChangeTolerance "
+                      "is positive",
+                      TimeValue(Seconds(60)),
+                      MakeTimeAccessor(&GeoSGP4Mobility::m_maxUpdateInterval),
+                      MakeTimeChecker())
         .AddAttribute(
             "TleLine1",
             "TLE Line 1",
@@ -62,7 +80,21 @@ GeoSGP4Mobility::GetTypeId()
                       StringValue(""),
                       MakeStringAccessor(&GeoSGP4Mobility::SetTleStartTime,
                                          &GeoSGP4Mobility::GetTleStartTime),
-                      MakeStringChecker());
+                      MakeStringChecker())
+        .AddAttribute("InterpolationStep",
+                      "When Precision is 0, the largest step between the SGP4 samples used to "
+                      "interpolate positions with cubic Hermite splines. 0 means that SGP4 runs "
+                      "for every new timestamp",
+                      TimeValue(Seconds(0)),
+                      MakeTimeAccessor(&GeoSGP4Mobility::SetInterpolationStep,
+                                       &GeoSGP4Mobility::GetInterpolationStep),
+                      MakeTimeChecker(Seconds(0)))
+        .AddAttribute("InterpolationTolerance",
+                      "The maximum interpolation error in meters, checked against SGP4 in the "
+                      "middle of each interval. The step is halved until it is met",
+                      DoubleValue(1.0),
+                      MakeDoubleAccessor(&GeoSGP4Mobility::m_interpolationTolerance),
+                      MakeDoubleChecker<double>(0.0));
 }
 
 GeoSGP4Mobility::GeoSGP4Mobility()
@@ -83,6 +115,20 @@ GeoSGP4Mobility::SetPrecision(Time precision)
     Update();
 }
 
+void
+GeoSGP4Mobility::SetCourseChangeTolerance(double tolerance)
+{
+    NS_LOG_FUNCTION(this << tolerance);
+    m_courseChangeTolerance = tolerance;
+    Update();
+}
+
+double
+GeoSGP4Mobility::GetCourseChangeTolerance() const
+{
+    return m_courseChangeTolerance;
+}
+
 void
 GeoSGP4Mobility::SetTleLine1(std::string tle1)
 {
@@ -188,6 +234,29 @@ GeoSGP4Mobility::GetTleStartTime() const
     return m_sgp4StartTimeString;
 }
 
+void
+GeoSGP4Mobility::SetInterpolationStep(Time step)
+{
+    NS_LOG_FUNCTION(this << step);
+    m_interpolationStep = step;
+    m_currentStep = step;
+    InvalidateCache();
+}
+
+Time
+GeoSGP4Mobility::GetInterpolationStep() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return m_interpolationStep;
+}
+
+void
+GeoSGP4Mobility::InvalidateCache()
+{
+    m_cacheValid = false;
+    m_intervalValid = false;
+}
+
 void
 GeoSGP4Mobility::Update()
 {
@@ -202,6 +271,7 @@ GeoSGP4Mobility::Update()
             NS_LOG_INFO("  TLE Line 2: '" << m_tleLine2 << "'");
             m_tle = std::make_unique<libsgp4::Tle>(m_tleLine1, m_tleLine2);
             m_sgp4 = std::make_unique<libsgp4::SGP4>(*m_tle);
+            InvalidateCache();
             NS_LOG_INFO("SGP4 initialized successfully for satellite");
 
             // Recalculate start time offset if string is present (now that TLE is loaded)
@@ -239,22 +309,54 @@ GeoSGP4Mobility::Update()
         Simulator::Cancel(m_updateEvent);
         m_updateEvent = EventId(); // Reset the event
     }
-    if (m_precision > Seconds(0))
+    if (m_courseChangeTolerance > 0)
+    {
+        m_adaptiveUpdate.Notified(DoGetPosition(PositionType::GEOCENTRIC), Simulator::Now());
+        m_updateEvent = Simulator::Schedule(m_adaptiveUpdate.GetNextDelay(GetVelocity().GetLength(),
+                                                                          m_courseChangeTolerance,
+                                                                          m_maxUpdateInterval),
+                                            &GeoSGP4Mobility::CheckCourseChange,
+                                            this);
+    }
+    else if (m_precision > Seconds(0))
     {
         m_updateEvent = Simulator::Schedule(m_precision, &GeoSGP4Mobility::Update, this);
     }
 }
 
+void
+GeoSGP4Mobility::CheckCourseChange()
+{
+    if (m_adaptiveUpdate.Check(DoGetPosition(PositionType::GEOCENTRIC),
+                               Simulator::Now(),
+                               m_courseChangeTolerance))
+    {
+        Update();
+        return;
+    }
+    // The speed observed between checks is enough, avoid the SGP4 runs of GetVelocity
+    m_updateEvent = Simulator::Schedule(
+        m_adaptiveUpdate.GetNextDelay(0.0, m_courseChangeTolerance, m_maxUpdateInterval),
+        &GeoSGP4Mobility::CheckCourseChange,
+        this);
+}
+
+bool
+GeoSGP4Mobility::IsOnDemand() const
+{
+    return m_precision == Time(0) || m_courseChangeTolerance > 0;
+}
+
 Vector
 GeoSGP4Mobility::DoGetPosition(PositionType type) const
 {
     Vector geocentricPos;
-    if (m_precision == Time(0))
+    if (IsOnDemand())
     {
         // Notice: NotifyCourseChange () will not be called
         if (m_sgp4)
         {
-            geocentricPos = CalcSgp4Position(Simulator::Now() + m_sgp4StartTime);
+            geocentricPos = GetSgp4Position(Simulator::Now() + m_sgp4StartTime);
         }
         else
         {
@@ -326,12 +428,153 @@ GeoSGP4Mobility::CalcSgp4Velocity(Time t) const
     return (p2 - p1) * (1.0 / dt.GetSeconds());
 }
 
+Vector
+GeoSGP4Mobility::GetSgp4Position(Time t) const
+{
+    // Channel, REM and attachment code query the same satellite many times per timestamp
+    if (m_cacheValid && m_cachedTime == t)
+    {
+        return m_cachedPosition;
+    }
+
+    if (m_interpolationStep > Seconds(0))
+    {
+        UpdateInterpolationInterval(t);
+        m_cachedPosition = CalcHermitePosition(m_lower, m_upper, t);
+    }
+    else
+    {
+        m_cachedPosition = CalcSgp4Position(t);
+    }
+    m_cachedTime = t;
+    m_cacheValid = true;
+    return m_cachedPosition;
+}
+
+GeoSGP4Mobility::Sgp4Sample
+GeoSGP4Mobility::CalcSgp4Sample(Time t) const
+{
+    // Central difference, so that the knot derivatives do not bias the interpolation
+    const Time dt = Seconds(0.01);
+    const Vector before = CalcSgp4Position(t - dt);
+    const Vector after = CalcSgp4Position(t + dt);
+    return Sgp4Sample{.time = t,
+                      .position = CalcSgp4Position(t),
+                      .velocity = (after - before) * (0.5 / dt.GetSeconds())};
+}
+
+void
+GeoSGP4Mobility::UpdateInterpolationInterval(Time t) const
+{
+    if (m_intervalValid && m_lower.time <= t && t <= m_upper.time)
+    {
+        return;
+    }
+
+    const Time minStep = MilliSeconds(10);
+    Time step = (m_currentStep > Seconds(0) && m_currentStep <= m_interpolationStep)
+                    ? m_currentStep
+                    : m_interpolationStep;
+    while (true)
+    {
+        // Align the knots to multiples of the step, so that consecutive intervals share one
+        int64_t n = t.GetTimeStep() / step.GetTimeStep();
+        if (t.GetTimeStep() % step.GetTimeStep() < 0)
+        {
+            --n;
+        }
+        const Time start = step * n;
+        const Time middle = start + step / 2;
+
+        Sgp4Sample lower;
+        if (m_intervalValid && m_upper.time == start)
+        {
+            lower = m_upper;
+        }
+        else if (m_intervalValid && m_lower.time == start)
+        {
+            lower = m_lower;
+        }
+        else
+        {
+            lower = CalcSgp4Sample(start);
+        }
+        const Sgp4Sample upper = CalcSgp4Sample(start + step);
+
+        const double error = CalculateDistance(CalcHermitePosition(lower, upper, middle),
+                                               CalcSgp4Position(middle));
+        if (error > m_interpolationTolerance && step > minStep)
+        {
+            step = std::max(step / 2, minStep);
+            continue;
+        }
+        if (error > m_interpolationTolerance && !m_toleranceWarned)
+        {
+            NS_LOG_WARN("SGP4 interpolation error " << error << " m exceeds the tolerance of "
+                                                    << m_interpolationTolerance << " m even with a "
+                                                    << minStep.As(Time::MS) << " step");
+            m_toleranceWarned = true;
+        }
+
+        m_lower = lower;
+        m_upper = upper;
+        m_intervalValid = true;
+
+        // The error scales with the fourth power of the step: widen it again when there is room
+        if (error < m_interpolationTolerance / 32 && step * 2 <= m_interpolationStep)
+        {
+            step = step * 2;
+        }
+        m_currentStep = step;
+        NS_LOG_LOGIC("SGP4 knots at " << m_lower.time.As(Time::S) << " and "
+                                      << m_upper.time.As(Time::S) << ", error " << error << " m");
+        return;
+    }
+}
+
+Vector
+GeoSGP4Mobility::CalcHermitePosition(const Sgp4Sample& lower, const Sgp4Sample& upper, Time t)
+{
+    const double h = (upper.time - lower.time).GetSeconds();
+    const double s = (t - lower.time).GetSeconds() / h;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const double h00 = 2 * s3 - 3 * s2 + 1;
+    const double h10 = s3 - 2 * s2 + s;
+    const double h01 = -2 * s3 + 3 * s2;
+    const double h11 = s3 - s2;
+    return lower.position * h00 + lower.velocity * (h10 * h) + upper.position * h01 +
+           upper.velocity * (h11 * h);
+}
+
+Vector
+GeoSGP4Mobility::CalcHermiteVelocity(const Sgp4Sample& lower, const Sgp4Sample& upper, Time t)
+{
+    const double h = (upper.time - lower.time).GetSeconds();
+    const double s = (t - lower.time).GetSeconds() / h;
+    const double s2 = s * s;
+
+    const double d00 = 6 * s2 - 6 * s;
+    const double d10 = 3 * s2 - 4 * s + 1;
+    const double d01 = -6 * s2 + 6 * s;
+    const double d11 = 3 * s2 - 2 * s;
+    return (lower.position * d00 + upper.position * d01) * (1.0 / h) + lower.velocity * d10 +
+           upper.velocity * d11;
+}
+
 Vector
 GeoSGP4Mobility::GetVelocity() const
 {
     if (m_sgp4)
     {
-        return CalcSgp4Velocity(Simulator::Now() + m_sgp4StartTime);
+        const Time t = Simulator::Now() + m_sgp4StartTime;
+        if (IsOnDemand() && m_interpolationStep > Seconds(0))
+        {
+            UpdateInterpolationInterval(t);
+            return CalcHermiteVelocity(m_lower, m_upper, t);
+        }
+        return CalcSgp4Velocity(t);
     }
     return Vector();
 }
@@ -17,6 +17,7 @@
 #ifndef GEO_SGP4_MOBILITY_H
 #define GEO_SGP4_MOBILITY_H
 
+#include "ns3/adaptive-update-policy.h"
 #include "ns3/geocentric-mobility-model.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
@@ -98,6 +99,18 @@ class GeoSGP4Mobility : public GeocentricMobilityModel
      */
     std::string GetTleStartTime() const;
 
+    /**
+     * \brief Sets the largest step between the SGP4 knots used for interpolation
+     * \param step the step, 0 to always run SGP4
+     */
+    void SetInterpolationStep(Time step);
+
+    /**
+     * \brief Gets the largest step between the SGP4 knots used for interpolation
+     * \return the step
+     */
+    Time GetInterpolationStep() const;
+
     /**
      * \brief Get velocity
      * \return the current velocity
@@ -111,6 +124,16 @@ class GeoSGP4Mobility : public GeocentricMobilityModel
     virtual Vector GetGeocentricVelocity() const;
 
   private:
+    /**
+     * \brief SGP4 state of the satellite at a given time, used as interpolation knot
+     */
+    struct Sgp4Sample
+    {
+        Time time;       ///< Time from TLE epoch
+        Vector position; ///< Geocentric position
+        Vector velocity; ///< Geocentric velocity
+    };
+
     /**
      * Current position
      */
@@ -131,6 +154,23 @@ class GeoSGP4Mobility : public GeocentricMobilityModel
 
     EventId m_updateEvent = EventId(); ///< Event for periodic updates
 
+    double m_courseChangeTolerance = 0;     ///< Distance before notifying CourseChange, in m
+    Time m_maxUpdateInterval = Seconds(60); ///< Longest time between two position checks
+    AdaptiveUpdatePolicy m_adaptiveUpdate;  ///< Schedule of the position checks
+
+    Time m_interpolationStep = Seconds(0); ///< Largest step between SGP4 knots, 0 to disable
+    double m_interpolationTolerance = 1.0; ///< Maximum interpolation error, in meters
+
+    mutable bool m_cacheValid = false; ///< Whether m_cachedPosition is valid
+    mutable Time m_cachedTime;         ///< Time of the cached position
+    mutable Vector m_cachedPosition;   ///< Geocentric position at m_cachedTime
+
+    mutable bool m_intervalValid = false; ///< Whether the interpolation knots are valid
+    mutable Sgp4Sample m_lower;           ///< Knot at the beginning of the current interval
+    mutable Sgp4Sample m_upper;           ///< Knot at the end of the current interval
+    mutable Time m_currentStep;           ///< Step currently used between the knots
+    mutable bool m_toleranceWarned = false; ///< Whether the tolerance could not be met once
+
     /**
      * \brief Implementation of DoGetPosition for the GeocentricMobilityModel interface
      * \param type the coordinate type to return
@@ -162,11 +202,35 @@ class GeoSGP4Mobility : public GeocentricMobilityModel
      */
     void SetPrecision(Time precision);
 
+    /**
+     * \brief Set the distance before notifying CourseChange (and schedule next update)
+     * \param tolerance the distance in meters, 0 for fixed Precision updates
+     */
+    void SetCourseChangeTolerance(double tolerance);
+
+    /**
+     * \brief Get the distance before notifying CourseChange
+     * \return the distance in meters
+     */
+    double GetCourseChangeTolerance() const;
+
     /**
      * \brief Update the internal position of the mobility model
      */
     void Update();
 
+    /**
+     * \brief Update the position if the satellite has moved by more than
+     *        CourseChangeTolerance, otherwise schedule the next check
+     */
+    void CheckCourseChange();
+
+    /**
+     * \brief Whether positions are computed at each query rather than at each Update
+     * \return true if Precision is 0 or CourseChangeTolerance is positive
+     */
+    bool IsOnDemand() const;
+
     /**
      * \brief Calculate the position using SGP4 at time t
      * \param t time
@@ -180,6 +244,51 @@ class GeoSGP4Mobility : public GeocentricMobilityModel
      * \return velocity at time t
      */
     Vector CalcSgp4Velocity(Time t) const;
+
+    /**
+     * \brief Get the geocentric position at time t, either from the cache, from the
+     *        interpolation knots or from SGP4
+     * \param t time from TLE epoch
+     * \return position at time t
+     */
+    Vector GetSgp4Position(Time t) const;
+
+    /**
+     * \brief Calculate the SGP4 state at time t
+     * \param t time from TLE epoch
+     * \return the SGP4 sample at time t
+     */
+    Sgp4Sample CalcSgp4Sample(Time t) const;
+
+    /**
+     * \brief Make sure that the interpolation knots enclose time t, refining the step until
+     *        the error at the middle of the interval is within the tolerance
+     * \param t time from TLE epoch
+     */
+    void UpdateInterpolationInterval(Time t) const;
+
+    /**
+     * \brief Cubic Hermite interpolation of the position between two knots
+     * \param lower knot at the beginning of the interval
+     * \param upper knot at the end of the interval
+     * \param t time from TLE epoch, between the two knots
+     * \return interpolated position at time t
+     */
+    static Vector CalcHermitePosition(const Sgp4Sample& lower, const Sgp4Sample& upper, Time t);
+
+    /**
+     * \brief Derivative of the cubic Hermite interpolation between two knots
+     * \param lower knot at the beginning of the interval
+     * \param upper knot at the end of the interval
+     * \param t time from TLE epoch, between the two knots
+     * \return interpolated velocity at time t
+     */
+    static Vector CalcHermiteVelocity(const Sgp4Sample& lower, const Sgp4Sample& upper, Time t);
+
+    /**
+     * \brief Drop the cached position and interpolation knots
+     */
+    void InvalidateCache();
 };
 
 } // namespace ns3
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef GEOCENTRIC_POSITION_CACHE_H
+#define GEOCENTRIC_POSITION_CACHE_H
+
+#include "ns3/assert.h"
+#include "ns3/geocentric-mobility-model.h"
+#include "ns3/geographic-positions.h"
+#include "ns3/vector.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * \file
+ * \ingroup leo
+ *
+ * Declaration of GeocentricPositionCache
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup leo
+ * \brief Last position of a GeocentricMobilityModel in each PositionType
+ *
+ * Models convert their native position to the requested frame on every
+ * DoGetPosition call. With this cache each frame is converted once per key,
+ * where the key identifies the native position: an update counter for models
+ * that move at discrete updates, or the time step for models computing their
+ * position on demand. A different key drops every cached frame; models also
+ * call Invalidate when their native position changes under the same key, and
+ * SetFrame before each lookup so that a new spheroid or reference point drops
+ * the frames converted with the old ones.
+ */
+class GeocentricPositionCache
+{
+  public:
+    /**
+     * \brief Look up the position in a frame
+     * \param key identifier of the current native position
+     * \param type the frame
+     * \param [out] position the cached position, if any
+     * \return true iff the position in that frame is cached for this key
+     */
+    bool Get(int64_t key, PositionType type, Vector& position)
+    {
+        if (key != m_key)
+        {
+            m_key = key;
+            m_valid = 0;
+            return false;
+        }
+        std::size_t index = static_cast<std::size_t>(type);
+        if (index >= N_TYPES || (m_valid & (1u << index)) == 0)
+        {
+            return false;
+        }
+        position = m_positions[index];
+        return true;
+    }
+
+    /**
+     * \brief Store the position in a frame
+     * \param key identifier of the current native position
+     * \param type the frame
+     * \param position the position in that frame
+     * \return position
+     */
+    const Vector& Set(int64_t key, PositionType type, const Vector& position)
+    {
+        if (key != m_key)
+        {
+            m_key = key;
+            m_valid = 0;
+        }
+        std::size_t index = static_cast<std::size_t>(type);
+        NS_ASSERT_MSG(index < N_TYPES, "Unknown PositionType " << type);
+        m_valid |= 1u << index;
+        return m_positions[index] = position;
+    }
+
+    /**
+     * \brief Drop every cached frame if the parameters of the conversions have changed
+     * \param spheroid the Earth spheroid of the model
+     * \param referencePoint the geographic reference point of the topocentric frame
+     */
+    void SetFrame(GeographicPositions::EarthSpheroidType spheroid, const Vector& referencePoint)
+    {
+        if (spheroid != m_spheroid || referencePoint != m_referencePoint)
+        {
+            m_spheroid = spheroid;
+            m_referencePoint = referencePoint;
+            m_valid = 0;
+        }
+    }
+
+    /**
+     * \brief Drop every cached frame
+     */
+    void Invalidate()
+    {
+        m_valid = 0;
+    }
+
+  private:
+    /// Number of PositionType values
+    static constexpr std::size_t N_TYPES = 4;
+
+    int64_t m_key = INT64_MIN;                  ///< Key of the cached positions
+    uint32_t m_valid = 0;                       ///< Bit set of the cached frames
+    std::array<Vector, N_TYPES> m_positions;    ///< Cached position of each frame
+    GeographicPositions::EarthSpheroidType m_spheroid =
+        GeographicPositions::WGS84; ///< Spheroid of the cached positions
+    Vector m_referencePoint;        ///< Reference point of the cached positions
+};
+
+} // namespace ns3
+
+#endif /* GEOCENTRIC_POSITION_CACHE_H */
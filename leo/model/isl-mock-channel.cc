@@ -75,12 +75,10 @@ IslMockChannel::TransmitStart (
     if (Mac48Address::ConvertFrom (destAddr).IsBroadcast () || Mac48Address::ConvertFrom (destAddr).IsBroadcast ())
       // try to deliver to every node in LOS
       {
-        for (size_t i = 0; i < GetNDevices (); i ++)
-          {
-            if (i == srcId) continue;
-            dst = StaticCast<MockNetDevice> (GetDevice (i));
-            Deliver (p, src, dst, txTime);
-          }
+        // one copy shared by all the destinations, detached from the sender's packet
+        Ptr<const Packet> shared = p->Copy ();
+        DeliverAll (shared, src, GetDevices (), txTime);
+        NotifyFilteredRx (p, src);
         return true;
       }
     else
@@ -91,7 +89,9 @@ IslMockChannel::TransmitStart (
   }
   else
   {
-    return Deliver (p, src, dst, txTime);
+    bool result = Deliver (p->Copy (), src, dst, txTime);
+    NotifyFilteredRx (p, src);
+    return result;
   }
 }
 
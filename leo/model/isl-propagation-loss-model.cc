@@ -20,6 +20,8 @@
 #include "ns3/mobility-model.h"
 #include "ns3/double.h"
 #include "math.h"
+#include <algorithm>
+#include <cfloat>
 #include "ns3/geographic-positions.h"
 #include "isl-propagation-loss-model.h"
 
@@ -48,51 +50,52 @@ IslPropagationLossModel::~IslPropagationLossModel ()
 {
 }
 
+/**
+ * \brief Check if the segment between two points passes above the earth
+ *
+ * The point of the segment closest to the centre of the earth is found in
+ * closed form, without normalisation or square roots, so that loops over
+ * this function can be vectorised.
+ */
+static inline bool
+SegmentClearsEarth (double ax, double ay, double az, double bx, double by, double bz)
+{
+  double dx = bx - ax;
+  double dy = by - ay;
+  double dz = bz - az;
+  double dd = dx*dx + dy*dy + dz*dz;
+  double ad = ax*dx + ay*dy + az*dz;
+  double t = std::min (std::max (-ad / std::max (dd, DBL_MIN), 0.0), 1.0);
+  double cx = ax + t * dx;
+  double cy = ay + t * dy;
+  double cz = az + t * dz;
+  return cx*cx + cy*cy + cz*cz > GeographicPositions::EARTH_SPHERE_RADIUS * GeographicPositions::EARTH_SPHERE_RADIUS;
+}
+
 bool
 IslPropagationLossModel::GetLos (Ptr<MobilityModel> moda, Ptr<MobilityModel> modb)
 {
-  // origin of LOS
   Vector3D apos = moda->GetPosition ();
   Vector3D bpos = modb->GetPosition ();
+  bool los = SegmentClearsEarth (apos.x, apos.y, apos.z, bpos.x, bpos.y, bpos.z);
 
-  // select upper satellite as origin
-  Vector oc = apos.GetLength () > bpos.GetLength () ? apos : bpos;
-  Vector bp = apos.GetLength () > bpos.GetLength () ? bpos : apos;
-
-  Vector3D u = bp - oc;
-  // distance from s1 to s2
-  double s2 = u.GetLength ();
-  // direction unit vector
-  u = Vector3D (u.x / s2, u.y / s2, u.z / s2);
-
-  double a = u.x*u.x + u.y*u.y + u.z*u.z;
-  double b = 2.0 * (oc.x*u.x + oc.y*u.y + oc.z*u.z);
-  double c = (oc.x*oc.x + oc.y*oc.y + oc.z*oc.z) - (GeographicPositions::EARTH_SPHERE_RADIUS*GeographicPositions::EARTH_SPHERE_RADIUS);
-  double discriminant = b*b - 4*a*c;
-
-  NS_LOG_DEBUG ("a_pos="<<moda->GetPosition ()<<";b_pos"<<modb->GetPosition ()
-  		<<";u="<<u
-  		<<";a="<<a
-  		<<";b="<<b
-  		<<";c="<<c
-  		<<";disc="<<discriminant);
-
-  if (discriminant < 0)
-    {
-      return true;
-    }
-  else
-    {
-      // distances from oc (first sat)
-      double t1 = (-b - sqrt (discriminant)) / (2.0 * a);
-      double t2 = (-b + sqrt (discriminant)) / (2.0 * a);
+  NS_LOG_DEBUG ("a_pos=" << apos << ";b_pos=" << bpos << ";los=" << los);
 
-      NS_LOG_DEBUG ("t1="<<t1
-      		    <<"t2="<<t2
-      		    <<"s2="<<s2);
+  return los;
+}
 
-      // check if second sat is behind earth
-      return (s2 < abs (t1) && s2 < abs (t2));
+void
+IslPropagationLossModel::GetReachable (const Vector &tx,
+                                       const double *x,
+                                       const double *y,
+                                       const double *z,
+                                       std::size_t n,
+                                       uint8_t *reachable) const
+{
+  NS_LOG_FUNCTION (this << tx << n);
+  for (std::size_t i = 0; i < n; i ++)
+    {
+      reachable[i] = SegmentClearsEarth (tx.x, tx.y, tx.z, x[i], y[i], z[i]);
     }
 }
 
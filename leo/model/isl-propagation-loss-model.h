@@ -21,6 +21,7 @@
 
 #include <ns3/object.h>
 #include <ns3/propagation-loss-model.h>
+#include <ns3/vector.h>
 
 /**
  * \file
@@ -60,6 +61,26 @@ public:
    * \return true iff there is a line-of-sight between the points
    */
   static bool GetLos (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+
+  /**
+   * \brief Check the line-of-sight from one transmitter to many receivers
+   *
+   * Used by the channels to skip the receivers out of reach with one pass
+   * over their positions, stored as separate coordinate arrays.
+   *
+   * \param tx position of the transmitter
+   * \param x x coordinates of the receivers
+   * \param y y coordinates of the receivers
+   * \param z z coordinates of the receivers
+   * \param n number of receivers
+   * \param [out] reachable 1 for each receiver in line-of-sight, 0 otherwise
+   */
+  void GetReachable (const Vector &tx,
+                     const double *x,
+                     const double *y,
+                     const double *z,
+                     std::size_t n,
+                     uint8_t *reachable) const;
 private:
   /**
    * Returns the Rx Power taking into account only the particular
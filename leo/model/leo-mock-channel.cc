@@ -42,7 +42,8 @@ LeoMockChannel::GetTypeId (void)
 }
 
 LeoMockChannel::LeoMockChannel() :
-  MockChannel ()
+  MockChannel (),
+  m_listsOutdated (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -78,16 +79,17 @@ LeoMockChannel::TransmitStart (Ptr<const Packet> p,
 
   NS_ASSERT_MSG (!(fromGround && fromSpace), "Source device can not be both on ground and in space");
 
-  DeviceIndex *dests;
+  UpdateLists ();
+  const std::vector<Ptr<MockNetDevice> > *dests;
   if (fromGround)
     {
       NS_LOG_LOGIC ("ground to space: " << srcDev->GetAddress () << " to " << dst);
-      dests = &m_satelliteDevices;
+      dests = &m_satelliteList;
     }
   else if (fromSpace)
     {
       NS_LOG_LOGIC ("space to ground: " << srcDev->GetAddress () << " to " << dst);
-      dests = &m_groundDevices;
+      dests = &m_groundList;
     }
   else
     {
@@ -95,16 +97,45 @@ LeoMockChannel::TransmitStart (Ptr<const Packet> p,
       return false;
     }
 
+  // one copy shared by all the destinations, detached from the sender's packet
+  Ptr<const Packet> shared = p->Copy ();
+
   // make sure to return false if packet has been delivered to *no* device
-  bool result = false;
-  for (DeviceIndex::iterator it = dests->begin (); it != dests->end(); it ++)
+  bool result = DeliverAll (shared, srcDev, *dests, txTime);
+  NotifyFilteredRx (p, srcDev);
+  return result;
+}
+
+void
+LeoMockChannel::UpdateLists (void)
+{
+  if (!m_listsOutdated)
     {
-      if (Deliver (p, srcDev, it->second, txTime))
-      	{
-      	  result = true;
-      	}
+      return;
     }
-  return result;
+  m_groundList.clear ();
+  for (auto &entry : m_groundDevices)
+    {
+      m_groundList.push_back (entry.second);
+    }
+  m_satelliteList.clear ();
+  for (auto &entry : m_satelliteDevices)
+    {
+      m_satelliteList.push_back (entry.second);
+    }
+  m_listsOutdated = false;
+}
+
+bool
+LeoMockChannel::CanReach (Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst) const
+{
+  Ptr<LeoMockNetDevice> srcDev = DynamicCast<LeoMockNetDevice> (src);
+  Ptr<LeoMockNetDevice> dstDev = DynamicCast<LeoMockNetDevice> (dst);
+  if (srcDev == nullptr || dstDev == nullptr)
+    {
+      return MockChannel::CanReach (src, dst);
+    }
+  return srcDev->GetDeviceType () != dstDev->GetDeviceType ();
 }
 
 int32_t
@@ -124,6 +155,7 @@ LeoMockChannel::Attach (Ptr<MockNetDevice> device)
     default:
       break;
     }
+  m_listsOutdated = true;
 
   return MockChannel::Attach (device);
 }
@@ -134,6 +166,7 @@ LeoMockChannel::Detach (uint32_t deviceId)
   Ptr<NetDevice> dev = GetDevice (deviceId);
   m_groundDevices.erase (dev->GetAddress ());
   m_satelliteDevices.erase (dev->GetAddress ());
+  m_listsOutdated = true;
 
   return MockChannel::Detach (deviceId);
 }
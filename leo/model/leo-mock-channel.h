@@ -76,6 +76,15 @@ public:
   virtual int32_t Attach (Ptr<MockNetDevice> device);
   virtual bool Detach (uint32_t deviceId);
 
+protected:
+  /**
+   * \brief Only devices on opposing sites can reach each other
+   * \param src sending device
+   * \param dst receiving device
+   * \return true iff one device is on the ground and the other one in space
+   */
+  virtual bool CanReach (Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst) const;
+
 private:
   /**
    * \brief Ground and satellite devices
@@ -90,6 +99,20 @@ private:
 
   /// Devices that are in space (satellites)
   DeviceIndex m_satelliteDevices;
+
+  /// Devices of m_groundDevices in the same order, for DeliverAll
+  std::vector<Ptr<MockNetDevice> > m_groundList;
+
+  /// Devices of m_satelliteDevices in the same order, for DeliverAll
+  std::vector<Ptr<MockNetDevice> > m_satelliteList;
+
+  /// Whether the lists have to be rebuilt from the indexes
+  bool m_listsOutdated;
+
+  /**
+   * \brief Rebuild the device lists after devices have been attached or detached
+   */
+  void UpdateLists (void);
 }; // class MockChannel
 
 } // namespace ns3
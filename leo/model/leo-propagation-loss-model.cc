@@ -17,6 +17,8 @@
  */
 
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
@@ -70,39 +72,85 @@ LeoPropagationLossModel::~LeoPropagationLossModel ()
 {
 }
 
+void
+LeoPropagationLossModel::DoDispose (void)
+{
+  m_cutoffs.clear ();
+  PropagationLossModel::DoDispose ();
+}
+
+/**
+ * \brief Distance from a satellite to the points of the surface that see it
+ * at the elevation angle
+ *
+ * This is the root of the quadratic of the elevation cone that is smallest
+ * in absolute value, scaled to a length along the cone. The closed form has
+ * no branches, so that loops over this function can be vectorised.
+ *
+ * \param hs distance of the satellite from the centre of the earth
+ * \param tanAngle tangent of the elevation angle
+ * \return the distance, or a negative value if there is no such point
+ */
+static inline double
+CalcCutoffDistance (double hs, double tanAngle)
+{
+  double a = 1 + tanAngle * tanAngle;
+  double b = 2.0 * tanAngle * hs;
+  double c = hs*hs - LEO_PROP_EARTH_RAD*LEO_PROP_EARTH_RAD;
+  double disc = b*b + 4*a*c;
+  double cutoff = std::fabs (std::sqrt (std::max (disc, 0.0)) - std::fabs (b)) / (2.0 * a) * std::sqrt (a);
+  return disc < 0 ? -1.0 : cutoff;
+}
+
 void
 LeoPropagationLossModel::SetElevationAngle (double angle)
 {
   m_elevationAngle = angle * (M_PI/180.0);
+  m_tanElevationAngle = tan (m_elevationAngle);
+  m_cutoffs.clear ();
 }
 
 double
 LeoPropagationLossModel::GetCutoffDistance (const Ptr<MobilityModel> sat) const
 {
-  double angle = m_elevationAngle;
-  double hs = sat->GetPosition ().GetLength ();
-
-  double a = 1 + tan (angle) * tan (angle);
-  double b = 2.0 * tan (angle) * hs;
-  double c = hs*hs - LEO_PROP_EARTH_RAD*LEO_PROP_EARTH_RAD;
-
-  double disc = b*b + 4*a*c;
-
-  NS_LOG_DEBUG ("angle="<<angle<<" hs="<<hs<<" a="<<a<<" b="<<b<<" c="<<c<<" disc="<<disc);
+  return GetCutoffDistance (sat, sat->GetPosition ().GetLength ());
+}
 
-  if (disc < 0)
+double
+LeoPropagationLossModel::GetCutoffDistance (const Ptr<MobilityModel> sat, double hs) const
+{
+  // the cutoff only changes with the orbit radius, which is constant for
+  // circular orbits
+  CutoffEntry &entry = m_cutoffs[sat];
+  if (std::fabs (entry.radius - hs) > LEO_PROP_CUTOFF_RADIUS_TOLERANCE)
     {
-      // point not on earth surface
-      return - 1.0;
+      entry.radius = hs;
+      entry.cutoff = CalcCutoffDistance (hs, m_tanElevationAngle);
+      NS_LOG_DEBUG ("angle=" << m_elevationAngle << " hs=" << hs << " cutoff=" << entry.cutoff);
     }
+  return entry.cutoff;
+}
 
-  double t1 = (-b - sqrt (disc)) / (2.0 * a);
-  double t2 = (-b + sqrt (disc)) / (2.0 * a);
-
-  double num1 = Vector2D (t1, - tan (angle) * t1).GetLength ();
-  double num2 = Vector2D (t2, - tan (angle) * t2).GetLength ();
-
-  return fmin (num1, num2);
+void
+LeoPropagationLossModel::GetReachable (const Vector &tx,
+                                       const double *x,
+                                       const double *y,
+                                       const double *z,
+                                       std::size_t n,
+                                       uint8_t *reachable) const
+{
+  NS_LOG_FUNCTION (this << tx << n);
+  const double txRadius2 = tx.x*tx.x + tx.y*tx.y + tx.z*tx.z;
+  for (std::size_t i = 0; i < n; i ++)
+    {
+      // the satellite is the end farther from the centre of the earth
+      double rxRadius2 = x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+      double cutoff = CalcCutoffDistance (std::sqrt (std::max (txRadius2, rxRadius2)), m_tanElevationAngle);
+      double dx = x[i] - tx.x;
+      double dy = y[i] - tx.y;
+      double dz = z[i] - tx.z;
+      reachable[i] = cutoff >= 0 && dx*dx + dy*dy + dz*dz <= cutoff*cutoff;
+    }
 }
 
 double
@@ -116,12 +164,15 @@ LeoPropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                         Ptr<MobilityModel> a,
                                         Ptr<MobilityModel> b) const
 {
-  Ptr<MobilityModel> sat = a->GetPosition ().GetLength () > b->GetPosition ().GetLength () ? a : b;
-  double distance = a->GetDistanceFrom (b);
-  double cutOff = GetCutoffDistance (sat);
+  Vector aPos = a->GetPosition ();
+  Vector bPos = b->GetPosition ();
+  double aRadius = aPos.GetLength ();
+  double bRadius = bPos.GetLength ();
+  double distance = CalculateDistance (aPos, bPos);
+  double cutOff = aRadius > bRadius ? GetCutoffDistance (a, aRadius) : GetCutoffDistance (b, bRadius);
   if (distance > cutOff)
     {
-      NS_LOG_DEBUG ("LEO DROP distance: a=" << a->GetPosition () << " b=" << b->GetPosition ()<<" dist=" << distance<<" cutoff="<<cutOff);
+      NS_LOG_DEBUG ("LEO DROP distance: a=" << aPos << " b=" << bPos <<" dist=" << distance<<" cutoff="<<cutOff);
 
       return -1000.0;
     }
@@ -130,7 +181,7 @@ LeoPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   // receiver loss and gain added at net device
   // P_{RX} = P_{TX} + G_{TX} - L_{TX} - L_{FS} - L_M + G_{RX} - L_{RX}
   double rxc = txPowerDbm - m_atmosphericLoss - m_freeSpacePathLoss - m_linkMargin;
-  NS_LOG_DEBUG ("LEO TRANSMIT distance: a=" << a->GetPosition () << " b=" << b->GetPosition ()<<" dist=" << distance <<" cutoff="<<cutOff<< "rxc=" << rxc);
+  NS_LOG_DEBUG ("LEO TRANSMIT distance: a=" << aPos << " b=" << bPos <<" dist=" << distance <<" cutoff="<<cutOff<< "rxc=" << rxc);
 
   return rxc;
 }
@@ -19,10 +19,16 @@
 #ifndef LEO_PROPAGATION_LOSS_MODEL_H
 #define LEO_PROPAGATION_LOSS_MODEL_H
 
+#include <ns3/mobility-model.h>
 #include <ns3/object.h>
 #include <ns3/propagation-loss-model.h>
+#include <ns3/vector.h>
+
+#include <unordered_map>
 
 #define LEO_PROP_EARTH_RAD 6.37101e6
+/// Change of the orbit radius in m above which a cached cutoff distance is recomputed
+#define LEO_PROP_CUTOFF_RADIUS_TOLERANCE 1e-3
 #define LEO_SPEED_OF_LIGHT_IN_AIR 299702458
 
 /**
@@ -51,13 +57,55 @@ public:
   /// destructor
   virtual ~LeoPropagationLossModel ();
 
+  /**
+   * \brief Check which receivers are within the cutoff distance of a transmitter
+   *
+   * Used by the channels to skip the receivers out of reach with one pass
+   * over their positions, stored as separate coordinate arrays.
+   *
+   * \param tx position of the transmitter
+   * \param x x coordinates of the receivers
+   * \param y y coordinates of the receivers
+   * \param z z coordinates of the receivers
+   * \param n number of receivers
+   * \param [out] reachable 1 for each receiver in reach, 0 otherwise
+   */
+  void GetReachable (const Vector &tx,
+                     const double *x,
+                     const double *y,
+                     const double *z,
+                     std::size_t n,
+                     uint8_t *reachable) const;
+
+protected:
+  virtual void DoDispose (void);
+
 private:
+  /**
+   * \brief Cutoff distance of a satellite for an orbit radius
+   */
+  struct CutoffEntry
+  {
+    double radius = -1.0; ///< Orbit radius the cutoff has been computed for
+    double cutoff = -1.0; ///< Cutoff distance
+  };
 
   /**
    * Maximum elevation angle
    */
   double m_elevationAngle;
 
+  /**
+   * Tangent of the elevation angle
+   */
+  double m_tanElevationAngle;
+
+  /**
+   * Cutoff distances by satellite mobility model, held until the model is
+   * disposed so that a new mobility model cannot reuse the key of a freed one
+   */
+  mutable std::unordered_map<Ptr<const MobilityModel>, CutoffEntry> m_cutoffs;
+
   /**
    * Atmospheric loss
    */
@@ -104,6 +152,14 @@ private:
    * \return distance
    */
   double GetCutoffDistance (const Ptr<MobilityModel> sat) const;
+
+  /**
+   * \brief Get the maximum communication distance for satellite
+   * \param sat satellite
+   * \param hs distance of the satellite from the centre of the earth
+   * \return distance
+   */
+  double GetCutoffDistance (const Ptr<MobilityModel> sat, double hs) const;
 };
 
 }
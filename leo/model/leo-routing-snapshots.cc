@@ -0,0 +1,649 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "leo-routing-snapshots.h"
+
+#include "leo-mock-net-device.h"
+#include "mock-channel.h"
+#include "mock-net-device.h"
+
+#include "ns3/double.h"
+#include "ns3/hash.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LeoRoutingSnapshots");
+
+NS_OBJECT_ENSURE_REGISTERED(LeoRoutingSnapshots);
+
+/// Magic number at the beginning of snapshot files
+static const char SNAPSHOT_MAGIC[8] = {'I', 'O', 'D', 'L', 'E', 'O', 'R', '2'};
+
+TypeId
+LeoRoutingSnapshots::GetTypeId()
+{
+    return TypeId("ns3::LeoRoutingSnapshots")
+        .SetParent<Object>()
+        .SetGroupName("Leo")
+        .AddConstructor<LeoRoutingSnapshots>()
+        .AddAttribute("Epoch",
+                      "Duration for which the tables of a topology snapshot are used",
+                      TimeValue(Seconds(10)),
+                      MakeTimeAccessor(&LeoRoutingSnapshots::m_epoch),
+                      MakeTimeChecker(NanoSeconds(1)))
+        .AddAttribute("RecomputeTolerance",
+                      "Relative change of an ISL length, since the last computation, above "
+                      "which the ISL tables are recomputed. 0 recomputes them at every epoch",
+                      DoubleValue(0.01),
+                      MakeDoubleAccessor(&LeoRoutingSnapshots::m_recomputeTolerance),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("File",
+                      "File in which the tables are stored, to be read back by later runs. "
+                      "Empty to disable it",
+                      StringValue(""),
+                      MakeStringAccessor(&LeoRoutingSnapshots::m_file),
+                      MakeStringChecker());
+}
+
+LeoRoutingSnapshots::LeoRoutingSnapshots()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LeoRoutingSnapshots::~LeoRoutingSnapshots()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LeoRoutingSnapshots::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_in.is_open())
+    {
+        m_in.close();
+    }
+    if (m_out.is_open())
+    {
+        m_out.close();
+    }
+    m_satellites.clear();
+    m_grounds.clear();
+    m_vertices.clear();
+    m_owners.clear();
+    m_isl.clear();
+    m_nextIsl.clear();
+    m_attachments.clear();
+    m_initialized = false;
+    Object::DoDispose();
+}
+
+uint32_t
+LeoRoutingSnapshots::GetNComputations() const
+{
+    return m_nComputations;
+}
+
+bool
+LeoRoutingSnapshots::Lookup(Ptr<Node> node, Ipv4Address destination, NextHop& nextHop)
+{
+    NS_LOG_FUNCTION(this << node->GetId() << destination);
+    Update();
+
+    auto srcIt = m_vertices.find(node->GetId());
+    auto dstIt = m_owners.find(destination);
+    if (srcIt == m_vertices.end() || dstIt == m_owners.end())
+    {
+        return false;
+    }
+    const Vertex& src = srcIt->second;
+    const Vertex& dst = dstIt->second;
+
+    if (src.ground)
+    {
+        nextHop = m_attachments[src.index].up;
+        return nextHop.interface != NO_ROUTE;
+    }
+
+    uint32_t target = dst.index;
+    if (dst.ground)
+    {
+        const Attachment& attachment = m_attachments[dst.index];
+        if (attachment.satellite == src.index)
+        {
+            nextHop = attachment.down;
+            return nextHop.interface != NO_ROUTE;
+        }
+        target = attachment.satellite;
+    }
+    if (target == NO_ROUTE || target == src.index)
+    {
+        return false;
+    }
+
+    nextHop = m_isl[target * m_satellites.size() + src.index];
+    return nextHop.interface != NO_ROUTE;
+}
+
+void
+LeoRoutingSnapshots::Initialize()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        Ptr<Node> node = *it;
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        if (ipv4 == nullptr)
+        {
+            continue;
+        }
+
+        bool satellite = false;
+        bool ground = false;
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> dev = node->GetDevice(i);
+            Ptr<LeoMockNetDevice> leo = DynamicCast<LeoMockNetDevice>(dev);
+            if (leo != nullptr)
+            {
+                satellite |= leo->GetDeviceType() == LeoMockNetDevice::SAT;
+                ground |= leo->GetDeviceType() == LeoMockNetDevice::GND;
+            }
+            else if (DynamicCast<MockNetDevice>(dev) != nullptr)
+            {
+                satellite = true;
+            }
+        }
+
+        Vertex vertex;
+        if (satellite)
+        {
+            vertex = {false, static_cast<uint32_t>(m_satellites.size())};
+            m_satellites.push_back(node);
+        }
+        else if (ground)
+        {
+            vertex = {true, static_cast<uint32_t>(m_grounds.size())};
+            m_grounds.push_back(node);
+        }
+        else
+        {
+            continue;
+        }
+
+        m_vertices[node->GetId()] = vertex;
+        for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+        {
+            for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+            {
+                Ipv4Address address = ipv4->GetAddress(i, j).GetLocal();
+                if (!address.IsLocalhost())
+                {
+                    m_owners[address] = vertex;
+                }
+            }
+        }
+    }
+
+    NS_LOG_INFO("routing over " << m_satellites.size() << " satellites and " << m_grounds.size()
+                                << " ground nodes");
+
+    m_isl.assign(m_satellites.size() * m_satellites.size(), NextHop());
+    m_attachments.assign(m_grounds.size(), Attachment());
+    m_nextEpoch = Simulator::Now();
+    m_initialized = true;
+    OpenFile();
+}
+
+void
+LeoRoutingSnapshots::Update()
+{
+    if (!m_initialized)
+    {
+        Initialize();
+    }
+    Time now = Simulator::Now();
+    if (now < m_nextEpoch)
+    {
+        return;
+    }
+
+    Time start = m_epoch * (now.GetTimeStep() / m_epoch.GetTimeStep());
+    m_nextEpoch = start + m_epoch;
+    NS_LOG_FUNCTION(this << start);
+
+    if (m_in.is_open() && ReadSnapshot(start))
+    {
+        return;
+    }
+    Compute(start);
+}
+
+void
+LeoRoutingSnapshots::Compute(Time start)
+{
+    NS_LOG_FUNCTION(this << start);
+
+    std::vector<std::vector<InEdge>> edges;
+    CollectIslEdges(edges);
+    bool islChanged = IslChanged(edges);
+    if (islChanged)
+    {
+        ComputeIslTables(edges);
+        std::swap(m_isl, m_nextIsl);
+
+        m_computedLinks.clear();
+        m_computedWeights.clear();
+        for (uint32_t to = 0; to < edges.size(); to++)
+        {
+            for (const InEdge& edge : edges[to])
+            {
+                m_computedLinks.emplace_back(edge.from, to);
+                m_computedWeights.push_back(edge.weight);
+            }
+        }
+        m_nComputations++;
+    }
+    else
+    {
+        NS_LOG_LOGIC("ISL lengths within tolerance, keeping the tables");
+    }
+    ComputeAttachments();
+
+    if (m_out.is_open())
+    {
+        WriteSnapshot(start, islChanged);
+    }
+}
+
+void
+LeoRoutingSnapshots::CollectIslEdges(std::vector<std::vector<InEdge>>& edges) const
+{
+    edges.assign(m_satellites.size(), {});
+    for (uint32_t from = 0; from < m_satellites.size(); from++)
+    {
+        Ptr<Node> node = m_satellites[from];
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            Ptr<MockNetDevice> src = DynamicCast<MockNetDevice>(node->GetDevice(i));
+            if (src == nullptr || DynamicCast<LeoMockNetDevice>(src) != nullptr)
+            {
+                continue;
+            }
+            Ptr<MockChannel> channel = DynamicCast<MockChannel>(src->GetChannel());
+            if (channel == nullptr)
+            {
+                continue;
+            }
+            Ptr<MobilityModel> srcMob = node->GetObject<MobilityModel>();
+            for (std::size_t j = 0; j < channel->GetNDevices(); j++)
+            {
+                Ptr<MockNetDevice> dst = DynamicCast<MockNetDevice>(channel->GetDevice(j));
+                if (dst == nullptr || dst == src)
+                {
+                    continue;
+                }
+                auto it = m_vertices.find(dst->GetNode()->GetId());
+                if (it == m_vertices.end() || it->second.ground ||
+                    std::isinf(CalcLinkRxPower(src, dst)))
+                {
+                    continue;
+                }
+
+                Ptr<MobilityModel> dstMob = dst->GetNode()->GetObject<MobilityModel>();
+                double weight = 1.0;
+                if (srcMob != nullptr && dstMob != nullptr)
+                {
+                    weight = srcMob->GetDistanceFrom(dstMob);
+                }
+                edges[it->second.index].push_back({from, weight, GetNextHop(src, dst)});
+            }
+        }
+    }
+}
+
+void
+LeoRoutingSnapshots::ComputeAttachments()
+{
+    std::vector<Attachment> attachments(m_grounds.size());
+    for (uint32_t g = 0; g < m_grounds.size(); g++)
+    {
+        Ptr<Node> node = m_grounds[g];
+        double best = -std::numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            Ptr<LeoMockNetDevice> gnd = DynamicCast<LeoMockNetDevice>(node->GetDevice(i));
+            if (gnd == nullptr || gnd->GetDeviceType() != LeoMockNetDevice::GND)
+            {
+                continue;
+            }
+            Ptr<MockChannel> channel = DynamicCast<MockChannel>(gnd->GetChannel());
+            if (channel == nullptr)
+            {
+                continue;
+            }
+            for (std::size_t j = 0; j < channel->GetNDevices(); j++)
+            {
+                Ptr<LeoMockNetDevice> sat = DynamicCast<LeoMockNetDevice>(channel->GetDevice(j));
+                if (sat == nullptr || sat->GetDeviceType() != LeoMockNetDevice::SAT)
+                {
+                    continue;
+                }
+                auto it = m_vertices.find(sat->GetNode()->GetId());
+                if (it == m_vertices.end() || it->second.ground)
+                {
+                    continue;
+                }
+                double rxPower = CalcLinkRxPower(sat, gnd);
+                if (rxPower <= best || std::isinf(CalcLinkRxPower(gnd, sat)))
+                {
+                    continue;
+                }
+                best = rxPower;
+                attachments[g].satellite = it->second.index;
+                attachments[g].up = GetNextHop(gnd, sat);
+                attachments[g].down = GetNextHop(sat, gnd);
+            }
+        }
+    }
+    m_attachments.swap(attachments);
+}
+
+bool
+LeoRoutingSnapshots::IslChanged(const std::vector<std::vector<InEdge>>& edges) const
+{
+    if (m_nComputations == 0 || m_computedLinks.empty())
+    {
+        return true;
+    }
+
+    std::size_t k = 0;
+    for (uint32_t to = 0; to < edges.size(); to++)
+    {
+        for (const InEdge& edge : edges[to])
+        {
+            if (k == m_computedLinks.size() ||
+                m_computedLinks[k] != std::make_pair(edge.from, to) ||
+                std::abs(edge.weight - m_computedWeights[k]) >
+                    m_recomputeTolerance * m_computedWeights[k])
+            {
+                return true;
+            }
+            k++;
+        }
+    }
+    return k != m_computedLinks.size();
+}
+
+void
+LeoRoutingSnapshots::ComputeIslTables(const std::vector<std::vector<InEdge>>& edges)
+{
+    const std::size_t n = m_satellites.size();
+    m_nextIsl.assign(n * n, NextHop());
+
+    using Entry = std::pair<double, uint32_t>;
+    std::vector<double> distance(n);
+    for (uint32_t to = 0; to < n; to++)
+    {
+        // Dijkstra over the reversed graph, so that each settled satellite
+        // learns its first hop towards the destination
+        std::fill(distance.begin(), distance.end(), std::numeric_limits<double>::infinity());
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        distance[to] = 0;
+        queue.emplace(0, to);
+        while (!queue.empty())
+        {
+            auto [d, v] = queue.top();
+            queue.pop();
+            if (d > distance[v])
+            {
+                continue;
+            }
+            for (const InEdge& edge : edges[v])
+            {
+                double candidate = d + edge.weight;
+                if (candidate < distance[edge.from])
+                {
+                    distance[edge.from] = candidate;
+                    m_nextIsl[to * n + edge.from] = edge.hop;
+                    queue.emplace(candidate, edge.from);
+                }
+            }
+        }
+    }
+}
+
+double
+LeoRoutingSnapshots::CalcLinkRxPower(Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst)
+{
+    double rxPower = src->GetTxPower();
+    Ptr<MockChannel> channel = DynamicCast<MockChannel>(src->GetChannel());
+    Ptr<MobilityModel> srcMob = src->GetNode()->GetObject<MobilityModel>();
+    Ptr<MobilityModel> dstMob = dst->GetNode()->GetObject<MobilityModel>();
+    if (channel != nullptr && channel->GetPropagationLoss() != nullptr && srcMob != nullptr &&
+        dstMob != nullptr)
+    {
+        rxPower = channel->GetPropagationLoss()->CalcRxPower(rxPower, srcMob, dstMob);
+        if (rxPower < -900.0)
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+    }
+    if (!dst->IsReceivable(src, rxPower))
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return rxPower;
+}
+
+LeoRoutingSnapshots::NextHop
+LeoRoutingSnapshots::GetNextHop(Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst)
+{
+    NextHop hop;
+    Ptr<Ipv4> srcIpv4 = src->GetNode()->GetObject<Ipv4>();
+    Ptr<Ipv4> dstIpv4 = dst->GetNode()->GetObject<Ipv4>();
+    int32_t srcInterface = srcIpv4->GetInterfaceForDevice(src);
+    int32_t dstInterface = dstIpv4 != nullptr ? dstIpv4->GetInterfaceForDevice(dst) : -1;
+    if (srcInterface < 0 || dstInterface < 0 || dstIpv4->GetNAddresses(dstInterface) == 0)
+    {
+        return hop;
+    }
+    hop.interface = srcInterface;
+    hop.gateway = dstIpv4->GetAddress(dstInterface, 0).GetLocal().Get();
+    return hop;
+}
+
+uint64_t
+LeoRoutingSnapshots::Fingerprint() const
+{
+    std::ostringstream oss;
+    for (const auto* nodes : {&m_satellites, &m_grounds})
+    {
+        for (Ptr<Node> node : *nodes)
+        {
+            oss << "node " << node->GetId() << '\n';
+
+            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+            for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+            {
+                for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+                {
+                    Ipv4InterfaceAddress address = ipv4->GetAddress(i, j);
+                    oss << i << ' ' << address.GetLocal() << '/' << address.GetMask() << '\n';
+                }
+            }
+
+            Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+            if (mobility == nullptr)
+            {
+                continue;
+            }
+            // orbit parameters are attributes of the mobility models; references to
+            // other objects are skipped, as they are not comparable across runs
+            for (TypeId tid = mobility->GetInstanceTypeId();; tid = tid.GetParent())
+            {
+                oss << tid.GetName() << '\n';
+                for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+                {
+                    TypeId::AttributeInformation info = tid.GetAttribute(i);
+                    const std::string type = info.checker->GetValueTypeName();
+                    if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter() ||
+                        type == "ns3::PointerValue" || type == "ns3::ObjectPtrContainerValue" ||
+                        type == "ns3::CallbackValue")
+                    {
+                        continue;
+                    }
+                    Ptr<AttributeValue> value = info.checker->Create();
+                    if (info.accessor->Get(PeekPointer(mobility), *value))
+                    {
+                        oss << info.name << '=' << value->SerializeToString(info.checker)
+                            << '\n';
+                    }
+                }
+                if (tid == MobilityModel::GetTypeId())
+                {
+                    break;
+                }
+            }
+        }
+    }
+    return Hash64(oss.str());
+}
+
+void
+LeoRoutingSnapshots::OpenFile()
+{
+    if (m_file.empty())
+    {
+        return;
+    }
+
+    const uint32_t satellites = m_satellites.size();
+    const uint32_t grounds = m_grounds.size();
+    const int64_t epoch = m_epoch.GetTimeStep();
+    const uint64_t fingerprint = Fingerprint();
+
+    std::ifstream in(m_file, std::ios::binary);
+    if (in)
+    {
+        char magic[sizeof(SNAPSHOT_MAGIC)];
+        uint32_t fileSatellites = 0;
+        uint32_t fileGrounds = 0;
+        int64_t fileEpoch = 0;
+        uint64_t fileFingerprint = 0;
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(&fileSatellites), sizeof(fileSatellites));
+        in.read(reinterpret_cast<char*>(&fileGrounds), sizeof(fileGrounds));
+        in.read(reinterpret_cast<char*>(&fileEpoch), sizeof(fileEpoch));
+        in.read(reinterpret_cast<char*>(&fileFingerprint), sizeof(fileFingerprint));
+        if (in && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0 &&
+            fileSatellites == satellites && fileGrounds == grounds && fileEpoch == epoch &&
+            fileFingerprint == fingerprint)
+        {
+            NS_LOG_INFO("reading routing snapshots from " << m_file);
+            m_in = std::move(in);
+            return;
+        }
+        NS_LOG_WARN("routing snapshots in " << m_file
+                                            << " do not match the simulation, recomputing them");
+    }
+
+    m_out.open(m_file, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!m_out, "Unable to open routing snapshot file " << m_file);
+    m_out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    m_out.write(reinterpret_cast<const char*>(&satellites), sizeof(satellites));
+    m_out.write(reinterpret_cast<const char*>(&grounds), sizeof(grounds));
+    m_out.write(reinterpret_cast<const char*>(&epoch), sizeof(epoch));
+    m_out.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+}
+
+bool
+LeoRoutingSnapshots::ReadSnapshot(Time start)
+{
+    // Snapshots are only stored for the epochs in which a lookup happened:
+    // apply older ones, since they may carry ISL tables, and stop at newer ones
+    while (true)
+    {
+        std::streampos position = m_in.tellg();
+        int64_t snapshotStart = 0;
+        uint8_t islChanged = 0;
+        m_in.read(reinterpret_cast<char*>(&snapshotStart), sizeof(snapshotStart));
+        if (m_in && snapshotStart > start.GetTimeStep())
+        {
+            m_in.seekg(position);
+            return false;
+        }
+        m_in.read(reinterpret_cast<char*>(&islChanged), sizeof(islChanged));
+        if (m_in && islChanged)
+        {
+            m_nextIsl.resize(m_isl.size());
+            m_in.read(reinterpret_cast<char*>(m_nextIsl.data()),
+                      m_nextIsl.size() * sizeof(NextHop));
+            std::swap(m_isl, m_nextIsl);
+            // tables from the file are not comparable with the sampled links
+            m_computedLinks.clear();
+        }
+        m_in.read(reinterpret_cast<char*>(m_attachments.data()),
+                  m_attachments.size() * sizeof(Attachment));
+
+        if (!m_in)
+        {
+            NS_LOG_WARN("routing snapshots in " << m_file << " end before " << start.As(Time::S)
+                                                << ", computing the next ones");
+            m_in.close();
+            m_computedLinks.clear();
+            return false;
+        }
+        if (snapshotStart == start.GetTimeStep())
+        {
+            return true;
+        }
+    }
+}
+
+void
+LeoRoutingSnapshots::WriteSnapshot(Time start, bool islChanged)
+{
+    const int64_t snapshotStart = start.GetTimeStep();
+    const uint8_t changed = islChanged;
+    m_out.write(reinterpret_cast<const char*>(&snapshotStart), sizeof(snapshotStart));
+    m_out.write(reinterpret_cast<const char*>(&changed), sizeof(changed));
+    if (islChanged)
+    {
+        m_out.write(reinterpret_cast<const char*>(m_isl.data()), m_isl.size() * sizeof(NextHop));
+    }
+    m_out.write(reinterpret_cast<const char*>(m_attachments.data()),
+                m_attachments.size() * sizeof(Attachment));
+}
+
+} // namespace ns3
@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LEO_ROUTING_SNAPSHOTS_H
+#define LEO_ROUTING_SNAPSHOTS_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup leo
+ *
+ * Declaration of LeoRoutingSnapshots - time-varying shortest path tables
+ */
+
+namespace ns3
+{
+
+class MockNetDevice;
+class Node;
+
+/**
+ * \ingroup leo
+ * \brief Shortest path forwarding tables over the time-varying LEO topology
+ *
+ * The nodes and their addresses are collected at the first lookup, so the
+ * tables only cover the nodes installed before the simulation starts.
+ *
+ * The simulation time is split in epochs. At the beginning of each epoch the
+ * topology is sampled from the current positions of the nodes, as given by
+ * their orbital mobility models, and from the propagation loss models of the
+ * MockChannels: a link exists where a frame would be delivered.
+ *
+ * Satellites are the nodes with ISL MockNetDevices or with LeoMockNetDevices
+ * in space, the other nodes with LeoMockNetDevices are on the ground. Each
+ * ground node is attached to the satellite it receives with the highest
+ * power. Satellites get a next hop towards every other satellite, computed
+ * with Dijkstra on the ISL graph weighted by link length, and reach ground
+ * nodes through the satellite they are attached to. Memory is therefore
+ * quadratic in the number of satellites only.
+ *
+ * The ISL tables are only recomputed when a link appears or disappears or
+ * when a link length drifts by more than RecomputeTolerance from the one
+ * used in the last computation. Tables of a new epoch replace the previous
+ * ones with a swap, so forwarding lookups never see a partial update.
+ *
+ * If File is set, the tables are written there as they are computed, and
+ * read back instead of being computed in later runs with the same epoch and
+ * the same fingerprint of the nodes: their ids, interface addresses and the
+ * attributes of their mobility models, which hold the orbit parameters and
+ * the positions at the first lookup. The file uses the native byte order.
+ */
+class LeoRoutingSnapshots : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /// constructor
+    LeoRoutingSnapshots();
+    /// destructor
+    ~LeoRoutingSnapshots() override;
+
+    /// Marker of a missing route
+    static constexpr uint32_t NO_ROUTE = UINT32_MAX;
+
+    /**
+     * \brief Next hop of a node towards a destination
+     */
+    struct NextHop
+    {
+        uint32_t gateway = 0;          ///< IPv4 address of the next hop, host order
+        uint32_t interface = NO_ROUTE; ///< Output interface on the node
+    };
+
+    /**
+     * \brief Find the next hop of a node towards an address, at the current time
+     * \param node the forwarding node
+     * \param destination the destination address
+     * \param [out] nextHop the next hop
+     * \return true iff a route exists
+     */
+    bool Lookup(Ptr<Node> node, Ipv4Address destination, NextHop& nextHop);
+
+    /**
+     * \brief Get the number of ISL table computations done so far
+     * \return number of epochs whose tables have been computed with Dijkstra
+     */
+    uint32_t GetNComputations() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Position of a node in the routing graph
+     */
+    struct Vertex
+    {
+        bool ground;    ///< Whether the node is on the ground
+        uint32_t index; ///< Index among satellites or ground nodes
+    };
+
+    /**
+     * \brief Directed link between two satellites, stored at its head
+     */
+    struct InEdge
+    {
+        uint32_t from;  ///< Satellite at the tail of the link
+        double weight;  ///< Length of the link in meters
+        NextHop hop;    ///< Next hop of the tail over this link
+    };
+
+    /**
+     * \brief Attachment of a ground node to a satellite
+     */
+    struct Attachment
+    {
+        uint32_t satellite = NO_ROUTE; ///< Index of the satellite
+        NextHop up;                    ///< Next hop of the ground node towards the satellite
+        NextHop down;                  ///< Next hop of the satellite towards the ground node
+    };
+
+    /**
+     * \brief Collect the nodes and addresses of the simulation
+     */
+    void Initialize();
+
+    /**
+     * \brief Replace the tables if a new epoch has started
+     */
+    void Update();
+
+    /**
+     * \brief Compute the tables of the current topology into m_isl and m_attachments
+     * \param start beginning of the current epoch
+     */
+    void Compute(Time start);
+
+    /**
+     * \brief Sample the ISL links of the current topology
+     * \param [out] edges links, grouped by head satellite
+     */
+    void CollectIslEdges(std::vector<std::vector<InEdge>>& edges) const;
+
+    /**
+     * \brief Attach each ground node to the best satellite it can reach
+     */
+    void ComputeAttachments();
+
+    /**
+     * \brief Whether the ISL links differ from the ones of the last computation
+     * \param edges links, grouped by head satellite
+     * \return true iff the tables need to be recomputed
+     */
+    bool IslChanged(const std::vector<std::vector<InEdge>>& edges) const;
+
+    /**
+     * \brief Run Dijkstra towards every satellite
+     * \param edges links, grouped by head satellite
+     */
+    void ComputeIslTables(const std::vector<std::vector<InEdge>>& edges);
+
+    /**
+     * \brief Get the power at which a frame from a device would reach another one now
+     * \param src sending device
+     * \param dst receiving device
+     * \return the receive power in dBm, or -inf if the channel would not deliver the frame
+     */
+    static double CalcLinkRxPower(Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst);
+
+    /**
+     * \brief Get the next hop of a device towards another device on the same channel
+     * \param src sending device
+     * \param dst receiving device
+     * \return the next hop
+     */
+    static NextHop GetNextHop(Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst);
+
+    /**
+     * \brief Hash the node ids, interface addresses and mobility models of the graph
+     * \return the fingerprint of the nodes, stored in the header of File
+     */
+    uint64_t Fingerprint() const;
+
+    /**
+     * \brief Open File for reading or writing
+     */
+    void OpenFile();
+
+    /**
+     * \brief Read the tables of an epoch from File
+     * \param start beginning of the epoch
+     * \return true iff the tables of the epoch have been read
+     */
+    bool ReadSnapshot(Time start);
+
+    /**
+     * \brief Append the tables of an epoch to File
+     * \param start beginning of the epoch
+     * \param islChanged whether the ISL tables have changed since the previous snapshot
+     */
+    void WriteSnapshot(Time start, bool islChanged);
+
+    Time m_epoch;                 ///< Duration of an epoch
+    double m_recomputeTolerance;  ///< Relative link length drift before recomputing
+    std::string m_file;           ///< Snapshot file, empty to disable it
+
+    bool m_initialized = false;              ///< Whether the graph has been collected
+    Time m_nextEpoch;                        ///< Start of the next epoch
+    std::vector<Ptr<Node>> m_satellites;     ///< Satellite nodes
+    std::vector<Ptr<Node>> m_grounds;        ///< Ground nodes
+    std::unordered_map<uint32_t, Vertex> m_vertices;  ///< Node id to vertex
+    std::unordered_map<Ipv4Address, Vertex, Ipv4AddressHash> m_owners; ///< Address to vertex
+
+    std::vector<NextHop> m_isl;              ///< [destination * satellites + source]
+    std::vector<NextHop> m_nextIsl;          ///< Tables being built for the next epoch
+    std::vector<Attachment> m_attachments;   ///< Attachment of each ground node
+    std::vector<std::pair<uint32_t, uint32_t>> m_computedLinks; ///< Links at the last computation
+    std::vector<double> m_computedWeights;   ///< Link lengths at the last computation
+    uint32_t m_nComputations = 0;            ///< Number of ISL table computations
+
+    std::ifstream m_in;  ///< Snapshot file being read
+    std::ofstream m_out; ///< Snapshot file being written
+};
+
+} // namespace ns3
+
+#endif /* LEO_ROUTING_SNAPSHOTS_H */
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "leo-snapshot-routing.h"
+
+#include "ns3/ipv4-route.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LeoSnapshotRouting");
+
+NS_OBJECT_ENSURE_REGISTERED(LeoSnapshotRouting);
+
+TypeId
+LeoSnapshotRouting::GetTypeId()
+{
+    return TypeId("ns3::LeoSnapshotRouting")
+        .SetParent<Ipv4RoutingProtocol>()
+        .SetGroupName("Leo")
+        .AddConstructor<LeoSnapshotRouting>();
+}
+
+LeoSnapshotRouting::LeoSnapshotRouting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LeoSnapshotRouting::~LeoSnapshotRouting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LeoSnapshotRouting::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_ipv4 = nullptr;
+    m_snapshots = nullptr;
+    Ipv4RoutingProtocol::DoDispose();
+}
+
+void
+LeoSnapshotRouting::SetSnapshots(Ptr<LeoRoutingSnapshots> snapshots)
+{
+    m_snapshots = snapshots;
+}
+
+Ptr<LeoRoutingSnapshots>
+LeoSnapshotRouting::GetSnapshots() const
+{
+    return m_snapshots;
+}
+
+Ptr<Ipv4Route>
+LeoSnapshotRouting::RouteOutput(Ptr<Packet> p,
+                                const Ipv4Header& header,
+                                Ptr<NetDevice> oif,
+                                Socket::SocketErrno& sockerr)
+{
+    NS_LOG_FUNCTION(this << p << header.GetDestination() << oif);
+    NS_ASSERT_MSG(m_snapshots != nullptr, "No LeoRoutingSnapshots set");
+
+    LeoRoutingSnapshots::NextHop hop;
+    Ipv4Address destination = header.GetDestination();
+    if (!m_snapshots->Lookup(m_ipv4->GetObject<Node>(), destination, hop) ||
+        (oif != nullptr &&
+         m_ipv4->GetInterfaceForDevice(oif) != static_cast<int32_t>(hop.interface)))
+    {
+        NS_LOG_LOGIC("no route to " << destination);
+        sockerr = Socket::ERROR_NOROUTETOHOST;
+        return nullptr;
+    }
+
+    sockerr = Socket::ERROR_NOTERROR;
+    return BuildRoute(destination, hop);
+}
+
+bool
+LeoSnapshotRouting::RouteInput(Ptr<const Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<const NetDevice> idev,
+                               const UnicastForwardCallback& ucb,
+                               const MulticastForwardCallback& mcb,
+                               const LocalDeliverCallback& lcb,
+                               const ErrorCallback& ecb)
+{
+    NS_LOG_FUNCTION(this << p << header.GetDestination() << idev);
+    NS_ASSERT_MSG(m_snapshots != nullptr, "No LeoRoutingSnapshots set");
+
+    Ipv4Address destination = header.GetDestination();
+    int32_t iif = m_ipv4->GetInterfaceForDevice(idev);
+    NS_ASSERT(iif >= 0);
+
+    if (m_ipv4->IsDestinationAddress(destination, iif))
+    {
+        if (lcb.IsNull())
+        {
+            return false;
+        }
+        lcb(p, header, iif);
+        return true;
+    }
+    if (destination.IsMulticast())
+    {
+        return false;
+    }
+    if (!m_ipv4->IsForwarding(iif))
+    {
+        ecb(p, header, Socket::ERROR_NOROUTETOHOST);
+        return true;
+    }
+
+    LeoRoutingSnapshots::NextHop hop;
+    if (!m_snapshots->Lookup(m_ipv4->GetObject<Node>(), destination, hop))
+    {
+        NS_LOG_LOGIC("no route to " << destination);
+        return false;
+    }
+    ucb(BuildRoute(destination, hop), p, header);
+    return true;
+}
+
+Ptr<Ipv4Route>
+LeoSnapshotRouting::BuildRoute(Ipv4Address destination,
+                               const LeoRoutingSnapshots::NextHop& hop) const
+{
+    Ptr<Ipv4Route> route = Create<Ipv4Route>();
+    route->SetDestination(destination);
+    route->SetGateway(Ipv4Address(hop.gateway));
+    route->SetOutputDevice(m_ipv4->GetNetDevice(hop.interface));
+    route->SetSource(m_ipv4->GetAddress(hop.interface, 0).GetLocal());
+    return route;
+}
+
+void
+LeoSnapshotRouting::NotifyInterfaceUp(uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << interface);
+}
+
+void
+LeoSnapshotRouting::NotifyInterfaceDown(uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << interface);
+}
+
+void
+LeoSnapshotRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+    NS_LOG_FUNCTION(this << interface << address);
+}
+
+void
+LeoSnapshotRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+    NS_LOG_FUNCTION(this << interface << address);
+}
+
+void
+LeoSnapshotRouting::SetIpv4(Ptr<Ipv4> ipv4)
+{
+    NS_LOG_FUNCTION(this << ipv4);
+    NS_ASSERT(m_ipv4 == nullptr && ipv4 != nullptr);
+    m_ipv4 = ipv4;
+}
+
+void
+LeoSnapshotRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
+{
+    std::ostream* os = stream->GetStream();
+    *os << "Node: " << m_ipv4->GetObject<Node>()->GetId()
+        << ", Time: " << Now().As(unit)
+        << ", LeoSnapshotRouting: routes follow the topology snapshot of the current epoch, "
+        << m_snapshots->GetNComputations() << " ISL table computations so far" << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LEO_SNAPSHOT_ROUTING_H
+#define LEO_SNAPSHOT_ROUTING_H
+
+#include "leo-routing-snapshots.h"
+
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+
+/**
+ * \file
+ * \ingroup leo
+ *
+ * Declaration of LeoSnapshotRouting - IPv4 routing over LeoRoutingSnapshots
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup leo
+ * \brief IPv4 unicast routing along the shortest paths of the current topology snapshot
+ *
+ * All the nodes of a simulation share one LeoRoutingSnapshots, which holds
+ * their next hops for the current epoch. Multicast is not routed.
+ */
+class LeoSnapshotRouting : public Ipv4RoutingProtocol
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /// constructor
+    LeoSnapshotRouting();
+    /// destructor
+    ~LeoSnapshotRouting() override;
+
+    /**
+     * \brief Set the tables shared by the nodes
+     * \param snapshots the tables
+     */
+    void SetSnapshots(Ptr<LeoRoutingSnapshots> snapshots);
+
+    /**
+     * \brief Get the tables shared by the nodes
+     * \return the tables
+     */
+    Ptr<LeoRoutingSnapshots> GetSnapshots() const;
+
+    Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr) override;
+    bool RouteInput(Ptr<const Packet> p,
+                    const Ipv4Header& header,
+                    Ptr<const NetDevice> idev,
+                    const UnicastForwardCallback& ucb,
+                    const MulticastForwardCallback& mcb,
+                    const LocalDeliverCallback& lcb,
+                    const ErrorCallback& ecb) override;
+    void NotifyInterfaceUp(uint32_t interface) override;
+    void NotifyInterfaceDown(uint32_t interface) override;
+    void NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    void NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    void SetIpv4(Ptr<Ipv4> ipv4) override;
+    void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
+                           Time::Unit unit = Time::S) const override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Build the route of the node towards a destination
+     * \param destination the destination address
+     * \param hop the next hop
+     * \return the route
+     */
+    Ptr<Ipv4Route> BuildRoute(Ipv4Address destination,
+                              const LeoRoutingSnapshots::NextHop& hop) const;
+
+    Ptr<Ipv4> m_ipv4;                      ///< IPv4 of the node
+    Ptr<LeoRoutingSnapshots> m_snapshots;  ///< Tables shared by the nodes
+};
+
+} // namespace ns3
+
+#endif /* LEO_SNAPSHOT_ROUTING_H */
@@ -23,6 +23,13 @@
 #include <ns3/pointer.h>
 #include <ns3/enum.h>
 #include "mock-channel.h"
+#include "mock-mpi-tag.h"
+#include "isl-propagation-loss-model.h"
+#include "leo-propagation-loss-model.h"
+
+#ifdef NS3_MPI
+#include <ns3/mpi-interface.h>
+#endif
 
 namespace ns3 {
 
@@ -52,6 +59,12 @@ MockChannel::GetTypeId (void)
                      "interface.",
                      MakeTraceSourceAccessor (&MockChannel::m_txrxMock),
                      "ns3::MockChannel::TxRxAnimationCallback")
+    .AddTraceSource ("RxFiltered",
+                     "Trace source reporting, once per transmission, the "
+                     "number of destinations that have not been scheduled "
+                     "because they would have dropped the packet.",
+                     MakeTraceSourceAccessor (&MockChannel::m_filteredRxTrace),
+                     "ns3::MockChannel::RxFilteredCallback")
     ;
   return tid;
 }
@@ -59,7 +72,11 @@ MockChannel::GetTypeId (void)
 //
 // By default, you get a channel that
 // has an "infitely" fast transmission speed and zero processing delay.
-MockChannel::MockChannel() : Channel (), m_link (0)
+MockChannel::MockChannel()
+  : Channel (),
+    m_link (0),
+    m_pendingFilteredRx (0),
+    m_totalFilteredRx (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -187,18 +204,48 @@ MockChannel::Deliver (
       	  if (rxPower < -900.0)
     	    {
       	      NS_LOG_WARN (this << "unable to reach destination " << dst->GetNode ()->GetId () << " from " << src->GetNode ()->GetId ());
+      	      m_pendingFilteredRx ++;
       	      return false;
     	    }
     	}
+    }
+
+  // Evaluate the receiver chain now, so that frames which would be dropped
+  // on reception do not cost an event and a packet copy
+  if (!dst->IsReceivable (src, rxPower))
+    {
+      NS_LOG_LOGIC ("filtered reception at " << dst->GetAddress () << " with rxPower " << rxPower);
+      m_pendingFilteredRx ++;
+      return false;
+    }
+
+  if (srcMob != nullptr && dstMob != nullptr)
+    {
       delay = GetPropagationDelay (srcMob, dstMob, txTime);
       NS_LOG_DEBUG ("delay = "<<delay);
     }
 
+#ifdef NS3_MPI
+  // the destination is simulated by another rank, which holds replicas of
+  // all the nodes: the frame only needs the sender and the receive power
+  if (MpiInterface::IsEnabled () && dst->GetNode ()->GetSystemId () != MpiInterface::GetSystemId ())
+    {
+      Ptr<Packet> remote = p->Copy ();
+      remote->AddPacketTag (MockMpiTag (src->GetNode ()->GetId (), src->GetIfIndex (), rxPower));
+      MpiInterface::SendPacket (remote,
+                                Simulator::Now () + delay,
+                                dst->GetNode ()->GetId (),
+                                dst->GetIfIndex ());
+      m_txrxMock (p, src, dst, txTime, delay);
+      return true;
+    }
+#endif
+
   Simulator::ScheduleWithContext (dst->GetNode ()->GetId (),
         			  delay,
         			  &MockNetDevice::Receive,
         			  dst,
-        			  p->Copy (),
+        			  p,
         			  src,
         			  rxPower);
 
@@ -207,10 +254,127 @@ MockChannel::Deliver (
   return true;
 }
 
+bool
+MockChannel::DeliverAll (Ptr<const Packet> p,
+                         Ptr<MockNetDevice> src,
+                         const std::vector<Ptr<MockNetDevice> > &dsts,
+                         Time txTime)
+{
+  NS_LOG_FUNCTION (this << p << src << dsts.size () << txTime);
+
+  Ptr<MobilityModel> srcMob = src->GetNode ()->GetObject<MobilityModel> ();
+  Ptr<LeoPropagationLossModel> leoLoss = DynamicCast<LeoPropagationLossModel> (m_propagationLoss);
+  Ptr<IslPropagationLossModel> islLoss = DynamicCast<IslPropagationLossModel> (m_propagationLoss);
+  bool batch = srcMob != nullptr && (leoLoss != nullptr || islLoss != nullptr);
+
+  std::size_t n = dsts.size ();
+  if (batch)
+    {
+      m_rxX.resize (n);
+      m_rxY.resize (n);
+      m_rxZ.resize (n);
+      m_reachable.resize (n);
+      for (std::size_t i = 0; i < n; i ++)
+        {
+          Ptr<MobilityModel> dstMob = dsts[i]->GetNode ()->GetObject<MobilityModel> ();
+          if (dstMob == nullptr)
+            {
+              // Deliver does not apply the loss model to this destination
+              batch = false;
+              break;
+            }
+          Vector pos = dstMob->GetPosition ();
+          m_rxX[i] = pos.x;
+          m_rxY[i] = pos.y;
+          m_rxZ[i] = pos.z;
+        }
+    }
+  if (batch)
+    {
+      Vector pos = srcMob->GetPosition ();
+      if (leoLoss != nullptr)
+        {
+          leoLoss->GetReachable (pos, m_rxX.data (), m_rxY.data (), m_rxZ.data (), n, m_reachable.data ());
+        }
+      else
+        {
+          islLoss->GetReachable (pos, m_rxX.data (), m_rxY.data (), m_rxZ.data (), n, m_reachable.data ());
+        }
+    }
+
+  bool result = false;
+  for (std::size_t i = 0; i < n; i ++)
+    {
+      if (dsts[i] == src)
+        {
+          continue;
+        }
+      if (batch && !m_reachable[i])
+        {
+          m_pendingFilteredRx ++;
+          continue;
+        }
+      if (Deliver (p, src, dsts[i], txTime))
+        {
+          result = true;
+        }
+    }
+  return result;
+}
+
+const std::vector<Ptr<MockNetDevice> > &
+MockChannel::GetDevices (void) const
+{
+  return m_link;
+}
+
 void
 MockChannel::SetPropagationDelay (Ptr<PropagationDelayModel> delay)
 {
   m_propagationDelay = delay;
 }
 
+void
+MockChannel::NotifyFilteredRx (Ptr<const Packet> p, Ptr<MockNetDevice> src)
+{
+  if (m_pendingFilteredRx == 0)
+    {
+      return;
+    }
+  m_totalFilteredRx += m_pendingFilteredRx;
+  m_filteredRxTrace (p, src, m_pendingFilteredRx);
+  m_pendingFilteredRx = 0;
+}
+
+uint64_t
+MockChannel::GetNFilteredRx (void) const
+{
+  return m_totalFilteredRx + m_pendingFilteredRx;
+}
+
+bool
+MockChannel::CanReach (Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst) const
+{
+  return src != dst;
+}
+
+void
+MockChannel::AddNeighbor (Ipv4Address address, Ptr<MockNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << address << device);
+  m_neighbors[address] = device;
+}
+
+Ptr<MockNetDevice>
+MockChannel::ResolveNeighbor (Ipv4Address address, Ptr<MockNetDevice> requester) const
+{
+  NS_LOG_FUNCTION (this << address << requester);
+  auto it = m_neighbors.find (address);
+  if (it == m_neighbors.end () || !CanReach (requester, it->second))
+    {
+      return nullptr;
+    }
+  return it->second;
+}
+
 } // namespace ns3
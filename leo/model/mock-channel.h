@@ -32,8 +32,11 @@
 #include "ns3/mobility-module.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/ipv4-address.h"
 #include "mock-net-device.h"
 
+#include <unordered_map>
+
 /**
  * \file
  * \ingroup leo
@@ -120,6 +123,33 @@ public:
    */
   void SetPropagationDelay (Ptr<PropagationDelayModel> delay);
 
+  /**
+   * \brief Get the number of receptions filtered by the channel
+   * \return number of frames that have not been scheduled because their
+   * destination would have dropped them
+   */
+  uint64_t GetNFilteredRx (void) const;
+
+  /**
+   * \brief Add a device to the neighbour table of the channel
+   *
+   * The table is shared by all the devices attached to the channel and is
+   * used to answer their ARP requests locally, without any ARP traffic.
+   *
+   * \param address IPv4 address of the device
+   * \param device the device
+   */
+  void AddNeighbor (Ipv4Address address, Ptr<MockNetDevice> device);
+
+  /**
+   * \brief Look up a neighbour in the table of the channel
+   * \param address IPv4 address to resolve
+   * \param requester device asking for the resolution
+   * \return the device with that address if the requester can reach it,
+   * null otherwise
+   */
+  Ptr<MockNetDevice> ResolveNeighbor (Ipv4Address address, Ptr<MockNetDevice> requester) const;
+
 protected:
   TracedCallback<Ptr<const Packet>,     // Packet being transmitted
                  Ptr<NetDevice>,  // Transmitting NetDevice
@@ -146,6 +176,12 @@ protected:
 
   /**
    * \brief Deliver a packet to a destination
+   *
+   * The packet is not copied: the same instance is scheduled to every
+   * destination, which only copies it when needed. Callers must pass a
+   * packet that the sender will not modify anymore. Destinations simulated
+   * by another MPI rank get a copy through the MpiInterface instead.
+   *
    * \param p packet
    * \param src source of a packet
    * \param dst destination of a packet
@@ -154,6 +190,53 @@ protected:
    */
   bool Deliver ( Ptr<const Packet> p, Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst, Time txTime);
 
+  /**
+   * \brief Deliver a packet to several destinations
+   *
+   * If the propagation loss model of the channel is a LeoPropagationLossModel
+   * or an IslPropagationLossModel, the destinations out of its reach are
+   * found with one batch test over their positions and are skipped, instead
+   * of being evaluated one by one by Deliver.
+   *
+   * \param p packet, shared by all the destinations
+   * \param src source of the packet, skipped if it is among the destinations
+   * \param dsts destinations of the packet
+   * \param txTime transmission time of the packet
+   * \return true iff the packet has been delivered to at least one destination
+   */
+  bool DeliverAll (Ptr<const Packet> p, Ptr<MockNetDevice> src, const std::vector<Ptr<MockNetDevice> > &dsts, Time txTime);
+
+  /**
+   * \brief Get the devices attached to the channel
+   * \return the devices, in the order of their attachment
+   */
+  const std::vector<Ptr<MockNetDevice> > &GetDevices (void) const;
+
+  /**
+   * \brief Report the receptions filtered by Deliver since the last call
+   *
+   * Deliver does not schedule frames that the destination would drop, so
+   * subclasses call this once per transmission instead of having each
+   * destination fire its PhyRxDrop trace.
+   *
+   * \param p packet
+   * \param src source of the packet
+   */
+  void NotifyFilteredRx (Ptr<const Packet> p, Ptr<MockNetDevice> src);
+
+  /**
+   * \brief Whether a device can send frames to another one on this channel
+   * \param src sending device
+   * \param dst receiving device
+   * \return true iff src and dst are different devices
+   */
+  virtual bool CanReach (Ptr<MockNetDevice> src, Ptr<MockNetDevice> dst) const;
+
+  TracedCallback<Ptr<const Packet>,     // Packet being transmitted
+                 Ptr<NetDevice>,        // Transmitting NetDevice
+                 uint32_t               // Number of receivers that can not receive it
+                 > m_filteredRxTrace;
+
 private:
 
   /// All devices that are attached to the channel
@@ -165,6 +248,23 @@ private:
   /// Propagation loss model to be used with this channel
   Ptr<PropagationLossModel> m_propagationLoss;
 
+  /// Receptions filtered since the last NotifyFilteredRx
+  uint32_t m_pendingFilteredRx;
+
+  /// Receptions filtered since the creation of the channel
+  uint64_t m_totalFilteredRx;
+
+  /// Coordinates of the destinations of DeliverAll, reused between calls
+  std::vector<double> m_rxX;
+  std::vector<double> m_rxY;
+  std::vector<double> m_rxZ;
+
+  /// Result of the batch test of DeliverAll, reused between calls
+  std::vector<uint8_t> m_reachable;
+
+  /// IPv4 address to device table shared by all the devices of the channel
+  std::unordered_map<Ipv4Address, Ptr<MockNetDevice>, Ipv4AddressHash> m_neighbors;
+
 }; // class MockChannel
 
 } // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mock-mpi-tag.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MockMpiTag);
+
+TypeId
+MockMpiTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MockMpiTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("Leo")
+    .AddConstructor<MockMpiTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+MockMpiTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+MockMpiTag::MockMpiTag ()
+  : m_node (0),
+    m_ifIndex (0),
+    m_rxPower (0.0)
+{
+}
+
+MockMpiTag::MockMpiTag (uint32_t node, uint32_t ifIndex, double rxPower)
+  : m_node (node),
+    m_ifIndex (ifIndex),
+    m_rxPower (rxPower)
+{
+}
+
+uint32_t
+MockMpiTag::GetNode (void) const
+{
+  return m_node;
+}
+
+uint32_t
+MockMpiTag::GetIfIndex (void) const
+{
+  return m_ifIndex;
+}
+
+double
+MockMpiTag::GetRxPower (void) const
+{
+  return m_rxPower;
+}
+
+uint32_t
+MockMpiTag::GetSerializedSize (void) const
+{
+  return 2 * sizeof (uint32_t) + sizeof (double);
+}
+
+void
+MockMpiTag::Serialize (TagBuffer i) const
+{
+  i.WriteU32 (m_node);
+  i.WriteU32 (m_ifIndex);
+  i.WriteDouble (m_rxPower);
+}
+
+void
+MockMpiTag::Deserialize (TagBuffer i)
+{
+  m_node = i.ReadU32 ();
+  m_ifIndex = i.ReadU32 ();
+  m_rxPower = i.ReadDouble ();
+}
+
+void
+MockMpiTag::Print (std::ostream &os) const
+{
+  os << "node=" << m_node << " ifIndex=" << m_ifIndex << " rxPower=" << m_rxPower;
+}
+
+} // namespace ns3
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOCK_MPI_TAG_H
+#define MOCK_MPI_TAG_H
+
+#include <stdint.h>
+
+#include "ns3/tag.h"
+
+/**
+ * \file
+ * \ingroup leo
+ * MockMpiTag declaration
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup leo
+ * \brief Sender information of a frame delivered to another MPI rank
+ *
+ * MpiInterface only carries the packet, so the channel of the sending rank
+ * tags it with what MockNetDevice::Receive needs on the receiving rank: the
+ * sending device and the power at which the frame arrives.
+ */
+class MockMpiTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  /// constructor
+  MockMpiTag ();
+
+  /**
+   * \brief Constructor
+   * \param node id of the node of the sending device
+   * \param ifIndex index of the sending device on its node
+   * \param rxPower receive power in dBm, before the receiver chain
+   */
+  MockMpiTag (uint32_t node, uint32_t ifIndex, double rxPower);
+
+  /**
+   * \return id of the node of the sending device
+   */
+  uint32_t GetNode (void) const;
+
+  /**
+   * \return index of the sending device on its node
+   */
+  uint32_t GetIfIndex (void) const;
+
+  /**
+   * \return receive power in dBm, before the receiver chain
+   */
+  double GetRxPower (void) const;
+
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+private:
+  uint32_t m_node;    ///< Node of the sending device
+  uint32_t m_ifIndex; ///< Index of the sending device
+  double m_rxPower;   ///< Receive power in dBm
+};
+
+} // namespace ns3
+
+#endif /* MOCK_MPI_TAG_H */
@@ -29,9 +29,18 @@
 #include "ns3/ethernet-header.h"
 #include "ns3/ethernet-trailer.h"
 #include "ns3/double.h"
+#include "ns3/arp-header.h"
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/node-list.h"
 #include "mock-channel.h"
+#include "mock-mpi-tag.h"
 #include "mock-net-device.h"
 
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#endif
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("MockNetDevice");
@@ -265,6 +274,17 @@ MockNetDevice::DoInitialize (void)
       m_queueInterface->GetTxQueue (0)->ConnectQueueTraces (m_queue);
     }
 
+#ifdef NS3_MPI
+  // frames from devices on other ranks are handed over by the MpiInterface
+  // to the MpiReceiver aggregated to the destination device
+  if (MpiInterface::IsEnabled () && GetObject<MpiReceiver> () == nullptr)
+    {
+      Ptr<MpiReceiver> mpiRec = CreateObject<MpiReceiver> ();
+      mpiRec->SetReceiveCallback (MakeCallback (&MockNetDevice::DoMpiReceive, this));
+      AggregateObject (mpiRec);
+    }
+#endif
+
   NetDevice::DoInitialize ();
 }
 
@@ -418,8 +438,14 @@ MockNetDevice::DoCalcRxPower (double rxPower) const
   return rxPower;
 }
 
+bool
+MockNetDevice::IsReceivable (Ptr<MockNetDevice> senderDevice, double rxPower) const
+{
+  return senderDevice != this && DoCalcRxPower (rxPower) >= m_rxThreshold;
+}
+
 void
-MockNetDevice::Receive (Ptr<Packet> packet,
+MockNetDevice::Receive (Ptr<const Packet> packet,
 			Ptr<MockNetDevice> senderDevice,
 			double rxPower)
 {
@@ -442,31 +468,72 @@ MockNetDevice::Receive (Ptr<Packet> packet,
       return;
     }
 
-  if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (packet) )
+  //
+  // The packet is shared by every receiver of a broadcast, so it is only
+  // copied when this device has to modify it or hand it to upper layers.
+  //
+  Ptr<Packet> copy;
+
+  if (m_receiveErrorModel)
     {
-      //
-      // If we have an error model and it indicates that it is time to lose a
-      // corrupted packet, don't forward this packet up, let it go.
-      //
-      m_phyRxDropTrace (packet);
+      copy = packet->Copy ();
+      if (m_receiveErrorModel->IsCorrupt (copy))
+        {
+          //
+          // If we have an error model and it indicates that it is time to lose a
+          // corrupted packet, don't forward this packet up, let it go.
+          //
+          m_phyRxDropTrace (packet);
+
+          return;
+        }
+    }
+
+  EthernetHeader header;
+  packet->PeekHeader (header);
 
+  PacketType packetType;
+  if (header.GetDestination ().IsBroadcast ())
+    {
+      packetType = PACKET_BROADCAST;
+    }
+  else if (header.GetDestination () == m_address)
+    {
+      packetType = PACKET_HOST;
+    }
+  else if (header.GetDestination ().IsGroup ())
+    {
+      packetType = PACKET_MULTICAST;
+    }
+  else
+    {
+      packetType = PACKET_OTHERHOST;
+    }
+
+  if (packetType == PACKET_OTHERHOST && m_promiscCallback.IsNull () && !Node::ChecksumEnabled ())
+    {
+      // Nobody above us wants the frame, so there is no need to strip it
+      m_promiscSnifferTrace (packet);
       return;
     }
 
+  if (copy == nullptr)
+    {
+      copy = packet->Copy ();
+    }
+
   //
   // Trace sinks will expect complete packets, not packets without some of the
-  // headers.
+  // headers, so they get the shared packet.
   //
-  Ptr<Packet> originalPacket = packet->Copy ();
-
   EthernetTrailer trailer;
-  packet->RemoveTrailer (trailer);
+  copy->RemoveTrailer (trailer);
   if (Node::ChecksumEnabled ())
     {
       trailer.EnableFcs (true);
     }
 
-  bool crcGood = trailer.CheckFcs (packet);
+  bool crcGood = trailer.CheckFcs (copy);
   if (!crcGood)
     {
       NS_LOG_INFO ("CRC error on Packet " << packet);
@@ -474,23 +541,22 @@ MockNetDevice::Receive (Ptr<Packet> packet,
       return;
     }
 
-  EthernetHeader header;
-  packet->RemoveHeader (header);
+  copy->RemoveHeader (header);
 
   uint16_t protocol;
 
   if (header.GetLengthType () <= 1500)
     {
-      NS_ASSERT (packet->GetSize () >= header.GetLengthType ());
-      uint32_t padlen = packet->GetSize () - header.GetLengthType ();
+      NS_ASSERT (copy->GetSize () >= header.GetLengthType ());
+      uint32_t padlen = copy->GetSize () - header.GetLengthType ();
       NS_ASSERT (padlen <= 46);
       if (padlen > 0)
         {
-          packet->RemoveAtEnd (padlen);
+          copy->RemoveAtEnd (padlen);
         }
 
       LlcSnapHeader llc;
-      packet->RemoveHeader (llc);
+      copy->RemoveHeader (llc);
       protocol = llc.GetType ();
     }
   else
@@ -498,36 +564,59 @@ MockNetDevice::Receive (Ptr<Packet> packet,
       protocol = header.GetLengthType ();
     }
 
-  PacketType packetType;
-  if (header.GetDestination ().IsBroadcast ())
-    {
-      packetType = PACKET_BROADCAST;
-    }
-  else if (header.GetDestination () == m_address)
-    {
-      packetType = PACKET_HOST;
-    }
-  else if (header.GetDestination ().IsGroup ())
+  m_promiscSnifferTrace (packet);
+  if (!m_promiscCallback.IsNull ())
     {
-      packetType = PACKET_MULTICAST;
+      m_macPromiscRxTrace (packet);
+      m_promiscCallback (this, copy, protocol, header.GetSource (), header.GetDestination (), packetType);
     }
-  else
+
+  if (packetType != PACKET_OTHERHOST) {
+      NS_LOG_INFO ("[node " << m_node->GetId () << "] received packet on " << m_ifIndex << " from " << header.GetSource () << " for " << header.GetDestination ());
+      m_macRxTrace (packet);
+      m_rxCallback (this, copy, protocol, header.GetSource ());
+  }
+}
+
+bool
+MockNetDevice::ResolveArpRequest (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  ArpHeader request;
+  packet->PeekHeader (request);
+  if (!request.IsRequest ())
     {
-      packetType = PACKET_OTHERHOST;
+      return false;
     }
 
-  m_promiscSnifferTrace (originalPacket);
-  if (!m_promiscCallback.IsNull ())
+  Ptr<MockNetDevice> neighbor = m_channel->ResolveNeighbor (request.GetDestinationIpv4Address (), this);
+  if (neighbor == nullptr)
     {
-      m_macPromiscRxTrace (originalPacket);
-      m_promiscCallback (this, packet, protocol, header.GetSource (), header.GetDestination (), packetType);
+      // unknown to the channel, let the request go over the air
+      return false;
     }
 
-  if (packetType != PACKET_OTHERHOST) {
-      NS_LOG_INFO ("[node " << m_node->GetId () << "] received packet on " << m_ifIndex << " from " << header.GetSource () << " for " << header.GetDestination ());
-      m_macRxTrace (originalPacket);
-      m_rxCallback (this, packet, protocol, header.GetSource ());
-  }
+  ArpHeader reply;
+  reply.SetReply (neighbor->GetAddress (),
+                  request.GetDestinationIpv4Address (),
+                  request.GetSourceHardwareAddress (),
+                  request.GetSourceIpv4Address ());
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (reply);
+
+  NS_LOG_LOGIC ("resolved " << request.GetDestinationIpv4Address () << " to " << neighbor->GetAddress ());
+
+  // ArpL3Protocol expects the reply after it has queued the pending packet
+  Simulator::ScheduleNow (&MockNetDevice::ReceiveArpReply, this, p, neighbor->GetAddress ());
+  return true;
+}
+
+void
+MockNetDevice::ReceiveArpReply (Ptr<Packet> reply, Address from)
+{
+  NS_LOG_FUNCTION (this << reply << from);
+  m_rxCallback (this, reply, ArpL3Protocol::PROT_NUMBER, from);
 }
 
 Ptr<Queue<Packet> >
@@ -678,6 +767,11 @@ MockNetDevice::Send (Ptr<Packet> packet,
       return false;
     }
 
+  if (protocolNumber == ArpL3Protocol::PROT_NUMBER && ResolveArpRequest (packet))
+    {
+      return true;
+    }
+
   Mac48Address destination = Mac48Address::ConvertFrom (dest);
   Mac48Address source = Mac48Address::ConvertFrom (m_address);
   AddHeader (packet, source, destination, protocolNumber);
@@ -763,10 +857,17 @@ MockNetDevice::SupportsSendFrom (void) const
 }
 
 void
-MockNetDevice::DoMpiReceive (Ptr<Packet> p, Ptr<MockNetDevice> senderDevice, double txPower)
+MockNetDevice::DoMpiReceive (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
-  Receive (p, senderDevice, txPower);
+  MockMpiTag tag;
+  [[maybe_unused]] bool found = p->RemovePacketTag (tag);
+  NS_ASSERT_MSG (found, "Frame received over MPI without a MockMpiTag");
+
+  // every rank holds all the nodes, so the sender exists here as well
+  Ptr<MockNetDevice> senderDevice = DynamicCast<MockNetDevice> (NodeList::GetNode (tag.GetNode ())->GetDevice (tag.GetIfIndex ()));
+  NS_ASSERT_MSG (senderDevice != nullptr, "Frame received over MPI from an unknown device");
+  Receive (p, senderDevice, tag.GetRxPower ());
 }
 
 Address
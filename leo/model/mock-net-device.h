@@ -159,11 +159,26 @@ public:
    * used by the channel to indicate that the last bit of a packet has
    * arrived at the device.
    *
+   * The packet may be shared with the other receivers of a broadcast, so it
+   * is only copied when the frame has to be stripped for upper layers.
+   *
    * \param p Ptr to the received packet.
    * \param senderDevice sender
    * \param rxPower RX power excluding receiver gain and loss
    */
-  void Receive (Ptr<Packet> p, Ptr<MockNetDevice> senderDevice, double rxPower);
+  void Receive (Ptr<const Packet> p, Ptr<MockNetDevice> senderDevice, double rxPower);
+
+  /**
+   * Check whether a frame passes the sender and power checks of Receive ().
+   *
+   * Used by the channel to avoid scheduling receptions that would be
+   * dropped anyway.
+   *
+   * \param senderDevice sender
+   * \param rxPower RX power excluding receiver gain and loss
+   * \return true iff Receive () would not drop the frame before the error model
+   */
+  bool IsReceivable (Ptr<MockNetDevice> senderDevice, double rxPower) const;
 
   // The remaining methods are documented in ns3::NetDevice*
 
@@ -214,9 +229,12 @@ protected:
   /**
    * \brief Handler for MPI receive event
    *
+   * The sending device and the receive power are taken from the MockMpiTag
+   * added by the channel of the sending rank.
+   *
    * \param p Packet received
    */
-  void DoMpiReceive (Ptr<Packet> p, Ptr<MockNetDevice> sender, double txPower);
+  void DoMpiReceive (Ptr<Packet> p);
 
   virtual void DoInitialize (void);
   virtual void NotifyNewAggregate (void);
@@ -277,6 +295,23 @@ private:
    */
   bool ProcessHeader (Ptr<Packet> p, uint16_t& param);
 
+  /**
+   * Answer an ARP request from the neighbour table of the channel, so that
+   * no ARP traffic has to go over the channel.
+   *
+   * \param packet the ARP packet being sent
+   * \return true iff the request has been answered and must not be transmitted
+   */
+  bool ResolveArpRequest (Ptr<const Packet> packet);
+
+  /**
+   * Hand an ARP reply built by ResolveArpRequest to the upper layers.
+   *
+   * \param reply the ARP reply
+   * \param from hardware address of the resolved device
+   */
+  void ReceiveArpReply (Ptr<Packet> reply, Address from);
+
   /**
    * Start Sending a Packet Down the Wire.
    *
@@ -24,10 +24,14 @@
 #include "ns3/aodv-helper.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/udp-client-server-helper.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
 
 #include "ns3/leo-module.h"
 #include "ns3/test.h"
 
+#include <set>
+
 using namespace ns3;
 
 /**
@@ -117,6 +121,154 @@ IslIcmpTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class IslGridTestCase : public TestCase
+{
+public:
+  IslGridTestCase ();
+  virtual ~IslGridTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+IslGridTestCase::IslGridTestCase ()
+  : TestCase ("Build a +Grid ISL topology")
+{
+}
+
+IslGridTestCase::~IslGridTestCase ()
+{
+}
+
+void
+IslGridTestCase::DoRun (void)
+{
+  const uint32_t planes = 4;
+  const uint32_t sats = 5;
+
+  NodeContainer satellites;
+  satellites.Create (planes * sats);
+
+  IslHelper islCh;
+  NetDeviceContainer islNet = islCh.InstallGrid (satellites, planes, sats);
+
+  NS_TEST_ASSERT_MSG_EQ (islNet.GetN (), 2 * 2 * planes * sats, "unexpected number of ISL devices");
+  for (uint32_t i = 0; i < satellites.GetN (); i ++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (satellites.Get (i)->GetNDevices (), 4, "satellite without four neighbours");
+    }
+  for (uint32_t i = 0; i < islNet.GetN (); i += 2)
+    {
+      NS_TEST_ASSERT_MSG_EQ (islNet.Get (i)->GetChannel (), islNet.Get (i + 1)->GetChannel (), "link devices not on the same channel");
+      NS_TEST_ASSERT_MSG_EQ (islNet.Get (i)->GetChannel ()->GetNDevices (), 2, "link channel shared with other devices");
+    }
+
+  NodeContainer openGrid;
+  openGrid.Create (planes * sats);
+  NetDeviceContainer openNet = islCh.InstallGrid (openGrid, planes, sats, IslHelper::SEAM_NONE);
+  NS_TEST_ASSERT_MSG_EQ (openNet.GetN (), 2 * (planes * sats + (planes - 1) * sats), "seam links installed");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class IslDynamicSeamTestCase : public TestCase
+{
+public:
+  IslDynamicSeamTestCase ();
+  virtual ~IslDynamicSeamTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+IslDynamicSeamTestCase::IslDynamicSeamTestCase ()
+  : TestCase ("Only the seam links of a +Grid are range limited")
+{
+}
+
+IslDynamicSeamTestCase::~IslDynamicSeamTestCase ()
+{
+}
+
+void
+IslDynamicSeamTestCase::DoRun (void)
+{
+  const uint32_t planes = 4;
+  const uint32_t sats = 5;
+
+  NodeContainer satellites;
+  satellites.Create (planes * sats);
+
+  IslHelper islCh;
+  islCh.SetSeamRange (1000000.0);
+  NetDeviceContainer islNet = islCh.InstallGrid (satellites, planes, sats, IslHelper::SEAM_DYNAMIC);
+
+  // two satellites in line of sight, 2000 km apart
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (7000000.0, 0.0, 0.0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (7000000.0, 2000000.0, 0.0));
+
+  std::set<Ptr<PropagationLossModel> > seamLosses;
+  for (uint32_t i = 0; i < islNet.GetN (); i += 2)
+    {
+      Ptr<MockChannel> channel = DynamicCast<MockChannel> (islNet.Get (i)->GetChannel ());
+      Ptr<PropagationLossModel> loss = channel->GetPropagationLoss ();
+      if (loss->GetNext () == nullptr)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (loss->CalcRxPower (0.0, a, b), 0.0, 1e-9, "link outside the seam is range limited");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (seamLosses.insert (loss).second, true, "seam links share their loss model");
+          NS_TEST_ASSERT_MSG_EQ (loss->GetInstanceTypeId (), IslPropagationLossModel::GetTypeId (), "seam loss not of the channel type");
+          NS_TEST_ASSERT_MSG_LT (loss->CalcRxPower (0.0, a, b), -100.0, "seam link not range limited");
+          NS_TEST_ASSERT_MSG_EQ (loss->GetNext ()->GetNext (), nullptr, "range limit appended more than once");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (seamLosses.size (), sats, "unexpected number of seam links");
+
+  // the seam copies the loss model configured on the channels
+  Ptr<LogDistancePropagationLossModel> configured = CreateObject<LogDistancePropagationLossModel> ();
+  configured->SetAttribute ("Exponent", DoubleValue (2.5));
+  NodeContainer others;
+  others.Create (planes * sats);
+  IslHelper logCh;
+  logCh.SetChannelAttribute ("PropagationLoss", PointerValue (configured));
+  NetDeviceContainer logNet = logCh.InstallGrid (others, planes, sats, IslHelper::SEAM_DYNAMIC);
+  uint32_t logSeams = 0;
+  for (uint32_t i = 0; i < logNet.GetN (); i += 2)
+    {
+      Ptr<MockChannel> channel = DynamicCast<MockChannel> (logNet.Get (i)->GetChannel ());
+      Ptr<PropagationLossModel> loss = channel->GetPropagationLoss ();
+      if (loss == configured)
+        {
+          continue;
+        }
+      logSeams ++;
+      NS_TEST_ASSERT_MSG_EQ (loss->GetInstanceTypeId (), LogDistancePropagationLossModel::GetTypeId (), "seam loss not of the channel type");
+      DoubleValue exponent;
+      loss->GetAttribute ("Exponent", exponent);
+      NS_TEST_ASSERT_MSG_EQ_TOL (exponent.Get (), 2.5, 1e-9, "seam loss attributes not copied");
+      NS_TEST_ASSERT_MSG_NE (DynamicCast<RangePropagationLossModel> (loss->GetNext ()), nullptr, "seam link not range limited");
+    }
+  NS_TEST_ASSERT_MSG_EQ (logSeams, sats, "unexpected number of seam links");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup leo-test
  * \ingroup tests
@@ -134,6 +286,8 @@ IslTestSuite::IslTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new IslIcmpTestCase, TestCase::Duration::EXTENSIVE);
+  AddTestCase (new IslGridTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new IslDynamicSeamTestCase, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -17,6 +17,8 @@
  */
 
 #include "ns3/leo-module.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/log.h"
 
@@ -69,6 +71,160 @@ LeoMobilityWaypointTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ ((mobility->WaypointsLeft () > 2), true, "Reading waypoints from empty");
 }
 
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Compare interpolated SGP4 positions with the full SGP4 model
+ */
+class GeoSgp4InterpolationTestCase : public TestCase
+{
+public:
+  GeoSgp4InterpolationTestCase ();
+  virtual ~GeoSgp4InterpolationTestCase () {}
+
+private:
+  virtual void DoRun (void);
+  void Check (Ptr<GeoSGP4Mobility> exact, Ptr<GeoSGP4Mobility> interpolated);
+
+  double m_tolerance;
+};
+
+GeoSgp4InterpolationTestCase::GeoSgp4InterpolationTestCase ()
+  : TestCase ("Interpolated SGP4 positions stay close to the full model"),
+    m_tolerance (1.0)
+{
+}
+
+void
+GeoSgp4InterpolationTestCase::Check (Ptr<GeoSGP4Mobility> exact, Ptr<GeoSGP4Mobility> interpolated)
+{
+  Vector expected = exact->GetPosition (PositionType::GEOCENTRIC);
+  Vector actual = interpolated->GetPosition (PositionType::GEOCENTRIC);
+  // the interpolation error is only checked in the middle of each interval, allow some slack
+  NS_TEST_EXPECT_MSG_LT (CalculateDistance (expected, actual), 2 * m_tolerance,
+                         "Interpolated position too far from SGP4 at " << Simulator::Now ());
+
+  Vector cached = interpolated->GetPosition (PositionType::GEOCENTRIC);
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (actual, cached), 0.0,
+                         "Cached position differs at the same timestamp");
+}
+
+void
+GeoSgp4InterpolationTestCase::DoRun (void)
+{
+  const std::string tle1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+  const std::string tle2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+  Ptr<GeoSGP4Mobility> exact = CreateObject<GeoSGP4Mobility> ();
+  exact->SetAttribute ("Precision", TimeValue (Time (0)));
+  exact->SetAttribute ("TleLine1", StringValue (tle1));
+  exact->SetAttribute ("TleLine2", StringValue (tle2));
+
+  Ptr<GeoSGP4Mobility> interpolated = CreateObject<GeoSGP4Mobility> ();
+  interpolated->SetAttribute ("Precision", TimeValue (Time (0)));
+  interpolated->SetAttribute ("InterpolationStep", TimeValue (Seconds (60)));
+  interpolated->SetAttribute ("InterpolationTolerance", DoubleValue (m_tolerance));
+  interpolated->SetAttribute ("TleLine1", StringValue (tle1));
+  interpolated->SetAttribute ("TleLine2", StringValue (tle2));
+
+  for (double t = 0; t < 1200; t += 7.3)
+    {
+      Simulator::Schedule (Seconds (t), &GeoSgp4InterpolationTestCase::Check, this, exact,
+                           interpolated);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Check that CourseChangeTolerance notifies CourseChange once per tolerance travelled
+ */
+class GeoLeoOrbitAdaptiveUpdateTestCase : public TestCase
+{
+public:
+  GeoLeoOrbitAdaptiveUpdateTestCase ();
+  virtual ~GeoLeoOrbitAdaptiveUpdateTestCase () {}
+
+private:
+  virtual void DoRun (void);
+  void CourseChange (Ptr<const MobilityModel> model);
+  void Check (Ptr<GeoLeoOrbitMobility> exact, Ptr<GeoLeoOrbitMobility> adaptive);
+
+  double m_tolerance;
+  uint32_t m_nCourseChanges;
+  Vector m_notified;
+};
+
+GeoLeoOrbitAdaptiveUpdateTestCase::GeoLeoOrbitAdaptiveUpdateTestCase ()
+  : TestCase ("Adaptive updates notify CourseChange once per tolerance travelled"),
+    m_tolerance (50000.0),
+    m_nCourseChanges (0)
+{
+}
+
+void
+GeoLeoOrbitAdaptiveUpdateTestCase::CourseChange (Ptr<const MobilityModel> model)
+{
+  Ptr<const GeocentricMobilityModel> geocentric = DynamicCast<const GeocentricMobilityModel> (model);
+  Vector position = geocentric->GetPosition (PositionType::GEOCENTRIC);
+  if (m_nCourseChanges > 0)
+    {
+      double moved = CalculateDistance (position, m_notified);
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (moved, m_tolerance,
+                                   "CourseChange notified before the tolerance at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_LT (moved, 2 * m_tolerance,
+                             "CourseChange notified too late at " << Simulator::Now ());
+    }
+  m_notified = position;
+  m_nCourseChanges ++;
+}
+
+void
+GeoLeoOrbitAdaptiveUpdateTestCase::Check (Ptr<GeoLeoOrbitMobility> exact, Ptr<GeoLeoOrbitMobility> adaptive)
+{
+  Vector expected = exact->GetPosition (PositionType::GEOCENTRIC);
+  Vector actual = adaptive->GetPosition (PositionType::GEOCENTRIC);
+  NS_TEST_EXPECT_MSG_LT (CalculateDistance (expected, actual), 1e-6,
+                         "Adaptive position differs from the on-demand one at " << Simulator::Now ());
+}
+
+void
+GeoLeoOrbitAdaptiveUpdateTestCase::DoRun (void)
+{
+  Ptr<GeoLeoOrbitMobility> exact = CreateObject<GeoLeoOrbitMobility> ();
+  exact->SetAttribute ("Precision", TimeValue (Time (0)));
+  exact->SetAttribute ("Altitude", DoubleValue (1000.0));
+  exact->SetAttribute ("Inclination", DoubleValue (50.0));
+
+  Ptr<GeoLeoOrbitMobility> adaptive = CreateObject<GeoLeoOrbitMobility> ();
+  adaptive->SetAttribute ("CourseChangeTolerance", DoubleValue (m_tolerance));
+  adaptive->SetAttribute ("Precision", TimeValue (Seconds (1)));
+  adaptive->SetAttribute ("Altitude", DoubleValue (1000.0));
+  adaptive->SetAttribute ("Inclination", DoubleValue (50.0));
+  adaptive->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&GeoLeoOrbitAdaptiveUpdateTestCase::CourseChange, this));
+
+  const double duration = 600;
+  for (double t = 0.5; t < duration; t += 7.3)
+    {
+      Simulator::Schedule (Seconds (t), &GeoLeoOrbitAdaptiveUpdateTestCase::Check, this, exact,
+                           adaptive);
+    }
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the satellite covers less than 10 km/s in the rotating frame
+  NS_TEST_EXPECT_MSG_GT (m_nCourseChanges, 0, "CourseChange never notified");
+  NS_TEST_EXPECT_MSG_LT (m_nCourseChanges, duration * 10000.0 / m_tolerance + 1,
+                         "More CourseChange notifications than the tolerance allows");
+}
+
 /**
  * \ingroup leo-test
  * \ingroup tests
@@ -86,6 +242,8 @@ LeoMobilityTestSuite::LeoMobilityTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new LeoMobilityWaypointTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new GeoSgp4InterpolationTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new GeoLeoOrbitAdaptiveUpdateTestCase, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
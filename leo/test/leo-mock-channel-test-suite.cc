@@ -233,6 +233,96 @@ private:
   }
 };
 
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class LeoMockChannelTransmitBelowThresholdTestCase : public TestCase
+{
+public:
+  LeoMockChannelTransmitBelowThresholdTestCase () : TestCase ("transmission below the receive threshold is filtered") {}
+  virtual ~LeoMockChannelTransmitBelowThresholdTestCase () {}
+private:
+  virtual void DoRun (void)
+  {
+    Ptr<LeoMockChannel> channel = CreateObject<LeoMockChannel> ();
+    channel->SetAttribute ("PropagationDelay", StringValue ("ns3::ConstantSpeedPropagationDelayModel"));
+    channel->SetAttribute ("PropagationLoss", StringValue ("ns3::LeoPropagationLossModel"));
+
+    Packet *packet = new Packet ();
+    Ptr<Packet> p = Ptr<Packet>(packet);
+
+    Ptr<Node> srcNode = CreateObject<Node> ();
+    Ptr<LeoMockNetDevice> srcDev = CreateObject<LeoMockNetDevice> ();
+    srcDev->SetNode (srcNode);
+    srcDev->SetDeviceType (LeoMockNetDevice::GND);
+    srcDev->SetAddress (Mac48Address::Allocate ());
+    int32_t srcId = channel->Attach (srcDev);
+
+    Ptr<Node> dstNode = CreateObject<Node> ();
+    Ptr<LeoMockNetDevice> dstDev = CreateObject<LeoMockNetDevice> ();
+    dstDev->SetNode (dstNode);
+    dstDev->SetDeviceType (LeoMockNetDevice::SAT);
+    dstDev->SetAddress (Mac48Address::Allocate ());
+    dstDev->SetRxThreshold (srcDev->GetTxPower () + 10.0);
+    channel->Attach (dstDev);
+
+    Address destAddr = dstDev->GetAddress ();
+    Time txTime;
+    bool result = channel->TransmitStart (p, srcId, destAddr, txTime);
+
+    NS_TEST_ASSERT_MSG_EQ (result, false, "reception below threshold has been scheduled");
+    NS_TEST_ASSERT_MSG_EQ (channel->GetNFilteredRx (), 1, "filtered reception not counted");
+  }
+};
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class LeoMockChannelResolveNeighborTestCase : public TestCase
+{
+public:
+  LeoMockChannelResolveNeighborTestCase () : TestCase ("neighbours are only resolved on the opposing site") {}
+  virtual ~LeoMockChannelResolveNeighborTestCase () {}
+private:
+  virtual void DoRun (void)
+  {
+    Ptr<LeoMockChannel> channel = CreateObject<LeoMockChannel> ();
+
+    Ptr<LeoMockNetDevice> gndDev = CreateObject<LeoMockNetDevice> ();
+    gndDev->SetNode (CreateObject<Node> ());
+    gndDev->SetDeviceType (LeoMockNetDevice::GND);
+    gndDev->SetAddress (Mac48Address::Allocate ());
+    channel->Attach (gndDev);
+
+    Ptr<LeoMockNetDevice> otherGndDev = CreateObject<LeoMockNetDevice> ();
+    otherGndDev->SetNode (CreateObject<Node> ());
+    otherGndDev->SetDeviceType (LeoMockNetDevice::GND);
+    otherGndDev->SetAddress (Mac48Address::Allocate ());
+    channel->Attach (otherGndDev);
+
+    Ptr<LeoMockNetDevice> satDev = CreateObject<LeoMockNetDevice> ();
+    satDev->SetNode (CreateObject<Node> ());
+    satDev->SetDeviceType (LeoMockNetDevice::SAT);
+    satDev->SetAddress (Mac48Address::Allocate ());
+    channel->Attach (satDev);
+
+    channel->AddNeighbor (Ipv4Address ("10.0.0.1"), gndDev);
+    channel->AddNeighbor (Ipv4Address ("10.0.0.2"), otherGndDev);
+    channel->AddNeighbor (Ipv4Address ("10.0.0.3"), satDev);
+
+    NS_TEST_ASSERT_MSG_EQ (channel->ResolveNeighbor (Ipv4Address ("10.0.0.3"), gndDev), satDev, "ground to space not resolved");
+    NS_TEST_ASSERT_MSG_EQ (channel->ResolveNeighbor (Ipv4Address ("10.0.0.1"), satDev), gndDev, "space to ground not resolved");
+    NS_TEST_ASSERT_MSG_EQ ((channel->ResolveNeighbor (Ipv4Address ("10.0.0.2"), gndDev) == nullptr), true, "ground to ground resolved");
+    NS_TEST_ASSERT_MSG_EQ ((channel->ResolveNeighbor (Ipv4Address ("10.0.0.4"), gndDev) == nullptr), true, "unknown address resolved");
+  }
+};
+
 /**
  * \ingroup leo-test
  * \ingroup tests
@@ -253,6 +343,8 @@ LeoMockChannelTestSuite::LeoMockChannelTestSuite ()
   AddTestCase (new LeoMockChannelTransmitSpaceGroundTestCase, TestCase::Duration::QUICK);
   AddTestCase (new LeoMockChannelTransmitSpaceSpaceTestCase, TestCase::Duration::QUICK);
   AddTestCase (new LeoMockChannelTransmitGroundGroundTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new LeoMockChannelTransmitBelowThresholdTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new LeoMockChannelResolveNeighborTestCase, TestCase::Duration::QUICK);
 }
 
 static LeoMockChannelTestSuite islMockChannelTestSuite;
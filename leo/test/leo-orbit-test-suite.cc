@@ -24,6 +24,8 @@
 #include "ns3/nstime.h"
 #include "ns3/geographic-positions.h"
 #include "ns3/geo-leo-orbit-mobility.h"
+#include "ns3/leo-orbit-node-helper.h"
+#include "ns3/leo-plane-partitioner.h"
 
 using namespace ns3;
 
@@ -219,6 +221,54 @@ void LeoOrbitTracingTestCase::CourseChange (std::string context, Ptr<const Mobil
       << ", z=" << pos.z << std::endl;
   }
 
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class LeoPlanePartitionerTestCase : public TestCase
+{
+public:
+  LeoPlanePartitionerTestCase () : TestCase ("planes are assigned to ranks in blocks") {}
+  virtual ~LeoPlanePartitionerTestCase () {}
+private:
+  virtual void DoRun (void)
+  {
+    LeoPlanePartitioner partitioner;
+    partitioner.SetNSystems (4);
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetSystemId (0, 72), 0, "first plane not on the first rank");
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetSystemId (17, 72), 0, "unbalanced block");
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetSystemId (18, 72), 1, "unbalanced block");
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetSystemId (71, 72), 3, "last plane not on the last rank");
+
+    LeoOrbitNodeHelper orbit;
+    partitioner.SetNSystems (2);
+    orbit.SetPartitioner (partitioner);
+    NodeContainer satellites = orbit.Install (LeoOrbit (550, 53, 4, 3));
+    for (uint32_t i = 0; i < satellites.GetN (); i ++)
+      {
+        NS_TEST_ASSERT_MSG_EQ (satellites.Get (i)->GetSystemId (), i / 6, "satellite on the wrong rank");
+      }
+
+    // 72 planes at 53 degrees cross about 363 km apart, closer than the ground
+    double radius = GeographicPositions::EARTH_SPHERE_RADIUS + 550e3;
+    double cosAngle = std::pow (std::cos (53 * M_PI / 180), 2) * std::cos (5 * M_PI / 180) + std::pow (std::sin (53 * M_PI / 180), 2);
+    double isl = 2 * radius * std::sin (std::acos (cosAngle) / 2);
+    NS_TEST_ASSERT_MSG_LT (isl, 550e3, "ISLs not shorter than the ground links");
+    std::vector<LeoOrbit> starlink = { LeoOrbit (550, 53, 72, 22) };
+    NS_TEST_ASSERT_MSG_EQ_TOL (LeoPlanePartitioner::GetLookAhead (starlink).GetSeconds (), isl / 299792458.0, 1e-9, "lookahead not bound by the ISLs");
+    NS_TEST_ASSERT_MSG_EQ_TOL (LeoPlanePartitioner::GetLookAhead (starlink).GetSeconds (), 1.2121e-3, 1e-6, "unexpected ISL lookahead");
+
+    // near-polar planes cross close to the poles
+    std::vector<LeoOrbit> oneweb = { LeoOrbit (1200, 87.9, 18, 40) };
+    Time lookAhead = LeoPlanePartitioner::GetLookAhead (oneweb);
+    NS_TEST_ASSERT_MSG_GT (lookAhead, Seconds (0), "no lookahead");
+    NS_TEST_ASSERT_MSG_LT (lookAhead.GetSeconds (), 1200e3 / 299792458.0, "lookahead not bound by the ISLs");
+
+    Simulator::Destroy ();
+  }
+};
 
 /**
  * \ingroup leo-test
@@ -236,6 +286,7 @@ public:
       AddTestCase (new LeoOrbitLatitudeTestCase, TestCase::Duration::QUICK);
       AddTestCase (new LeoOrbitOffsetTestCase, TestCase::Duration::QUICK);
       AddTestCase (new LeoOrbitTracingTestCase, TestCase::Duration::EXTENSIVE);
+      AddTestCase (new LeoPlanePartitionerTestCase, TestCase::Duration::QUICK);
   }
 };
 
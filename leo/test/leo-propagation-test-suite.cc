@@ -139,6 +139,61 @@ private:
   }
 };
 
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Unit tests
+ */
+class LeoPropagationBatchTestCase : public TestCase
+{
+public:
+  LeoPropagationBatchTestCase () : TestCase ("batch reachability agrees with the rx power") {}
+  virtual ~LeoPropagationBatchTestCase () {}
+private:
+  virtual void DoRun (void)
+  {
+    Ptr<LeoPropagationLossModel> leo = CreateObject<LeoPropagationLossModel> ();
+    leo->SetAttribute ("ElevationAngle", DoubleValue (25.0));
+    Ptr<IslPropagationLossModel> isl = CreateObject<IslPropagationLossModel> ();
+
+    // a satellite above the equator and receivers on the ground and in space
+    // all around it
+    Ptr<ConstantPositionMobilityModel> tx = CreateObject<ConstantPositionMobilityModel> ();
+    tx->SetPosition (Vector3D (6.921e6, 0, 0));
+    std::vector<Ptr<ConstantPositionMobilityModel> > rx;
+    std::vector<double> x, y, z;
+    for (double radius : { 6.37101e6, 6.921e6, 7.5e6 })
+      {
+        for (double angle = 0; angle < 360; angle += 2.5)
+          {
+            double rad = angle * M_PI / 180.0;
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel> ();
+            mob->SetPosition (Vector3D (radius * cos (rad), radius * sin (rad) * 0.6, radius * sin (rad) * 0.8));
+            rx.push_back (mob);
+            x.push_back (mob->GetPosition ().x);
+            y.push_back (mob->GetPosition ().y);
+            z.push_back (mob->GetPosition ().z);
+          }
+      }
+
+    std::vector<uint8_t> leoReachable (rx.size ());
+    std::vector<uint8_t> islReachable (rx.size ());
+    leo->GetReachable (tx->GetPosition (), x.data (), y.data (), z.data (), rx.size (), leoReachable.data ());
+    isl->GetReachable (tx->GetPosition (), x.data (), y.data (), z.data (), rx.size (), islReachable.data ());
+
+    uint32_t reachable = 0;
+    for (std::size_t i = 0; i < rx.size (); i ++)
+      {
+        NS_TEST_ASSERT_MSG_EQ ((bool) leoReachable[i], leo->CalcRxPower (0.0, tx, rx[i]) > -900.0, "batch and scalar cutoff disagree for receiver " << i);
+        NS_TEST_ASSERT_MSG_EQ ((bool) islReachable[i], isl->CalcRxPower (0.0, tx, rx[i]) > -900.0, "batch and scalar line-of-sight disagree for receiver " << i);
+        reachable += leoReachable[i];
+      }
+    NS_TEST_ASSERT_MSG_GT (reachable, 0, "no receiver in reach");
+    NS_TEST_ASSERT_MSG_LT (reachable, rx.size (), "all receivers in reach");
+  }
+};
+
 /**
  * \ingroup leo-test
  * \ingroup tests
@@ -159,6 +214,7 @@ LeoPropagationTestSuite::LeoPropagationTestSuite ()
   AddTestCase (new LeoPropagationRxLosTestCase, TestCase::Duration::QUICK);
   AddTestCase (new LeoPropagationBadAngleTestCase, TestCase::Duration::QUICK);
   AddTestCase (new LeoPropagationLossTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new LeoPropagationBatchTestCase, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,302 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+
+#include "ns3/leo-module.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \brief Get the gateway of the route of a node towards a destination
+ * \param node the forwarding node
+ * \param destination the destination address
+ * \return the gateway, or the any address if there is no route
+ */
+static Ipv4Address
+GetGateway (Ptr<Node> node, Ipv4Address destination)
+{
+  Ipv4Header header;
+  header.SetDestination (destination);
+  Socket::SocketErrno err;
+  Ptr<Ipv4Route> route = node->GetObject<Ipv4> ()->GetRoutingProtocol ()->RouteOutput (Create<Packet> (), header, nullptr, err);
+  if (route == nullptr)
+    {
+      return Ipv4Address::GetAny ();
+    }
+  return route->GetGateway ();
+}
+
+/**
+ * \brief Install a ring of satellites routed with snapshots
+ *
+ * The satellites lie on a circle, at the given angles, and move away from
+ * its center so that the length of every link grows by the same fraction
+ * each second. Links are installed as 0-1, 1-2, ..., n-0.
+ *
+ * \param satellites the satellites, one per angle
+ * \param routing the routing helper
+ * \param angles the angles of the satellites, in degrees
+ * \param expansion the relative growth of the links per second
+ * \return the interfaces of the links, two per link
+ */
+static Ipv4InterfaceContainer
+InstallRing (NodeContainer &satellites, LeoSnapshotRoutingHelper &routing, const std::vector<double> &angles, double expansion)
+{
+  // high enough for all links to clear the Earth
+  const double radius = 2e7;
+
+  satellites.Create (angles.size ());
+  for (uint32_t i = 0; i < satellites.GetN (); i ++)
+    {
+      Ptr<ConstantVelocityMobilityModel> mob = CreateObject<ConstantVelocityMobilityModel> ();
+      double rad = angles[i] * M_PI / 180.0;
+      Vector position (radius * std::cos (rad), radius * std::sin (rad), 0);
+      mob->SetPosition (position);
+      mob->SetVelocity (Vector (expansion * position.x, expansion * position.y, 0));
+      satellites.Get (i)->AggregateObject (mob);
+    }
+
+  IslHelper islCh;
+  NetDeviceContainer islNet = islCh.InstallGrid (satellites, 1, angles.size ());
+
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (routing);
+  stack.Install (satellites);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  return address.Assign (islNet);
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Routes over a ring of satellites with fixed positions
+ */
+class LeoSnapshotRoutingRingTestCase : public TestCase
+{
+public:
+  LeoSnapshotRoutingRingTestCase ();
+  virtual ~LeoSnapshotRoutingRingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LeoSnapshotRoutingRingTestCase::LeoSnapshotRoutingRingTestCase ()
+  : TestCase ("Follow the shortest ISL path of the current snapshot")
+{
+}
+
+LeoSnapshotRoutingRingTestCase::~LeoSnapshotRoutingRingTestCase ()
+{
+}
+
+void
+LeoSnapshotRoutingRingTestCase::DoRun (void)
+{
+  // the ring is shorter through the satellite at 60 degrees than through the
+  // one at 270 degrees
+  NodeContainer satellites;
+  LeoSnapshotRoutingHelper routing;
+  Ipv4InterfaceContainer interfaces = InstallRing (satellites, routing, { 0, 60, 180, 270 }, 0);
+
+  Ipv4Address sat1 = interfaces.GetAddress (1);
+  Ipv4Address sat2 = interfaces.GetAddress (3);
+  Ipv4Address sat3 = interfaces.GetAddress (6);
+
+  NS_TEST_ASSERT_MSG_EQ (GetGateway (satellites.Get (0), sat2), sat1, "route not along the shortest path");
+  NS_TEST_ASSERT_MSG_EQ (GetGateway (satellites.Get (0), sat1), sat1, "route to a neighbour not direct");
+  NS_TEST_ASSERT_MSG_EQ (GetGateway (satellites.Get (0), sat3), sat3, "route to a neighbour not direct");
+  NS_TEST_ASSERT_MSG_EQ (GetGateway (satellites.Get (3), sat1), interfaces.GetAddress (7), "route not along the shortest path");
+  NS_TEST_ASSERT_MSG_EQ (routing.GetSnapshots ()->GetNComputations (), 1, "tables computed more than once in an epoch");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Tables written to File and read back by a later run
+ */
+class LeoSnapshotRoutingFileTestCase : public TestCase
+{
+public:
+  LeoSnapshotRoutingFileTestCase ();
+  virtual ~LeoSnapshotRoutingFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Route from the first to the third satellite of a ring
+   * \param angles the angles of the satellites, in degrees
+   * \param viaLast whether the shortest path goes through the last satellite
+   * \return the number of ISL table computations
+   */
+  uint32_t Run (const std::vector<double> &angles, bool viaLast);
+
+  std::string m_file; ///< Snapshot file
+};
+
+LeoSnapshotRoutingFileTestCase::LeoSnapshotRoutingFileTestCase ()
+  : TestCase ("Read back the snapshots of the same nodes from File")
+{
+}
+
+LeoSnapshotRoutingFileTestCase::~LeoSnapshotRoutingFileTestCase ()
+{
+}
+
+uint32_t
+LeoSnapshotRoutingFileTestCase::Run (const std::vector<double> &angles, bool viaLast)
+{
+  NodeContainer satellites;
+  LeoSnapshotRoutingHelper routing;
+  routing.SetAttribute ("File", StringValue (m_file));
+  Ipv4InterfaceContainer interfaces = InstallRing (satellites, routing, angles, 0);
+
+  Ipv4Address expected = viaLast ? interfaces.GetAddress (6) : interfaces.GetAddress (1);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (satellites.Get (0), interfaces.GetAddress (3)), expected, "route not along the shortest path");
+
+  uint32_t computations = routing.GetSnapshots ()->GetNComputations ();
+  // closes File
+  routing.GetSnapshots ()->Dispose ();
+  Simulator::Destroy ();
+  return computations;
+}
+
+void
+LeoSnapshotRoutingFileTestCase::DoRun (void)
+{
+  m_file = CreateTempDirFilename ("leo-snapshot-routing.bin");
+
+  NS_TEST_ASSERT_MSG_EQ (Run ({ 0, 60, 180, 270 }, false), 1, "tables not computed without a file");
+  NS_TEST_ASSERT_MSG_EQ (Run ({ 0, 60, 180, 270 }, false), 0, "tables of the same nodes not read back");
+  // moved satellites do not match the fingerprint of the file
+  NS_TEST_ASSERT_MSG_EQ (Run ({ 0, 90, 180, 300 }, true), 1, "tables of other orbits read back");
+  NS_TEST_ASSERT_MSG_EQ (Run ({ 0, 90, 180, 300 }, true), 0, "rebuilt tables not read back");
+
+  std::remove (m_file.c_str ());
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief ISL tables kept while the links drift within RecomputeTolerance
+ */
+class LeoSnapshotRoutingToleranceTestCase : public TestCase
+{
+public:
+  LeoSnapshotRoutingToleranceTestCase ();
+  virtual ~LeoSnapshotRoutingToleranceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Route over an expanding ring for some epochs
+   * \param tolerance the RecomputeTolerance
+   * \return the number of ISL table computations
+   */
+  uint32_t Run (double tolerance);
+
+  /// Check the route from the first to the third satellite
+  void CheckRoute (void);
+
+  NodeContainer m_satellites;           ///< Satellites of the ring
+  Ipv4InterfaceContainer m_interfaces;  ///< Interfaces of the links
+};
+
+LeoSnapshotRoutingToleranceTestCase::LeoSnapshotRoutingToleranceTestCase ()
+  : TestCase ("Keep the ISL tables while the links drift within RecomputeTolerance")
+{
+}
+
+LeoSnapshotRoutingToleranceTestCase::~LeoSnapshotRoutingToleranceTestCase ()
+{
+}
+
+void
+LeoSnapshotRoutingToleranceTestCase::CheckRoute (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (m_satellites.Get (0), m_interfaces.GetAddress (3)), m_interfaces.GetAddress (1), "route not along the shortest path");
+}
+
+uint32_t
+LeoSnapshotRoutingToleranceTestCase::Run (double tolerance)
+{
+  m_satellites = NodeContainer ();
+  LeoSnapshotRoutingHelper routing;
+  routing.SetAttribute ("Epoch", TimeValue (Seconds (1)));
+  routing.SetAttribute ("RecomputeTolerance", DoubleValue (tolerance));
+  // links grow by 0.1% per second, 0.5% over the epochs below
+  m_interfaces = InstallRing (m_satellites, routing, { 0, 60, 180, 270 }, 1e-3);
+
+  for (uint32_t epoch = 0; epoch < 6; epoch ++)
+    {
+      Simulator::Schedule (MilliSeconds (500 + 1000 * epoch), &LeoSnapshotRoutingToleranceTestCase::CheckRoute, this);
+    }
+  Simulator::Stop (Seconds (6));
+  Simulator::Run ();
+
+  uint32_t computations = routing.GetSnapshots ()->GetNComputations ();
+  m_satellites = NodeContainer ();
+  m_interfaces = Ipv4InterfaceContainer ();
+  Simulator::Destroy ();
+  return computations;
+}
+
+void
+LeoSnapshotRoutingToleranceTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (Run (0.01), 1, "tables recomputed within the tolerance");
+  NS_TEST_ASSERT_MSG_EQ (Run (0), 6, "tables not recomputed at every epoch");
+}
+
+/**
+ * \ingroup leo-test
+ * \ingroup tests
+ *
+ * \brief Snapshot routing tests
+ */
+class LeoSnapshotRoutingTestSuite : public TestSuite
+{
+public:
+  LeoSnapshotRoutingTestSuite ();
+};
+
+LeoSnapshotRoutingTestSuite::LeoSnapshotRoutingTestSuite ()
+  : TestSuite ("leo-snapshot-routing", TestSuite::Type::UNIT)
+{
+  AddTestCase (new LeoSnapshotRoutingRingTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new LeoSnapshotRoutingFileTestCase, TestCase::Duration::QUICK);
+  AddTestCase (new LeoSnapshotRoutingToleranceTestCase, TestCase::Duration::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static LeoSnapshotRoutingTestSuite leoSnapshotRoutingTestSuite;
@@ -89,13 +89,44 @@ MacLayerConfigurationHelper::GetConfiguration(const rapidyyjson::Value& jsonMacL
         NS_ASSERT_MSG(jsonMacLayer["ueAntennaNoiseFigure"].IsNumber(),
                       "MAC Layer 'ueAntennaNoiseFigure' property must be a number.");
 
+        std::optional<NullNtnDemoMacLayerConfiguration::Sweep> sweep;
+        if (jsonMacLayer.HasMember("sweep"))
+        {
+            const auto& jsonSweep = jsonMacLayer["sweep"];
+            NS_ASSERT_MSG(jsonSweep.IsObject(), "MAC Layer 'sweep' property must be an object.");
+
+            auto parseValues = [&jsonSweep](const char* name) {
+                std::vector<double> values;
+                if (!jsonSweep.HasMember(name))
+                {
+                    return values;
+                }
+                NS_ASSERT_MSG(jsonSweep[name].IsArray(),
+                              "MAC Layer 'sweep." << name << "' property must be an array.");
+                for (const auto& value : jsonSweep[name].GetArray())
+                {
+                    NS_ASSERT_MSG(value.IsNumber(),
+                                  "MAC Layer 'sweep." << name
+                                                      << "' property must contain numbers.");
+                    values.push_back(value.GetDouble());
+                }
+                return values;
+            };
+
+            sweep = {.frequencies = parseValues("frequencies"),
+                     .bandwidths = parseValues("bandwidths"),
+                     .satEirpDensities = parseValues("satEirpDensities"),
+                     .ueAntennaNoiseFigures = parseValues("ueAntennaNoiseFigures")};
+        }
+
         macConfig = Create<NullNtnDemoMacLayerConfiguration>(
             macType,
             jsonMacLayer["timeResolution"].GetDouble(),
             jsonMacLayer["bandwidth"].GetDouble(),
             jsonMacLayer["rbBandwidth"].GetDouble(),
             jsonMacLayer["satEirpDensity"].GetDouble(),
-            jsonMacLayer["ueAntennaNoiseFigure"].GetDouble());
+            jsonMacLayer["ueAntennaNoiseFigure"].GetDouble(),
+            sweep);
     }
     else
     {
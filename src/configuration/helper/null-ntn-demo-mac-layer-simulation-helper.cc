@@ -22,6 +22,7 @@
 
 #include "scenario-configuration-helper.h"
 
+#include <ns3/abort.h>
 #include <ns3/circular-aperture-antenna-model.h>
 #include <ns3/geocentric-mobility-model.h>
 #include <ns3/log.h>
@@ -49,7 +50,7 @@ NullNtnDemoMacLayerSimulationHelper::NullNtnDemoMacLayerSimulationHelper(
 }
 
 void
-NullNtnDemoMacLayerSimulationHelper::Setup(const double simDuration) const
+NullNtnDemoMacLayerSimulationHelper::Setup(const double simDuration)
 {
     NS_LOG_FUNCTION(this);
 
@@ -93,25 +94,117 @@ NullNtnDemoMacLayerSimulationHelper::Setup(const double simDuration) const
     DoBeamforming(rxDev, rxAntenna, txDev);
     DoBeamforming(txDev, txAntenna, rxDev);
 
-    for (unsigned int i = 0;
-         i < (decltype(i))floor(simDuration / m_configuration->GetTimeResolution());
-         ++i)
+    // the PSDs depend only on the configuration, build them once for all the samples
+    m_txPsd = CreateTxPowerSpectralDensity(frequency, txPow, bandwidth, rbBandwidth);
+    m_noisePsd =
+        CreateNoisePowerSpectralDensity(frequency, ueAntennaNoiseFigure, bandwidth, rbBandwidth);
+    m_noisePowerSum = Sum(*m_noisePsd);
+    NS_LOG_DEBUG("Average tx power " << 10 * log10(Sum(*m_txPsd) * rbBandwidth) << " dB");
+    NS_LOG_DEBUG("Average noise power " << 10 * log10(m_noisePowerSum * rbBandwidth) << " dB");
+
+    ComputeSnrParams params(txMob,
+                            rxMob,
+                            txPow,
+                            ueAntennaNoiseFigure,
+                            txAntenna,
+                            rxAntenna,
+                            frequency,
+                            bandwidth,
+                            rbBandwidth);
+    const auto& sweep = m_configuration->GetSweep();
+
+    // keep the trace open for the whole run, with a buffer large enough to batch many samples
+    std::ostringstream snrFilePath;
+    snrFilePath << CONFIGURATOR->GetResultsPath()
+                << (sweep ? "ntn-snr-sweep.txt" : "ntn-snr-trace.txt");
+    m_snrTraceBuffer.resize(1 << 20);
+    m_snrTrace.rdbuf()->pubsetbuf(m_snrTraceBuffer.data(), m_snrTraceBuffer.size());
+    m_snrTrace.open(snrFilePath.str(), std::ios::out | std::ios::app);
+    NS_ABORT_MSG_IF(!m_snrTrace.is_open(), "Can't open file " << snrFilePath.str());
+    Simulator::ScheduleDestroy(&NullNtnDemoMacLayerSimulationHelper::CloseSnrTrace, this);
+
+    const uint64_t numSamples = floor(simDuration / m_configuration->GetTimeResolution());
+    if (sweep)
     {
-        Simulator::Schedule(Seconds(m_configuration->GetTimeResolution() * i),
-                            &NullNtnDemoMacLayerSimulationHelper::ComputeSnr,
-                            this,
-                            ComputeSnrParams(txMob,
-                                             rxMob,
-                                             txPow,
-                                             ueAntennaNoiseFigure,
-                                             txAntenna,
-                                             rxAntenna,
-                                             frequency,
-                                             bandwidth,
-                                             rbBandwidth));
+        SetupSweep(params, txGainDb);
+        if (numSamples > 0)
+        {
+            Simulator::ScheduleNow(&NullNtnDemoMacLayerSimulationHelper::ComputeSweep,
+                                   this,
+                                   params,
+                                   numSamples);
+        }
+    }
+    else if (numSamples > 0)
+    {
+        Simulator::ScheduleNow(&NullNtnDemoMacLayerSimulationHelper::ComputeSnr,
+                               this,
+                               params,
+                               numSamples);
     }
 }
 
+void
+NullNtnDemoMacLayerSimulationHelper::SetupSweep(const ComputeSnrParams& params, double txGainDb)
+{
+    NS_LOG_FUNCTION(this);
+
+    const auto& sweep = *m_configuration->GetSweep();
+    auto valuesOrDefault = [](const std::vector<double>& values, double defaultValue) {
+        return values.empty() ? std::vector<double>{defaultValue} : values;
+    };
+    m_sweepFrequencies = valuesOrDefault(sweep.frequencies, params.frequency);
+    const auto bandwidths = valuesOrDefault(sweep.bandwidths, params.bandwidth);
+    const auto satEirpDensities =
+        valuesOrDefault(sweep.satEirpDensities, m_configuration->GetSatEirpDensity());
+    const auto noiseFigures = valuesOrDefault(sweep.ueAntennaNoiseFigures, params.noiseFigure);
+
+    // columns: time, distances, propagation gain per frequency and then SNR per combination
+    m_snrTrace << "# time geocentricDistance projectedDistance";
+    for (auto frequency : m_sweepFrequencies)
+    {
+        m_snrTrace << " gain[f=" << frequency << "]";
+    }
+
+    // the PSDs depend only on the configuration, build them once for all the samples
+    for (std::size_t f = 0; f < m_sweepFrequencies.size(); ++f)
+    {
+        for (auto bandwidth : bandwidths)
+        {
+            for (auto satEirpDensity : satEirpDensities)
+            {
+                const double txPow =
+                    (satEirpDensity + 10 * log10(bandwidth / 1e6) - txGainDb) + 30;
+                const double txPowerSum = Sum(*CreateTxPowerSpectralDensity(
+                    m_sweepFrequencies[f], txPow, bandwidth, params.resourceBlockBandwidth));
+
+                for (auto noiseFigure : noiseFigures)
+                {
+                    const double noisePowerSum = Sum(
+                        *CreateNoisePowerSpectralDensity(m_sweepFrequencies[f],
+                                                         noiseFigure,
+                                                         bandwidth,
+                                                         params.resourceBlockBandwidth));
+                    m_sweepPoints.push_back({f, txPowerSum, noisePowerSum});
+                    m_snrTrace << " snr[f=" << m_sweepFrequencies[f] << ",bw=" << bandwidth
+                               << ",eirp=" << satEirpDensity << ",nf=" << noiseFigure << "]";
+                }
+            }
+        }
+    }
+    m_snrTrace << "\n";
+
+    m_sweepGainsDb.resize(m_sweepFrequencies.size());
+    NS_LOG_INFO("Link budget sweep of " << m_sweepPoints.size() << " combinations");
+}
+
+void
+NullNtnDemoMacLayerSimulationHelper::CloseSnrTrace()
+{
+    NS_LOG_FUNCTION(this);
+    m_snrTrace.close();
+}
+
 NullNtnDemoMacLayerSimulationHelper::ComputeSnrParams::ComputeSnrParams(
     Ptr<MobilityModel> pTxMob,
     Ptr<MobilityModel> pRxMob,
@@ -282,25 +375,22 @@ NullNtnDemoMacLayerSimulationHelper::DoBeamforming(Ptr<NetDevice> thisDevice,
  * Compute the average SNR
  * \param params A structure that holds the parameters that are needed to perform calculations in
  * ComputeSnr
+ * \param remainingSamples The number of samples left, including the current one
  */
 void
-NullNtnDemoMacLayerSimulationHelper::ComputeSnr(ComputeSnrParams& params) const
+NullNtnDemoMacLayerSimulationHelper::ComputeSnr(const ComputeSnrParams& params,
+                                                uint64_t remainingSamples)
 {
-    Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity(params.frequency,
-                                                            params.txPow,
-                                                            params.bandwidth,
-                                                            params.resourceBlockBandwidth);
-    Ptr<SpectrumValue> rxPsd = txPsd->Copy();
-    NS_LOG_DEBUG("Average tx power " << 10 * log10(Sum(*txPsd) * params.resourceBlockBandwidth)
-                                     << " dB");
-
-    // create the noise PSD
-    Ptr<SpectrumValue> noisePsd = CreateNoisePowerSpectralDensity(params.frequency,
-                                                                  params.noiseFigure,
-                                                                  params.bandwidth,
-                                                                  params.resourceBlockBandwidth);
-    NS_LOG_DEBUG("Average noise power "
-                 << 10 * log10(Sum(*noisePsd) * params.resourceBlockBandwidth) << " dB");
+    if (remainingSamples > 1)
+    {
+        Simulator::Schedule(Seconds(m_configuration->GetTimeResolution()),
+                            &NullNtnDemoMacLayerSimulationHelper::ComputeSnr,
+                            this,
+                            params,
+                            remainingSamples - 1);
+    }
+
+    Ptr<SpectrumValue> rxPsd = m_txPsd->Copy();
 
     // apply the pathloss
     double propagationGainDb =
@@ -327,8 +417,58 @@ NullNtnDemoMacLayerSimulationHelper::ComputeSnr(ComputeSnrParams& params) const
     NS_LOG_DEBUG("Average rx power " << 10 * log10(Sum(*rxSsp->psd) * params.bandwidth) << " dB");
 
     // compute the SNR
-    NS_LOG_DEBUG("Average SNR " << 10 * log10(Sum(*rxSsp->psd) / Sum(*noisePsd)) << " dB");
+    NS_LOG_DEBUG("Average SNR " << 10 * log10(Sum(*rxSsp->psd) / m_noisePowerSum) << " dB");
+
+    const auto [geocentricDistance, projectedDistance] = GetDistances(params);
+
+    // print the SNR and pathloss values in the ntn-snr-trace.txt file
+    m_snrTrace << Simulator::Now().GetSeconds() << " "
+               << 10 * log10(Sum(*rxPsd) / m_noisePowerSum) << " "
+               << propagationGainDb << " " << geocentricDistance << " " << projectedDistance
+               << "\n";
+}
 
+void
+NullNtnDemoMacLayerSimulationHelper::ComputeSweep(const ComputeSnrParams& params,
+                                                  uint64_t remainingSamples)
+{
+    if (remainingSamples > 1)
+    {
+        Simulator::Schedule(Seconds(m_configuration->GetTimeResolution()),
+                            &NullNtnDemoMacLayerSimulationHelper::ComputeSweep,
+                            this,
+                            params,
+                            remainingSamples - 1);
+    }
+
+    // the channel condition and the shadowing are cached per link, hence evaluating the same
+    // positions at another frequency reuses their realizations
+    auto propagationLossModel = m_phyHelper->GetPropagationLossModel();
+    for (std::size_t f = 0; f < m_sweepFrequencies.size(); ++f)
+    {
+        propagationLossModel->SetFrequency(m_sweepFrequencies[f]);
+        m_sweepGainsDb[f] = propagationLossModel->CalcRxPower(0, params.txMob, params.rxMob);
+    }
+    propagationLossModel->SetFrequency(params.frequency);
+
+    const auto [geocentricDistance, projectedDistance] = GetDistances(params);
+    m_snrTrace << Simulator::Now().GetSeconds() << " " << geocentricDistance << " "
+               << projectedDistance;
+    for (auto gainDb : m_sweepGainsDb)
+    {
+        m_snrTrace << " " << gainDb;
+    }
+    for (const auto& point : m_sweepPoints)
+    {
+        const double gainLinear = std::pow(10.0, m_sweepGainsDb[point.frequencyIdx] / 10.0);
+        m_snrTrace << " " << 10 * log10(point.txPowerSum * gainLinear / point.noisePowerSum);
+    }
+    m_snrTrace << "\n";
+}
+
+std::pair<double, double>
+NullNtnDemoMacLayerSimulationHelper::GetDistances(const ComputeSnrParams& params)
+{
     auto txMobPtr = DynamicCast<GeocentricMobilityModel, MobilityModel>(params.txMob);
     auto rxMobPtr = DynamicCast<GeocentricMobilityModel, MobilityModel>(params.rxMob);
 
@@ -353,14 +493,7 @@ NullNtnDemoMacLayerSimulationHelper::ComputeSnr(ComputeSnrParams& params) const
     auto rxMobProjected = getProjectedPositionFailsafe(rxMobPtr);
     double projectedDistance = CalculateDistance(txMobProjected, rxMobProjected);
 
-    // print the SNR and pathloss values in the ntn-snr-trace.txt file
-    std::ofstream f;
-    std::ostringstream snrFilePath;
-    snrFilePath << CONFIGURATOR->GetResultsPath() << "ntn-snr-trace.txt";
-    f.open(snrFilePath.str(), std::ios::out | std::ios::app);
-    f << Simulator::Now().GetSeconds() << " " << 10 * log10(Sum(*rxPsd) / Sum(*noisePsd)) << " "
-      << propagationGainDb << " " << geocentricDistance << " " << projectedDistance << std::endl;
-    f.close();
+    return {geocentricDistance, projectedDistance};
 }
 
 } // namespace ns3
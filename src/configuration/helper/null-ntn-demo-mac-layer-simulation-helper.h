@@ -27,6 +27,10 @@
 #include <ns3/phased-array-model.h>
 #include <ns3/spectrum-value.h>
 
+#include <fstream>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -79,15 +83,53 @@ class NullNtnDemoMacLayerSimulationHelper : public Object
     NullNtnDemoMacLayerSimulationHelper(Ptr<NullNtnDemoMacLayerConfiguration> configuration,
                                         Ptr<ThreeGppPhySimulationHelper> phyHelper);
 
-    void Setup(const double simDuration) const;
+    void Setup(const double simDuration);
 
   private:
     /**
-     * Compute the average SNR
+     * Compute the average SNR of the current sample and schedule the next one, so that a
+     * single event is pending at any time instead of one per sample of the whole run.
      * \param params A structure that holds the parameters that are needed to perform calculations
      * in ComputeSnr
+     * \param remainingSamples The number of samples left, including the current one
+     */
+    void ComputeSnr(const ComputeSnrParams& params, uint64_t remainingSamples);
+
+    /**
+     * Compute the pathloss and the SNR of every combination of the link budget sweep for the
+     * current sample, sharing geometry, channel condition and shadowing among them, and
+     * schedule the next sample.
+     * \param params A structure that holds the parameters of the link
+     * \param remainingSamples The number of samples left, including the current one
+     */
+    void ComputeSweep(const ComputeSnrParams& params, uint64_t remainingSamples);
+
+    /**
+     * Prepare the combinations of the link budget sweep and write the header of its trace.
+     * \param params A structure that holds the parameters of the configured link
+     * \param txGainDb The max gain of the tx antenna, in dB
+     */
+    void SetupSweep(const ComputeSnrParams& params, double txGainDb);
+
+    /**
+     * Compute the distances between the tx and the rx.
+     * \param params A structure that holds the parameters of the link
+     * \return The geocentric and the projected distances, in meters
      */
-    void ComputeSnr(ComputeSnrParams& params) const;
+    static std::pair<double, double> GetDistances(const ComputeSnrParams& params);
+
+    /**
+     * Flush and close the SNR trace at the end of the simulation.
+     */
+    void CloseSnrTrace();
+
+    /// A combination of the link budget sweep.
+    struct SweepPoint
+    {
+        std::size_t frequencyIdx; /// the index of the frequency in m_sweepFrequencies
+        double txPowerSum;        /// the sum of the tx PSD
+        double noisePowerSum;     /// the sum of the noise PSD
+    };
 
     static Ptr<SpectrumValue> CreateTxPowerSpectralDensity(double fc,
                                                            double pwr,
@@ -109,6 +151,16 @@ class NullNtnDemoMacLayerSimulationHelper : public Object
 
     Ptr<NullNtnDemoMacLayerConfiguration> m_configuration;
     Ptr<ThreeGppPhySimulationHelper> m_phyHelper;
+
+    Ptr<const SpectrumValue> m_txPsd;    /// the tx PSD, built once in Setup
+    Ptr<const SpectrumValue> m_noisePsd; /// the noise PSD, built once in Setup
+    double m_noisePowerSum{0};           /// the sum of the noise PSD
+    std::vector<char> m_snrTraceBuffer;  /// the buffer backing m_snrTrace
+    std::ofstream m_snrTrace;            /// ntn-snr-trace.txt, open for the whole run
+
+    std::vector<double> m_sweepFrequencies; /// the swept frequencies, in Hz
+    std::vector<SweepPoint> m_sweepPoints;  /// the combinations of the link budget sweep
+    std::vector<double> m_sweepGainsDb;     /// the propagation gain of each swept frequency
 };
 
 } // namespace ns3
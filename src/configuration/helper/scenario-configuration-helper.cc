@@ -27,21 +27,28 @@
 #include "ns3/fatal-error.h"
 #include "ns3/json-importer.h"
 #include "ns3/trace-expander.h"
+#include <ns3/building-index.h>
+#include <ns3/buildings-file-reader.h>
 #include <ns3/command-line.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
 #include <ns3/object-factory.h>
+#include <ns3/rng-seed-manager.h>
 #include <ns3/system-path.h>
 
 #include <chrono>
 #include <filesystem>
 #include <iomanip> /* put_time */
 #include <iostream>
+#include <map>
 #include <rapidyyjson/error/en.h>
 #include <rapidyyjson/filereadstream.h>
 #include <rapidyyjson/pointer.h>
 #include <rapidyyjson/prettywriter.h>
 #include <rapidyyjson/stringbuffer.h>
+#include <rapidyyjson/writer.h>
+#include <sys/wait.h>
+#include <thread>
 #include <unistd.h>
 
 namespace ns3
@@ -134,6 +141,11 @@ ScenarioConfigurationHelper::GetResultsPath()
         path << m_currentPath << "/" << resPathStr << "/" << GetName() << "-" << m_dateTime;
     }
 
+    if (!m_campaignRun.empty())
+    {
+        path << "/" << m_campaignRun;
+    }
+
     SystemPath::MakeDirectories(path.str());
 
     path << "/";
@@ -818,6 +830,8 @@ ScenarioConfigurationHelper::InitializeConfiguration(int argc, char** argv)
     std::string configFilePath = "";
     std::string expandOutputPath = "";
     bool doExpand = false;
+    std::string campaignFilePath = "";
+    uint32_t campaignJobs = 0;
     constexpr const ssize_t configFileBufferSize = 64 * 1024; // KiB
     char configFileBuffer[configFileBufferSize];
     m_generateRadioMaps = false; // no generation as default
@@ -829,6 +843,10 @@ ScenarioConfigurationHelper::InitializeConfiguration(int argc, char** argv)
     cmd.AddValue("output",
                  "Output file path for expanded JSON (optional, default stdout)",
                  expandOutputPath);
+    cmd.AddValue("campaign", "Sweep definition file path to run a campaign", campaignFilePath);
+    cmd.AddValue("jobs",
+                 "Number of campaign runs executed in parallel (optional, default #cores)",
+                 campaignJobs);
     cmd.Parse(argc, argv);
 
     if (configFilePath.empty())
@@ -854,6 +872,7 @@ ScenarioConfigurationHelper::InitializeConfiguration(int argc, char** argv)
 
     // Process !importJson commands
     std::string scenarioPath = std::filesystem::path(configFilePath).parent_path().string();
+    m_scenarioPath = scenarioPath;
     JsonImporter::Process(m_config, scenarioPath);
 
     // Expand trace definitions if present in any supported object array
@@ -933,6 +952,205 @@ ScenarioConfigurationHelper::InitializeConfiguration(int argc, char** argv)
         }
         exit(0);
     }
+
+    if (!campaignFilePath.empty())
+    {
+        RunCampaign(campaignFilePath, campaignJobs);
+    }
+}
+
+void
+ScenarioConfigurationHelper::RunCampaign(const std::string& campaignFilePath, uint32_t jobs)
+{
+    constexpr const ssize_t campaignFileBufferSize = 64 * 1024; // KiB
+    char campaignFileBuffer[campaignFileBufferSize];
+
+    std::FILE* campaignFilePtr = fopen(campaignFilePath.c_str(), "rb");
+    if (!campaignFilePtr)
+    {
+        NS_FATAL_ERROR("Cannot open " << campaignFilePath << ": " << std::strerror(errno));
+    }
+
+    rapidyyjson::Document campaign;
+    rapidyyjson::FileReadStream campaignFileStream(campaignFilePtr,
+                                                   campaignFileBuffer,
+                                                   campaignFileBufferSize);
+    campaign.ParseStream<rapidyyjson::kParseCommentsFlag>(campaignFileStream);
+    std::fclose(campaignFilePtr);
+
+    NS_ABORT_MSG_IF(campaign.HasParseError(),
+                    "The given campaign definition is not valid JSON: "
+                        << rapidyyjson::GetParseError_En(campaign.GetParseError()));
+    NS_ASSERT_MSG(campaign.IsObject(), "Campaign definition must be an object.");
+
+    std::vector<std::string> paths;
+    std::vector<std::vector<rapidyyjson::Value>> values;
+    if (campaign.HasMember("parameters"))
+    {
+        NS_ASSERT_MSG(campaign["parameters"].IsArray(),
+                      "Campaign 'parameters' property must be an array.");
+        for (auto& param : campaign["parameters"].GetArray())
+        {
+            NS_ASSERT_MSG(param.IsObject() && param.HasMember("path") && param["path"].IsString(),
+                          "Each campaign parameter must define a 'path' JSON pointer.");
+            NS_ASSERT_MSG(param.HasMember("values") && param["values"].IsArray() &&
+                              param["values"].Size() > 0,
+                          "Each campaign parameter must define a non-empty 'values' array.");
+
+            const std::string path = param["path"].GetString();
+            NS_ABORT_MSG_IF(rapidyyjson::Pointer(path.c_str()).Get(m_config) == nullptr,
+                            "Campaign parameter " << path << " does not exist in configuration.");
+
+            paths.push_back(path);
+            values.emplace_back();
+            for (auto& v : param["values"].GetArray())
+            {
+                values.back().emplace_back(v, m_config.GetAllocator());
+            }
+        }
+    }
+
+    std::vector<uint32_t> seeds;
+    if (campaign.HasMember("seeds"))
+    {
+        NS_ASSERT_MSG(campaign["seeds"].IsArray(), "Campaign 'seeds' property must be an array.");
+        for (auto& seed : campaign["seeds"].GetArray())
+        {
+            NS_ASSERT_MSG(seed.IsUint() && seed.GetUint() > 0,
+                          "Campaign seeds must be positive integers.");
+            seeds.push_back(seed.GetUint());
+        }
+    }
+    else
+    {
+        seeds.push_back(RngSeedManager::GetSeed());
+    }
+
+    if (jobs == 0 && campaign.HasMember("jobs"))
+    {
+        NS_ASSERT_MSG(campaign["jobs"].IsUint(), "Campaign 'jobs' property must be an integer.");
+        jobs = campaign["jobs"].GetUint();
+    }
+    if (jobs == 0)
+    {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    uint32_t nRuns = seeds.size();
+    for (const auto& v : values)
+    {
+        nRuns *= v.size();
+    }
+
+    // Results of every run are stored under the results path of the campaign, which also
+    // holds the index of the runs.
+    const std::string campaignPath = GetResultsPath();
+    std::ofstream index(campaignPath + "index.csv");
+    index << "run,seed";
+    for (const auto& path : paths)
+    {
+        index << "," << path;
+    }
+    index << ",resultsPath,exitStatus,wallTime" << std::endl;
+
+    std::cout << "Running campaign of " << nRuns << " scenarios with " << jobs
+              << " parallel jobs. Results in " << campaignPath << std::endl;
+
+    struct CampaignRun
+    {
+        uint32_t id;
+        std::vector<uint32_t> point;
+        uint32_t seed;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    std::map<pid_t, CampaignRun> running;
+    bool failed = false;
+
+    auto waitRun = [&]() {
+        int status;
+        const pid_t pid = wait(&status);
+        NS_ABORT_MSG_IF(pid < 0, "Cannot wait campaign runs: " << std::strerror(errno));
+
+        const auto& run = running.at(pid);
+        const auto wallTime =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - run.start);
+        const int exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        failed |= (exitStatus != 0);
+
+        index << run.id << "," << run.seed;
+        for (uint32_t p = 0; p < run.point.size(); p++)
+        {
+            rapidyyjson::StringBuffer buffer;
+            rapidyyjson::Writer<rapidyyjson::StringBuffer> writer(buffer);
+            values[p][run.point[p]].Accept(writer);
+
+            // Quote the JSON value as a CSV field
+            index << ",\"";
+            for (const char* c = buffer.GetString(); *c; c++)
+            {
+                index << ((*c == '"') ? "\"\"" : std::string(1, *c));
+            }
+            index << "\"";
+        }
+        index << "," << campaignPath << "run-" << run.id << "/," << exitStatus << ","
+              << wallTime.count() << std::endl;
+
+        std::cout << "Campaign run " << run.id << " completed with status " << exitStatus
+                  << std::endl;
+        running.erase(pid);
+    };
+
+    std::vector<uint32_t> point(paths.size(), 0);
+    for (uint32_t id = 0; id < nRuns; id++)
+    {
+        // Decode the run identifier into its sweep point, seeds varying fastest
+        uint32_t rem = id / seeds.size();
+        for (int p = paths.size() - 1; p >= 0; p--)
+        {
+            point[p] = rem % values[p].size();
+            rem /= values[p].size();
+        }
+        const uint32_t seed = seeds[id % seeds.size()];
+
+        if (running.size() >= jobs)
+        {
+            waitRun();
+        }
+
+        // Make sure buffered output is not duplicated in the child
+        std::cout.flush();
+        index.flush();
+
+        const pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "Cannot fork campaign run: " << std::strerror(errno));
+
+        if (pid == 0)
+        {
+            index.close();
+            for (uint32_t p = 0; p < paths.size(); p++)
+            {
+                *rapidyyjson::Pointer(paths[p].c_str()).Get(m_config) =
+                    rapidyyjson::Value(values[p][point[p]], m_config.GetAllocator());
+            }
+            RngSeedManager::SetSeed(seed);
+            m_campaignRun = "run-" + std::to_string(id);
+            return;
+        }
+
+        running[pid] = {.id = id,
+                        .point = point,
+                        .seed = seed,
+                        .start = std::chrono::steady_clock::now()};
+    }
+
+    while (!running.empty())
+    {
+        waitRun();
+    }
+
+    index.close();
+    exit(failed ? 1 : 0);
 }
 
 void
@@ -1149,15 +1367,29 @@ ScenarioConfigurationHelper::GetBuildings() const
     NS_ASSERT_MSG(m_config["world"].IsObject(),
                   "'world' defined in the JSON configuration must be an object.");
 
+    if (m_config["world"].HasMember("buildingsFile"))
+    {
+        NS_ASSERT_MSG(m_config["world"]["buildingsFile"].IsString(),
+                      "'buildingsFile' needs to be the path of a .csv or binary buildings file.");
+        std::filesystem::path buildingsFile = m_config["world"]["buildingsFile"].GetString();
+        if (buildingsFile.is_relative())
+        {
+            buildingsFile = std::filesystem::path(m_scenarioPath) / buildingsFile;
+        }
+        buildings = BuildingsFileReader::Read(buildingsFile.string());
+    }
+
     if (!m_config["world"].HasMember("buildings"))
     {
-        return {};
+        BuildingIndex::Build();
+        return buildings;
     }
 
     NS_ASSERT_MSG(m_config["world"]["buildings"].IsArray(),
                   "'buildings' needs to be an array of objects, check the configuration file.");
 
     auto arr = m_config["world"]["buildings"].GetArray();
+    buildings.reserve(buildings.size() + arr.Size());
     for (auto b = arr.Begin(); b != arr.End(); ++b)
     {
         Ptr<Building> building = CreateObject<Building>();
@@ -1238,6 +1470,7 @@ ScenarioConfigurationHelper::GetBuildings() const
         buildings.push_back(building);
     }
 
+    BuildingIndex::Build();
     return buildings;
 }
 
@@ -1492,6 +1725,11 @@ ScenarioConfigurationHelper::GetRadioMaps() const
                 mapConfig.logGeocentricRem = obj["logGeocentricREM"].GetBool();
             }
 
+            if (obj.HasMember("preview"))
+            {
+                mapConfig.preview = obj["preview"].GetBool();
+            }
+
             if (obj.HasMember("parameters"))
             {
                 NS_ASSERT_MSG(obj["parameters"].IsObject(), "'parameters' must be an object");
@@ -286,6 +286,7 @@ class ScenarioConfigurationHelper : public Singleton<ScenarioConfigurationHelper
         std::string coordinatesType = "cartesian";
         bool is3d = false;
         bool logGeocentricRem = false;
+        bool preview = true;
         uint32_t phyLayerIndex;
         uint32_t bwpId;
         std::vector<std::pair<std::string, std::string>> parameters;
@@ -342,6 +343,8 @@ class ScenarioConfigurationHelper : public Singleton<ScenarioConfigurationHelper
     const std::vector<std::pair<std::string, std::string>> GetIndividualSettings() const;
 
     /**
+     * \brief Create the buildings inlined in 'world.buildings' and the ones streamed from the
+     *        optional 'world.buildingsFile', then populate the BuildingIndex with them.
      * \return a vector of Ptr<Building> created with the attributes in config
      */
     const std::vector<Ptr<Building>> GetBuildings() const;
@@ -471,6 +474,20 @@ class ScenarioConfigurationHelper : public Singleton<ScenarioConfigurationHelper
      * \param argv the list of command line arguments
      */
     void InitializeConfiguration(int argc, char** argv);
+    /**
+     * \brief Run a campaign of scenarios sweeping the decoded configuration.
+     *
+     * The sweep definition lists JSON pointers into the configuration, each with the values
+     * to be explored, and optionally the RNG seeds. Every point of their Cartesian product is
+     * executed by a child process forked from the current one, hence sharing the already
+     * parsed and expanded configuration through copy-on-write memory. This method returns only
+     * in the children, after their configuration has been specialized. The parent waits for
+     * every run, writes the campaign index and exits.
+     *
+     * \param campaignFilePath the path of the JSON sweep definition.
+     * \param jobs the maximum number of runs executed in parallel, 0 for the number of cores.
+     */
+    void RunCampaign(const std::string& campaignFilePath, uint32_t jobs);
     /**
      * \brief part of the destructor, it releases any pointer bound to the command line and JSON
      * files.
@@ -500,6 +517,8 @@ class ScenarioConfigurationHelper : public Singleton<ScenarioConfigurationHelper
         m_staticConfig;               /// cache for ns-3 static config params
     bool m_generateRadioMaps = false; /// toggle for radio map generation
     std::string m_currentPath;        /// cache for the current path at initialization
+    std::string m_campaignRun;        /// results subdirectory of the current campaign run
+    std::string m_scenarioPath;       /// directory of the configuration file
 };
 
 } // namespace ns3
@@ -25,13 +25,15 @@ NullNtnDemoMacLayerConfiguration::NullNtnDemoMacLayerConfiguration(std::string m
                                                                    double bandwidth,
                                                                    double rbBandwidth,
                                                                    double satEirpDensity,
-                                                                   double ueAntennaNoiseFigure)
+                                                                   double ueAntennaNoiseFigure,
+                                                                   std::optional<Sweep> sweep)
     : MacLayerConfiguration(macType),
       m_timeResolution(timeResolution),
       m_bandwidth(bandwidth),
       m_rbBandwidth(rbBandwidth),
       m_satEirpDensity(satEirpDensity),
-      m_ueAntennaNoiseFigure(ueAntennaNoiseFigure)
+      m_ueAntennaNoiseFigure(ueAntennaNoiseFigure),
+      m_sweep(std::move(sweep))
 {
 }
 
@@ -65,4 +67,10 @@ NullNtnDemoMacLayerConfiguration::GetUeAntennaNoiseFigure() const
     return m_ueAntennaNoiseFigure;
 }
 
+const std::optional<NullNtnDemoMacLayerConfiguration::Sweep>&
+NullNtnDemoMacLayerConfiguration::GetSweep() const
+{
+    return m_sweep;
+}
+
 } // namespace ns3
@@ -37,18 +37,33 @@ namespace ns3
 class NullNtnDemoMacLayerConfiguration : public MacLayerConfiguration
 {
   public:
+    /**
+     * \brief Link budget parameters to be swept in a single run. Every combination of the
+     * values is evaluated at each time sample. An empty vector means that only the value
+     * configured for the scenario is used.
+     */
+    struct Sweep
+    {
+        std::vector<double> frequencies;           /// Carrier frequencies, in Hz
+        std::vector<double> bandwidths;            /// Bandwidths, in Hz
+        std::vector<double> satEirpDensities;      /// Satellite EIRP densities, in dBW/MHz
+        std::vector<double> ueAntennaNoiseFigures; /// UE antenna noise figures, in dB
+    };
+
     /**
      * Create a new object instance.
      *
      * \param macType The type of the MAC Layer to be configured. It should be "NullNtnDemo".
      * \param timeResolution Time resolution to evaluate NTN communications.
+     * \param sweep Optional link budget parameters to be swept instead of the single values.
      */
     NullNtnDemoMacLayerConfiguration(std::string macType,
                                      double timeResolution,
                                      double bandwidth,
                                      double rbBandwidth,
                                      double satEirpDensity,
-                                     double ueAntennaNoiseFigure);
+                                     double ueAntennaNoiseFigure,
+                                     std::optional<Sweep> sweep = std::nullopt);
     /// \return The configured time resolution.
     double GetTimeResolution() const;
     /// \return The configured bandwidth.
@@ -59,6 +74,8 @@ class NullNtnDemoMacLayerConfiguration : public MacLayerConfiguration
     double GetSatEirpDensity() const;
     /// \return The configured UE antenna noise figure.
     double GetUeAntennaNoiseFigure() const;
+    /// \return The link budget parameters to be swept, if any.
+    const std::optional<Sweep>& GetSweep() const;
 
   private:
     const double m_timeResolution;       /// Configured time resolution, in seconds
@@ -66,6 +83,7 @@ class NullNtnDemoMacLayerConfiguration : public MacLayerConfiguration
     const double m_rbBandwidth;          /// Configured RB bandwidth, in Hz
     const double m_satEirpDensity;       /// Configured satellite EIRP density, in dBW/MHz
     const double m_ueAntennaNoiseFigure; /// Configured UE antenna noise figure, in dB
+    const std::optional<Sweep> m_sweep;  /// Configured link budget sweep
 };
 
 } // namespace ns3
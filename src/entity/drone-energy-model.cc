@@ -17,6 +17,7 @@
  */
 #include "drone-energy-model.h"
 
+#include <ns3/drone-energy-source.h>
 #include <ns3/mobility-model.h>
 #include <ns3/simulator.h>
 
@@ -32,15 +33,26 @@ NS_OBJECT_ENSURE_REGISTERED(DroneEnergyModel);
 TypeId
 DroneEnergyModel::GetTypeId(void)
 {
-    static TypeId tid = TypeId("ns3::DroneEnergyModel")
-                            .SetParent<energy::DeviceEnergyModel>()
-                            .SetGroupName("Energy")
-                            .AddConstructor<DroneEnergyModel>();
+    static TypeId tid =
+        TypeId("ns3::DroneEnergyModel")
+            .SetParent<energy::DeviceEnergyModel>()
+            .SetGroupName("Energy")
+            .AddConstructor<DroneEnergyModel>()
+            .AddAttribute("PowerSegmentInterval",
+                          "Maximum duration of a piecewise-constant power segment. If zero, "
+                          "the power consumption is evaluated on every energy source update, "
+                          "unless the source is a DroneEnergySource, whose own "
+                          "PowerSegmentInterval is used instead.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&DroneEnergyModel::m_powerSegmentInterval),
+                          MakeTimeChecker(Seconds(0)));
     return tid;
 }
 
 DroneEnergyModel::DroneEnergyModel()
-    : m_source{0}
+    : m_source{0},
+      m_segmentPower{0},
+      m_updatingSegment{false}
 {
 }
 
@@ -49,6 +61,18 @@ DroneEnergyModel::SetEnergySource(Ptr<energy::EnergySource> source)
 {
     NS_LOG_FUNCTION(this << source);
     m_source = source;
+
+    // A DroneEnergySource never updates itself before the predicted depletion, hence the
+    // model has to publish its power segments.
+    Ptr<DroneEnergySource> droneSource = DynamicCast<DroneEnergySource>(source);
+    if (droneSource && !m_powerSegmentInterval.IsStrictlyPositive())
+        m_powerSegmentInterval = droneSource->GetPowerSegmentInterval();
+
+    // Peripherals are installed after the energy model, hence segments are started
+    // once the simulation is running.
+    if (m_powerSegmentInterval.IsStrictlyPositive() && !m_segmentEvent.IsPending())
+        m_segmentEvent =
+            Simulator::Schedule(TimeStep(1), &DroneEnergyModel::StartPowerSegments, this);
 }
 
 void
@@ -124,6 +148,9 @@ DroneEnergyModel::DoGetCurrentA(void) const
     if (Simulator::Now() <= Time())
         return 0;
 
+    if (m_powerSegmentInterval.IsStrictlyPositive())
+        return m_segmentPower / m_source->GetSupplyVoltage();
+
     double PowerConsumption = GetPower() + GetPeripheralsPowerConsumption();
     double VoltageV = m_source->GetSupplyVoltage();
     double CurrentA = (PowerConsumption / VoltageV);
@@ -135,4 +162,63 @@ DroneEnergyModel::DoGetCurrentA(void) const
     return CurrentA;
 }
 
+void
+DroneEnergyModel::StartPowerSegments(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    m_drone->GetObject<MobilityModel>()->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&DroneEnergyModel::CourseChangeCallback, this));
+
+    for (auto i = m_drone->GetPeripherals()->Begin(); i != m_drone->GetPeripherals()->End(); i++)
+    {
+        (*i)->TraceConnectWithoutContext(
+            "CurrentPowerConsumption",
+            MakeCallback(&DroneEnergyModel::PeripheralPowerCallback, this));
+    }
+
+    UpdatePowerSegment();
+}
+
+void
+DroneEnergyModel::UpdatePowerSegment(void)
+{
+    // Evaluating the mechanics updates lazy mobility models, which in turn may notify a
+    // course change while the segment is being computed.
+    if (m_updatingSegment)
+        return;
+
+    m_updatingSegment = true;
+    m_segmentEvent.Cancel();
+
+    const double power = GetPower() + GetPeripheralsPowerConsumption();
+    if (power != m_segmentPower)
+    {
+        NS_LOG_LOGIC("New power segment for Drone #" << GetDrone()->GetId() << ": " << power
+                                                     << " W");
+        // Close the ongoing segment with the previous draw, then let the source sample
+        // the new one.
+        m_source->UpdateEnergySource();
+        m_segmentPower = power;
+        m_source->UpdateEnergySource();
+    }
+
+    m_segmentEvent =
+        Simulator::Schedule(m_powerSegmentInterval, &DroneEnergyModel::UpdatePowerSegment, this);
+    m_updatingSegment = false;
+}
+
+void
+DroneEnergyModel::CourseChangeCallback(Ptr<const MobilityModel> mobility)
+{
+    UpdatePowerSegment();
+}
+
+void
+DroneEnergyModel::PeripheralPowerCallback(double oldValue, double newValue)
+{
+    UpdatePowerSegment();
+}
+
 } // namespace ns3
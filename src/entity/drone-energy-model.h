@@ -21,7 +21,9 @@
 #include "drone.h"
 
 #include <ns3/device-energy-model.h>
+#include <ns3/event-id.h>
 #include <ns3/li-ion-energy-source.h>
+#include <ns3/mobility-model.h>
 #include <ns3/simulator.h>
 
 namespace ns3
@@ -31,6 +33,11 @@ namespace ns3
  * \ingroup energy
  *
  * \brief Defines the power consumption of a drone together with its attached peripherals.
+ *
+ * If PowerSegmentInterval is positive, the power consumption is published to the energy
+ * source as piecewise-constant segments. A new segment starts on drone course changes,
+ * on peripheral power consumption changes and at least every PowerSegmentInterval, while
+ * in between the current draw is returned without evaluating the mechanics again.
  */
 class DroneEnergyModel : public energy::DeviceEnergyModel
 {
@@ -140,9 +147,38 @@ class DroneEnergyModel : public energy::DeviceEnergyModel
      */
     double DoGetCurrentA(void) const;
 
+    /**
+     * \brief Connects the segment updates to the drone mobility and peripherals.
+     */
+    void StartPowerSegments(void);
+
+    /**
+     * \brief Evaluates the power consumption and starts a new segment if it changed.
+     */
+    void UpdatePowerSegment(void);
+
+    /**
+     * \brief Starts a new segment when the drone changes its course.
+     *
+     * \param mobility Mobility model of the drone.
+     */
+    void CourseChangeCallback(Ptr<const MobilityModel> mobility);
+
+    /**
+     * \brief Starts a new segment when a peripheral changes its power consumption.
+     *
+     * \param oldValue Previous power consumption of the peripheral, in Watt.
+     * \param newValue Current power consumption of the peripheral, in Watt.
+     */
+    void PeripheralPowerCallback(double oldValue, double newValue);
+
     Ptr<energy::EnergySource> m_source;
     Ptr<Drone> m_drone;
     TracedValue<double> m_totalEnergyConsumption;
+    Time m_powerSegmentInterval; //!< Maximum duration of a power segment
+    double m_segmentPower;       //!< Power consumption of the ongoing segment, in Watt
+    bool m_updatingSegment;      //!< Guard against reentrant segment updates
+    EventId m_segmentEvent;      //!< Next scheduled segment update
 };
 
 } // namespace ns3
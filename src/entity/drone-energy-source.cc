@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "drone-energy-source.h"
+
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DroneEnergySource");
+
+NS_OBJECT_ENSURE_REGISTERED(DroneEnergySource);
+
+TypeId
+DroneEnergySource::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::DroneEnergySource")
+            .SetParent<energy::EnergySource>()
+            .SetGroupName("Energy")
+            .AddConstructor<DroneEnergySource>()
+            .AddAttribute("InitialEnergyJ",
+                          "Initial energy stored in the source, in Joule.",
+                          DoubleValue(10000.0),
+                          MakeDoubleAccessor(&DroneEnergySource::SetInitialEnergy,
+                                             &DroneEnergySource::GetInitialEnergy),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("SupplyVoltageV",
+                          "Supply voltage of the source, in Volt.",
+                          DoubleValue(3.7),
+                          MakeDoubleAccessor(&DroneEnergySource::m_supplyVoltageV),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("LowBatteryThreshold",
+                          "Fraction of the initial energy below which the device energy "
+                          "models are notified of the depletion.",
+                          DoubleValue(0.10),
+                          MakeDoubleAccessor(&DroneEnergySource::m_lowBatteryTh),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("PowerSegmentInterval",
+                          "Maximum duration of a piecewise-constant power segment of the "
+                          "device energy models that do not set their own. The source only "
+                          "updates itself at the predicted depletion, hence it must be positive.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&DroneEnergySource::m_powerSegmentInterval),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddTraceSource("RemainingEnergy",
+                            "Remaining energy at DroneEnergySource.",
+                            MakeTraceSourceAccessor(&DroneEnergySource::m_remainingEnergyJ),
+                            "ns3::TracedValueCallback::Double");
+    return tid;
+}
+
+DroneEnergySource::DroneEnergySource()
+    : m_initialEnergyJ{0},
+      m_supplyVoltageV{0},
+      m_lowBatteryTh{0},
+      m_totalCurrentA{0},
+      m_depleted{false},
+      m_lastUpdateTime{Seconds(0)},
+      m_remainingEnergyJ{0}
+{
+}
+
+void
+DroneEnergySource::SetInitialEnergy(double initialEnergyJ)
+{
+    NS_LOG_FUNCTION(this << initialEnergyJ);
+    m_initialEnergyJ = initialEnergyJ;
+    m_remainingEnergyJ = initialEnergyJ;
+}
+
+void
+DroneEnergySource::DoInitialize(void)
+{
+    NS_LOG_FUNCTION(this);
+    m_lastUpdateTime = Simulator::Now();
+    UpdateEnergySource();
+    energy::EnergySource::DoInitialize();
+}
+
+void
+DroneEnergySource::DoDispose(void)
+{
+    NS_LOG_FUNCTION(this);
+    m_depletionEvent.Cancel();
+    BreakDeviceEnergyModelRefCycle();
+    energy::EnergySource::DoDispose();
+}
+
+double
+DroneEnergySource::GetInitialEnergy(void) const
+{
+    return m_initialEnergyJ;
+}
+
+double
+DroneEnergySource::GetSupplyVoltage(void) const
+{
+    return m_supplyVoltageV;
+}
+
+Time
+DroneEnergySource::GetPowerSegmentInterval(void) const
+{
+    return m_powerSegmentInterval;
+}
+
+double
+DroneEnergySource::GetRemainingEnergy(void)
+{
+    CalculateRemainingEnergy();
+    return m_remainingEnergyJ;
+}
+
+double
+DroneEnergySource::GetEnergyFraction(void)
+{
+    if (m_initialEnergyJ <= 0)
+        return 0;
+
+    return GetRemainingEnergy() / m_initialEnergyJ;
+}
+
+void
+DroneEnergySource::UpdateEnergySource(void)
+{
+    NS_LOG_FUNCTION(this);
+    if (Simulator::IsFinished())
+        return;
+
+    m_depletionEvent.Cancel();
+    CalculateRemainingEnergy();
+    m_totalCurrentA = CalculateTotalCurrent();
+
+    if (m_depleted)
+        return;
+
+    const double thresholdJ = m_lowBatteryTh * m_initialEnergyJ;
+    if (m_remainingEnergyJ <= thresholdJ)
+    {
+        HandleEnergyDepletion();
+        return;
+    }
+
+    const double powerW = m_totalCurrentA * m_supplyVoltageV;
+    if (powerW > 0)
+    {
+        const Time depletion = Seconds((m_remainingEnergyJ - thresholdJ) / powerW);
+        NS_LOG_LOGIC("Drawing " << powerW << " W, threshold crossed in " << depletion.As(Time::S));
+        m_depletionEvent =
+            Simulator::Schedule(depletion, &DroneEnergySource::HandleEnergyDepletion, this);
+    }
+}
+
+void
+DroneEnergySource::CalculateRemainingEnergy(void)
+{
+    const Time now = Simulator::Now();
+    const double drainedJ =
+        m_totalCurrentA * m_supplyVoltageV * (now - m_lastUpdateTime).GetSeconds();
+    m_lastUpdateTime = now;
+
+    if (drainedJ <= 0)
+        return;
+
+    m_remainingEnergyJ = (m_remainingEnergyJ > drainedJ) ? m_remainingEnergyJ - drainedJ : 0.0;
+    NotifyEnergyChanged();
+}
+
+void
+DroneEnergySource::HandleEnergyDepletion(void)
+{
+    NS_LOG_FUNCTION(this);
+    CalculateRemainingEnergy();
+
+    // The depletion instant is predicted in closed form, hence any residual above the
+    // threshold is only due to rounding of the event time.
+    const double thresholdJ = m_lowBatteryTh * m_initialEnergyJ;
+    if (m_remainingEnergyJ > thresholdJ)
+        m_remainingEnergyJ = thresholdJ;
+
+    NS_LOG_DEBUG("DroneEnergySource:LowBatteryThreshold crossed at "
+                 << Simulator::Now().GetSeconds() << " seconds.");
+    m_depleted = true;
+    NotifyEnergyDrained();
+}
+
+} // namespace ns3
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef DRONE_ENERGY_SOURCE_H
+#define DRONE_ENERGY_SOURCE_H
+
+#include <ns3/energy-source.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/traced-value.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup energy
+ *
+ * \brief Constant voltage energy source that integrates piecewise-constant current draws.
+ *
+ * The source does not poll its device energy models periodically. The total current is
+ * sampled on each UpdateEnergySource call, which device energy models issue whenever their
+ * power consumption changes, and held constant until the next one. Hence the remaining
+ * energy is computed exactly and the instant at which the low battery threshold is crossed
+ * is predicted in closed form, with a single depletion event scheduled for it.
+ */
+class DroneEnergySource : public energy::EnergySource
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     *
+     * \returns the object TypeId
+     */
+    static TypeId GetTypeId(void);
+
+    DroneEnergySource();
+
+    /**
+     * \brief Sets the initial energy, which is also the remaining one.
+     *
+     * \param initialEnergyJ Initial energy, in Joule.
+     */
+    void SetInitialEnergy(double initialEnergyJ);
+
+    /**
+     * \returns Initial energy stored in the source, in Joule.
+     */
+    virtual double GetInitialEnergy(void) const;
+
+    /**
+     * \returns Supply voltage of the source, in Volt.
+     */
+    virtual double GetSupplyVoltage(void) const;
+
+    /**
+     * \returns Maximum duration of a power segment of the device energy models.
+     */
+    Time GetPowerSegmentInterval(void) const;
+
+    /**
+     * \returns Remaining energy in the source, in Joule.
+     */
+    virtual double GetRemainingEnergy(void);
+
+    /**
+     * \returns Fraction of the initial energy that is still available.
+     */
+    virtual double GetEnergyFraction(void);
+
+    /**
+     * \brief Closes the current power segment and starts a new one.
+     *
+     * The energy drained since the last update is integrated with the current drawn so
+     * far, then the total current is sampled again from the device energy models and the
+     * depletion event is rescheduled accordingly.
+     */
+    virtual void UpdateEnergySource(void);
+
+  protected:
+    virtual void DoInitialize(void);
+    virtual void DoDispose(void);
+
+  private:
+    /**
+     * \brief Integrates the energy drained since the last update.
+     */
+    void CalculateRemainingEnergy(void);
+
+    /**
+     * \brief Handles the crossing of the low battery threshold.
+     */
+    void HandleEnergyDepletion(void);
+
+    double m_initialEnergyJ;                //!< Initial energy, in Joule
+    double m_supplyVoltageV;                //!< Supply voltage, in Volt
+    double m_lowBatteryTh;                  //!< Low battery threshold, as a fraction
+    double m_totalCurrentA;                 //!< Current drawn in the ongoing segment
+    bool m_depleted;                        //!< Whether the low battery threshold is crossed
+    Time m_lastUpdateTime;                  //!< Start of the ongoing segment
+    Time m_powerSegmentInterval;            //!< Maximum duration of a device power segment
+    EventId m_depletionEvent;               //!< Predicted low battery threshold crossing
+    TracedValue<double> m_remainingEnergyJ; //!< Remaining energy, in Joule
+};
+
+} // namespace ns3
+
+#endif /* DRONE_ENERGY_SOURCE_H */
@@ -27,8 +27,13 @@
 #include "ns3/uinteger.h"
 #include "ns3/uniform-planar-array.h"
 
+#include <ns3/rem-ply-writer.h>
+
+#include <algorithm>
 #include <fstream>
 #include <limits>
+#include <numeric>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -161,7 +166,24 @@ NrRadioGeoEnvironmentMapHelper::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&NrRadioGeoEnvironmentMapHelper::SetLogGeocentricRem,
                                               &NrRadioGeoEnvironmentMapHelper::GetLogGeocentricRem),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("MaxRefinementLevel",
+                          "If greater than 0, the REM is computed adaptively: XRes and YRes "
+                          "define a coarse grid whose tiles are recursively split in four, up to "
+                          "this number of times, where the best server changes or the SINR "
+                          "varies more than RefinementThreshold among the corners. Results are "
+                          "also written as sparse tiles to nr-rem-${SimTag}-tiles.out.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(
+                              &NrRadioGeoEnvironmentMapHelper::m_maxRefinementLevel),
+                          MakeUintegerChecker<uint16_t>(0, 16))
+            .AddAttribute("RefinementThreshold",
+                          "The SINR variation (dB) among the corners of a tile above which the "
+                          "tile is refined, when MaxRefinementLevel is greater than 0.",
+                          DoubleValue(3.0),
+                          MakeDoubleAccessor(
+                              &NrRadioGeoEnvironmentMapHelper::m_refinementThresholdDb),
+                          MakeDoubleChecker<double>(0.0));
     return tid;
 }
 
@@ -403,6 +425,8 @@ NrRadioGeoEnvironmentMapHelper::ConfigureRtdList(const NetDeviceContainer& rtdDe
         rtd.antenna = m_deviceToAntenna.find(*netDevIt)->second;
 
         rtd.txPower = rtdPhy->GetTxPower();
+        // TX PSD and its conversion toward the RRD do not depend on the REM point
+        GetTxPsd(rtd, m_rrd);
 
         NS_LOG_DEBUG("power of UE: " << rtd.txPower);
 
@@ -416,10 +440,10 @@ NrRadioGeoEnvironmentMapHelper::ConfigureRtdList(const NetDeviceContainer& rtdDe
 
         m_remDev.push_back(rtd);
     }
-    NS_ASSERT_MSG(!m_remDev.empty(),
-                  "No RTD devices configured. Check if the RTD "
-                  "devices are on the operating on the same "
-                  "spectrum as RRD device.");
+    NS_ABORT_MSG_IF(m_remDev.empty(),
+                    "No RTD devices configured. Check if the RTD "
+                    "devices are on the operating on the same "
+                    "spectrum as RRD device.");
 }
 
 void
@@ -435,6 +459,10 @@ NrRadioGeoEnvironmentMapHelper::ConfigurePropagationModelsFactories(const Ptr<co
     m_phasedArraySpectrumLossModel =
         txSpectrumChannel->GetPhasedArraySpectrumPropagationLossModel();
 
+    // Walking the attributes by reflection is expensive, do it once for all the REM points
+    m_propagationLossModelFactory = ConfigureObjectFactory(m_propagationLossModel);
+    m_spectrumLossModelFactory = ConfigureObjectFactory(m_phasedArraySpectrumLossModel);
+
     /***** configure ChannelConditionModel factory if ThreeGppPropagationLossModel propagation model
      * is being used ****/
     Ptr<ThreeGppPropagationLossModel> propagationLossModel =
@@ -659,22 +687,16 @@ NrRadioGeoEnvironmentMapHelper::DelayedInstall(const NetDeviceContainer& rtdNetD
 
     ConfigureRrd(rrdDevice);
     ConfigureRtdList(rtdNetDev);
-    CreateListOfRemPoints();
-    if (m_remMode == COVERAGE_AREA)
-    {
-        CalcCoverageAreaRemMap();
-    }
-    else if (m_remMode == BEAM_SHAPE)
+    InitRxPowerMatrix();
+    if (m_maxRefinementLevel == 0)
     {
-        CalcBeamShapeRemMap();
-    }
-    else if (m_remMode == UE_COVERAGE)
-    {
-        CalcUeCoverageRemMap();
+        CreateListOfRemPoints();
+        CalcUniformRemMap();
     }
     else
     {
-        NS_FATAL_ERROR("Unknown REM mode");
+        CalcAdaptiveRemMap();
+        PrintRemTilesToFile();
     }
     PrintRemToFile();
     PrintGeocentricRemToFile();
@@ -713,23 +735,25 @@ NrRadioGeoEnvironmentMapHelper::CreateListOfRemPoints()
                                                                       GeographicPositions::SPHERE);
 
             // In case a REM Point is in the same position as a rtd, ignore this point
-            bool isPositionRtd = false;
-            for (auto& itRtd : m_remDev)
+            if (!IsRtdPosition(pos))
             {
-                if (itRtd.mob->GetPosition() == pos)
-                {
-                    isPositionRtd = true;
-                }
+                m_rem.Add(pos);
             }
+        }
+    }
+}
 
-            if (!isPositionRtd)
-            {
-                RemPoint remPoint;
-                remPoint.pos = pos;
-                m_rem.push_back(remPoint);
-            }
+bool
+NrRadioGeoEnvironmentMapHelper::IsRtdPosition(const Vector& pos) const
+{
+    for (const auto& itRtd : m_remDev)
+    {
+        if (itRtd.mob->GetPosition() == pos)
+        {
+            return true;
         }
     }
+    return false;
 }
 
 void
@@ -754,47 +778,56 @@ NrRadioGeoEnvironmentMapHelper::ConfigureDirectPathBfv(RemDevice& device,
     device.antenna->SetBeamformingVector(CreateDirectPathBfv(device.mob, otherDevice.mob, antenna));
 }
 
-Ptr<SpectrumValue>
-NrRadioGeoEnvironmentMapHelper::CalcRxPsdValue(RemDevice& device, RemDevice& otherDevice) const
+Ptr<const SpectrumValue>
+NrRadioGeoEnvironmentMapHelper::GetTxPsd(RemDevice& device, const RemDevice& otherDevice) const
 {
-    PropagationModels tempPropModels = CreateTemporalPropagationModels();
-
-    std::vector<int> activeRbs;
-    for (size_t rbId = 0; rbId < device.spectrumModel->GetNumBands(); rbId++)
+    if (!device.txPsd)
     {
-        activeRbs.push_back(rbId);
+        std::vector<int> activeRbs(device.spectrumModel->GetNumBands());
+        std::iota(activeRbs.begin(), activeRbs.end(), 0);
+
+        device.txPsd = NrSpectrumValueHelper::CreateTxPowerSpectralDensity(
+            device.txPower,
+            activeRbs,
+            device.spectrumModel,
+            NrSpectrumValueHelper::UNIFORM_POWER_ALLOCATION_BW);
     }
 
-    Ptr<const SpectrumValue> txPsd = NrSpectrumValueHelper::CreateTxPowerSpectralDensity(
-        device.txPower,
-        activeRbs,
-        device.spectrumModel,
-        NrSpectrumValueHelper::UNIFORM_POWER_ALLOCATION_BW);
-
     // check if RTD has the same spectrum model as RRD
     // if they have do nothing, if they dont, then convert txPsd of RTD device so to be according to
     // spectrum model of RRD
-
-    Ptr<const SpectrumValue> convertedTxPsd;
     if (device.spectrumModel->GetUid() == otherDevice.spectrumModel->GetUid())
     {
         NS_LOG_LOGIC("no spectrum conversion needed");
-        convertedTxPsd = txPsd;
+        return device.txPsd;
     }
-    else
+
+    auto it = device.convertedTxPsd.find(otherDevice.spectrumModel->GetUid());
+    if (it == device.convertedTxPsd.end())
     {
         NS_LOG_LOGIC("Converting TXPSD of RTD device " << device.spectrumModel->GetUid() << " --> "
                                                        << otherDevice.spectrumModel->GetUid());
 
         SpectrumConverter converter(device.spectrumModel, otherDevice.spectrumModel);
-        convertedTxPsd = converter.Convert(txPsd);
+        it = device.convertedTxPsd
+                 .emplace(otherDevice.spectrumModel->GetUid(), converter.Convert(device.txPsd))
+                 .first;
     }
+    return it->second;
+}
+
+Ptr<SpectrumValue>
+NrRadioGeoEnvironmentMapHelper::CalcRxPsdValue(RemDevice& device,
+                                               RemDevice& otherDevice,
+                                               const PropagationModels& propModels) const
+{
+    Ptr<const SpectrumValue> convertedTxPsd = GetTxPsd(device, otherDevice);
 
     // Copy TX PSD to RX PSD, they are now equal rxPsd == txPsd
     Ptr<SpectrumSignalParameters> rxParams = Create<SpectrumSignalParameters>();
     rxParams->psd = convertedTxPsd->Copy();
     double pathLossDb =
-        tempPropModels.remPropagationLossModelCopy->CalcRxPower(0, device.mob, otherDevice.mob);
+        propModels.remPropagationLossModelCopy->CalcRxPower(0, device.mob, otherDevice.mob);
     double pathGainLinear = DbToRatio(pathLossDb);
 
     NS_LOG_DEBUG("Tx power in dBm:" << WToDbm(Integral(*convertedTxPsd)));
@@ -807,45 +840,17 @@ NrRadioGeoEnvironmentMapHelper::CalcRxPsdValue(RemDevice& device, RemDevice& oth
 
     // Now we call spectrum model, which in this keys add a beamforming gain
     rxParams =
-        tempPropModels.remSpectrumLossModelCopy->DoCalcRxPowerSpectralDensity(rxParams,
-                                                                              device.mob,
-                                                                              otherDevice.mob,
-                                                                              device.antenna,
-                                                                              otherDevice.antenna);
+        propModels.remSpectrumLossModelCopy->DoCalcRxPowerSpectralDensity(rxParams,
+                                                                          device.mob,
+                                                                          otherDevice.mob,
+                                                                          device.antenna,
+                                                                          otherDevice.antenna);
 
     NS_LOG_DEBUG("RX power in dBm after fading: " << WToDbm(Integral(*(rxParams->psd))));
 
     return rxParams->psd;
 }
 
-Ptr<SpectrumValue>
-NrRadioGeoEnvironmentMapHelper::GetMaxValue(const std::list<Ptr<SpectrumValue>>& values) const
-{
-    // TODO add this abort, if necessary add include for abort.h
-    NS_ABORT_MSG_IF(values.empty(), "Must provide a list of values.");
-
-    Ptr<SpectrumValue> maxValue = Create<SpectrumValue>(m_rrd.spectrumModel);
-    *maxValue = **(values.begin());
-
-    for (const auto& value : values)
-    {
-        if (Sum(*(value)) > Sum(*(maxValue)))
-        {
-            *maxValue = *value;
-        }
-    }
-    return maxValue;
-}
-
-double
-NrRadioGeoEnvironmentMapHelper::CalculateMaxSnr(
-    const std::list<Ptr<SpectrumValue>>& receivedPowerList) const
-{
-    Ptr<SpectrumValue> maxSnr = GetMaxValue(receivedPowerList);
-    SpectrumValue snr = (*maxSnr) / (*m_noisePsd);
-    return RatioToDb(Sum(snr) / snr.GetSpectrumModel()->GetNumBands());
-}
-
 double
 NrRadioGeoEnvironmentMapHelper::CalculateSnr(const Ptr<SpectrumValue>& usefulSignal) const
 {
@@ -863,148 +868,141 @@ NrRadioGeoEnvironmentMapHelper::SetInterferers(const NetDeviceContainer& interfe
     for (auto it = interferers.Begin(); it != interferers.End(); ++it)
     {
         Ptr<NetDevice> dev = *it;
-        if (!dev)
+        if (!dev || (!DynamicCast<NrGnbNetDevice>(dev) && !DynamicCast<NrUeNetDevice>(dev)))
             continue;
 
-        Ptr<NrPhy> phy = nullptr;
+        // The cached descriptor holds a COPY of the antenna, so we can modify beamforming
+        // without affecting the live device
+        const RemDevice& remDev = GetRemDevice(dev, bwpId).device;
 
-        Ptr<NrGnbNetDevice> gnb = DynamicCast<NrGnbNetDevice>(dev);
-        if (gnb)
-        {
-            phy = gnb->GetPhy(bwpId);
-        }
-        else
+        if (remDev.mob)
         {
-            Ptr<NrUeNetDevice> ue = DynamicCast<NrUeNetDevice>(dev);
-            if (ue)
-            {
-                phy = ue->GetPhy(bwpId);
-            }
+            // We do not copy the position here; we rely on the live mobility model
+            // because GetSinr is instantaneous.
+            m_remDev.push_back(remDev);
         }
+    }
+}
 
-        if (!phy)
-            continue;
+std::string
+NrRadioGeoEnvironmentMapHelper::GetAntennaSignature(
+    const Ptr<const UniformPlanarArray>& antenna) const
+{
+    static const std::vector<std::string> attributes = {"NumColumns",
+                                                        "NumRows",
+                                                        "AntennaHorizontalSpacing",
+                                                        "AntennaVerticalSpacing",
+                                                        "BearingAngle",
+                                                        "DowntiltAngle",
+                                                        "PolSlantAngle",
+                                                        "IsDualPolarized",
+                                                        "AntennaElement"};
+    std::ostringstream signature;
+    for (const auto& name : attributes)
+    {
+        StringValue value;
+        antenna->GetAttribute(name, value);
+        signature << value.Get() << ";";
+    }
+    return signature.str();
+}
 
-        RemDevice remDev;
-        remDev.node = dev->GetNode();
-        remDev.mob = remDev.node->GetObject<GeocentricMobilityModel>();
-        remDev.spectrumModel = phy->GetSpectrumModel();
-        remDev.txPower = phy->GetTxPower();
+NrRadioGeoEnvironmentMapHelper::RemDeviceCacheEntry&
+NrRadioGeoEnvironmentMapHelper::GetRemDevice(const Ptr<NetDevice>& device, uint8_t bwpId)
+{
+    NS_LOG_FUNCTION(this << device << +bwpId);
 
-        auto spectrumPhy = phy->GetSpectrumPhy();
-        if (spectrumPhy && spectrumPhy->GetAntenna())
+    auto it = m_remDeviceCache.find({device, bwpId});
+    if (it == m_remDeviceCache.end())
+    {
+        Ptr<NrPhy> phy;
+        if (auto gnb = DynamicCast<NrGnbNetDevice>(device))
         {
-            // COPY the antenna so we can modify beamforming without affecting the live device
-            remDev.antenna =
-                ConfigureObjectFactory(spectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>())
-                    .Create<UniformPlanarArray>();
+            phy = gnb->GetPhy(bwpId);
         }
-
-        if (remDev.mob)
+        else if (auto ue = DynamicCast<NrUeNetDevice>(device))
         {
-            // We do not copy the position here; we rely on the live mobility model
-            // because GetSinr is instantaneous.
-            m_remDev.push_back(remDev);
+            phy = ue->GetPhy(bwpId);
         }
+        NS_ABORT_MSG_IF(!phy, "GetSinr expects NR UE or gNB devices.");
+
+        it = m_remDeviceCache.emplace(std::make_pair(device, bwpId),
+                                      RemDeviceCacheEntry{RemDevice(device->GetNode()), phy})
+                 .first;
     }
-}
 
-double
-NrRadioGeoEnvironmentMapHelper::GetSinr(Ptr<NetDevice> ueDevice,
-                                        Ptr<NetDevice> gnbDevice,
-                                        uint8_t bwpId,
-                                        bool isDl)
-{
-    NS_LOG_FUNCTION(this);
+    RemDeviceCacheEntry& entry = it->second;
+    RemDevice& remDevice = entry.device;
+
+    // Spectrum model and power may be reconfigured during the simulation
+    if (remDevice.spectrumModel != entry.phy->GetSpectrumModel() ||
+        remDevice.txPower != entry.phy->GetTxPower())
+    {
+        remDevice.spectrumModel = entry.phy->GetSpectrumModel();
+        remDevice.txPower = entry.phy->GetTxPower();
+        remDevice.txPsd = nullptr;
+        remDevice.convertedTxPsd.clear();
+    }
 
-    Ptr<NrUeNetDevice> ueNrDevice = DynamicCast<NrUeNetDevice>(ueDevice);
-    Ptr<NrGnbNetDevice> gnbNrDevice = DynamicCast<NrGnbNetDevice>(gnbDevice);
+    // The antenna copy is rebuilt only if the radiation pattern of the original has changed
+    auto antenna = entry.phy->GetSpectrumPhy()->GetAntenna()->GetObject<UniformPlanarArray>();
+    std::string signature = GetAntennaSignature(antenna);
+    if (!remDevice.antenna || signature != entry.antennaSignature)
+    {
+        NS_LOG_LOGIC("Copying antenna of device " << device);
+        remDevice.antenna = ConfigureObjectFactory(antenna).Create<UniformPlanarArray>();
+        entry.antennaSignature = signature;
+        entry.beamformingVector = PhasedArrayModel::ComplexVector();
+    }
 
-    if (!ueNrDevice || !gnbNrDevice)
+    auto beamformingVector = antenna->GetBeamformingVector();
+    if (beamformingVector.GetSize() != entry.beamformingVector.GetSize() ||
+        beamformingVector != entry.beamformingVector)
     {
-        NS_FATAL_ERROR("GetSinr expects an NrUeNetDevice and an NrGnbNetDevice.");
+        remDevice.antenna->SetBeamformingVector(beamformingVector);
+        entry.beamformingVector = beamformingVector;
     }
 
-    Ptr<NrPhy> uePhy = ueNrDevice->GetPhy(bwpId);
-    Ptr<NrPhy> gnbPhy = gnbNrDevice->GetPhy(bwpId);
+    return entry;
+}
 
+void
+NrRadioGeoEnvironmentMapHelper::PrepareSinrCalculation(const Ptr<NrPhy>& uePhy,
+                                                       const Ptr<NrPhy>& gnbPhy,
+                                                       bool isDl)
+{
     // Ensure Propagation Models are configured (using gNB PHY mostly for factory config)
     if (!m_propagationLossModel)
     {
         ConfigurePropagationModelsFactories(gnbPhy);
     }
 
-    // Configure Devices based on Direction
-    RemDevice rxDevice;
-    RemDevice txDevice;
-
-    if (isDl)
-    {
-        // DL: Rx = UE, Tx = gNB
-        // Receiver (UE)
-        rxDevice.node = ueDevice->GetNode();
-        rxDevice.mob = rxDevice.node->GetObject<GeocentricMobilityModel>();
-        rxDevice.spectrumModel = uePhy->GetSpectrumModel();
-        rxDevice.antenna =
-            ConfigureObjectFactory(
-                uePhy->GetSpectrumPhy()->GetAntenna()->GetObject<UniformPlanarArray>())
-                .Create<UniformPlanarArray>();
-
-        // Transmitter (gNB)
-        txDevice.node = gnbDevice->GetNode();
-        txDevice.mob = txDevice.node->GetObject<GeocentricMobilityModel>();
-        txDevice.spectrumModel = gnbPhy->GetSpectrumModel();
-        txDevice.antenna =
-            ConfigureObjectFactory(
-                gnbPhy->GetSpectrumPhy()->GetAntenna()->GetObject<UniformPlanarArray>())
-                .Create<UniformPlanarArray>();
-        txDevice.txPower = gnbPhy->GetTxPower();
-
-        // Prepare Noise (at Rx: UE)
-        if (!m_noisePsd)
-        {
-            m_noisePsd =
-                NrSpectrumValueHelper::CreateNoisePowerSpectralDensity(uePhy->GetNoiseFigure(),
-                                                                       rxDevice.spectrumModel);
-        }
-    }
-    else
+    // Prepare Noise (at Rx: UE for DL, gNB for UL)
+    if (!m_noisePsd)
     {
-        // UL: Rx = gNB, Tx = UE
-        // Receiver (gNB)
-        rxDevice.node = gnbDevice->GetNode();
-        rxDevice.mob = rxDevice.node->GetObject<GeocentricMobilityModel>();
-        rxDevice.spectrumModel = gnbPhy->GetSpectrumModel();
-        rxDevice.antenna =
-            ConfigureObjectFactory(
-                gnbPhy->GetSpectrumPhy()->GetAntenna()->GetObject<UniformPlanarArray>())
-                .Create<UniformPlanarArray>();
-
-        // Transmitter (UE)
-        txDevice.node = ueDevice->GetNode();
-        txDevice.mob = txDevice.node->GetObject<GeocentricMobilityModel>();
-        txDevice.spectrumModel = uePhy->GetSpectrumModel();
-        txDevice.antenna =
-            ConfigureObjectFactory(
-                uePhy->GetSpectrumPhy()->GetAntenna()->GetObject<UniformPlanarArray>())
-                .Create<UniformPlanarArray>();
-        txDevice.txPower = uePhy->GetTxPower();
-
-        // Prepare Noise (at Rx: gNB)
-        if (!m_noisePsd)
-        {
-            m_noisePsd =
-                NrSpectrumValueHelper::CreateNoisePowerSpectralDensity(gnbPhy->GetNoiseFigure(),
-                                                                       rxDevice.spectrumModel);
-        }
+        Ptr<NrPhy> rxPhy = isDl ? uePhy : gnbPhy;
+        m_noisePsd = NrSpectrumValueHelper::CreateNoisePowerSpectralDensity(
+            rxPhy->GetNoiseFigure(),
+            rxPhy->GetSpectrumModel());
     }
+}
+
+double
+NrRadioGeoEnvironmentMapHelper::CalcLinkSinr(RemDevice& ue,
+                                             RemDevice& gnb,
+                                             bool isDl,
+                                             const PropagationModels& propModels)
+{
+    // Configure Devices based on Direction: DL Rx = UE, Tx = gNB; UL Rx = gNB, Tx = UE
+    RemDevice& rxDevice = isDl ? ue : gnb;
+    RemDevice& txDevice = isDl ? gnb : ue;
 
     // Configure Ideal Beamforming (Direct Path) for the active link
     ConfigureDirectPathBfv(txDevice, rxDevice, txDevice.antenna);
     ConfigureDirectPathBfv(rxDevice, txDevice, rxDevice.antenna);
 
     // Calculate Signal
-    Ptr<SpectrumValue> usefulSignal = CalcRxPsdValue(txDevice, rxDevice);
+    Ptr<SpectrumValue> usefulSignal = CalcRxPsdValue(txDevice, rxDevice, propModels);
 
     // Calculate Interference
     std::list<Ptr<SpectrumValue>> interferenceSignals;
@@ -1019,43 +1017,78 @@ NrRadioGeoEnvironmentMapHelper::GetSinr(Ptr<NetDevice> ueDevice,
         // Configure Interferer beam to point to the Victim Receiver (Worst Case)
         ConfigureDirectPathBfv(intDev, rxDevice, intDev.antenna);
 
-        interferenceSignals.push_back(CalcRxPsdValue(intDev, rxDevice));
+        interferenceSignals.push_back(CalcRxPsdValue(intDev, rxDevice, propModels));
     }
 
     return CalculateSinr(usefulSignal, interferenceSignals);
 }
 
 double
-NrRadioGeoEnvironmentMapHelper::CalculateSinr(
-    const Ptr<SpectrumValue>& usefulSignal,
-    const std::list<Ptr<SpectrumValue>>& interferenceSignals) const
+NrRadioGeoEnvironmentMapHelper::GetSinr(Ptr<NetDevice> ueDevice,
+                                        Ptr<NetDevice> gnbDevice,
+                                        uint8_t bwpId,
+                                        bool isDl)
 {
-    Ptr<SpectrumValue> interferencePsd = nullptr;
+    NS_LOG_FUNCTION(this);
 
-    if (interferenceSignals.empty())
+    if (!DynamicCast<NrUeNetDevice>(ueDevice) || !DynamicCast<NrGnbNetDevice>(gnbDevice))
     {
-        return CalculateSnr(usefulSignal);
+        NS_FATAL_ERROR("GetSinr expects an NrUeNetDevice and an NrGnbNetDevice.");
     }
-    else
+
+    RemDeviceCacheEntry& ue = GetRemDevice(ueDevice, bwpId);
+    RemDeviceCacheEntry& gnb = GetRemDevice(gnbDevice, bwpId);
+    PrepareSinrCalculation(ue.phy, gnb.phy, isDl);
+
+    PropagationModels propModels = CreateTemporalPropagationModels();
+    return CalcLinkSinr(ue.device, gnb.device, isDl, propModels);
+}
+
+std::vector<std::vector<double>>
+NrRadioGeoEnvironmentMapHelper::GetSinrMatrix(const NetDeviceContainer& ueDevices,
+                                              const NetDeviceContainer& gnbDevices,
+                                              uint8_t bwpId,
+                                              bool isDl)
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<std::vector<double>> sinr(ueDevices.GetN(),
+                                          std::vector<double>(gnbDevices.GetN()));
+    if (ueDevices.GetN() == 0 || gnbDevices.GetN() == 0)
     {
-        interferencePsd = Create<SpectrumValue>(usefulSignal->GetSpectrumModel());
+        return sinr;
     }
 
-    // sum all interfering signals
-    for (auto rxInterfPower : interferenceSignals)
+    std::vector<RemDeviceCacheEntry*> ues;
+    std::vector<RemDeviceCacheEntry*> gnbs;
+    for (auto it = ueDevices.Begin(); it != ueDevices.End(); ++it)
     {
-        *interferencePsd += (*rxInterfPower);
+        NS_ABORT_MSG_IF(!DynamicCast<NrUeNetDevice>(*it),
+                        "GetSinrMatrix expects NrUeNetDevice as UE devices.");
+        ues.push_back(&GetRemDevice(*it, bwpId));
     }
-    // calculate sinr
-
-    SpectrumValue sinr = (*usefulSignal) / (*interferencePsd + *m_noisePsd);
+    for (auto it = gnbDevices.Begin(); it != gnbDevices.End(); ++it)
+    {
+        NS_ABORT_MSG_IF(!DynamicCast<NrGnbNetDevice>(*it),
+                        "GetSinrMatrix expects NrGnbNetDevice as gNB devices.");
+        gnbs.push_back(&GetRemDevice(*it, bwpId));
+    }
+    PrepareSinrCalculation(ues.front()->phy, gnbs.front()->phy, isDl);
 
-    // calculate average sinr over RBs, convert it from linear to dB units, and return it
-    return RatioToDb(Sum(sinr) / sinr.GetSpectrumModel()->GetNumBands());
+    // All the pairs are evaluated on the same channel realization, as a snapshot of this instant
+    PropagationModels propModels = CreateTemporalPropagationModels();
+    for (std::size_t i = 0; i < ues.size(); ++i)
+    {
+        for (std::size_t j = 0; j < gnbs.size(); ++j)
+        {
+            sinr[i][j] = CalcLinkSinr(ues[i]->device, gnbs[j]->device, isDl, propModels);
+        }
+    }
+    return sinr;
 }
 
 double
-NrRadioGeoEnvironmentMapHelper::CalculateSir(
+NrRadioGeoEnvironmentMapHelper::CalculateSinr(
     const Ptr<SpectrumValue>& usefulSignal,
     const std::list<Ptr<SpectrumValue>>& interferenceSignals) const
 {
@@ -1063,9 +1096,7 @@ NrRadioGeoEnvironmentMapHelper::CalculateSir(
 
     if (interferenceSignals.empty())
     {
-        // return CalculateSnr (usefulSignal);
-        SpectrumValue signal = (*usefulSignal);
-        return RatioToDb(Sum(signal) / signal.GetSpectrumModel()->GetNumBands());
+        return CalculateSnr(usefulSignal);
     }
     else
     {
@@ -1079,322 +1110,404 @@ NrRadioGeoEnvironmentMapHelper::CalculateSir(
     }
     // calculate sinr
 
-    SpectrumValue sir = (*usefulSignal) / (*interferencePsd);
+    SpectrumValue sinr = (*usefulSignal) / (*interferencePsd + *m_noisePsd);
 
-    // calculate average sir over RBs, convert it from linear to dB units, and return it
-    return RatioToDb(Sum(sir) / sir.GetSpectrumModel()->GetNumBands());
+    // calculate average sinr over RBs, convert it from linear to dB units, and return it
+    return RatioToDb(Sum(sinr) / sinr.GetSpectrumModel()->GetNumBands());
 }
 
-double
-NrRadioGeoEnvironmentMapHelper::CalculateMaxSinr(
-    const std::list<Ptr<SpectrumValue>>& receivedPowerList) const
+void
+NrRadioGeoEnvironmentMapHelper::InitRxPowerMatrix()
 {
-    // we calculate sinr considering for each RTD as if it would be TX device, and the rest of RTDs
-    // interferers
-    std::list<double> sinrList;
+    NS_LOG_FUNCTION(this);
+
+    const std::size_t numRtd = m_remDev.size();
+    const std::size_t numRb = m_rrd.spectrumModel->GetNumBands();
 
-    for (std::list<Ptr<SpectrumValue>>::const_iterator it = receivedPowerList.begin();
-         it != receivedPowerList.end();
-         it++)
+    m_rxPowerMatrix.assign(numRtd * numRb, 0.0);
+    m_interference.assign(numRtd * numRb, 0.0);
+    m_prefixRxPower.assign(numRb, 0.0);
+    m_noise.assign(m_noisePsd->ConstValuesBegin(), m_noisePsd->ConstValuesEnd());
+    m_rbWidths.clear();
+    for (auto band = m_rrd.spectrumModel->Begin(); band != m_rrd.spectrumModel->End(); ++band)
     {
-        // all signals - rxPower = interference
-        std::list<Ptr<SpectrumValue>> interferenceSignals;
-        std::list<Ptr<SpectrumValue>>::const_iterator tempit = it;
+        m_rbWidths.push_back(band->fh - band->fl);
+    }
 
-        if (it != receivedPowerList.begin())
-        {
-            interferenceSignals.insert(interferenceSignals.begin(), receivedPowerList.begin(), it);
-        }
+    m_reduction.snrDb.assign(numRtd, 0.0);
+    m_reduction.sinrDb.assign(numRtd, 0.0);
+    m_reduction.sirDb.assign(numRtd, 0.0);
+    m_reduction.rxPower.assign(numRtd, 0.0);
+    m_rtdScore.assign(numRtd, 0.0);
+}
 
-        interferenceSignals.insert(interferenceSignals.end(), ++tempit, receivedPowerList.end());
-        NS_ASSERT(interferenceSignals.size() == receivedPowerList.size() - 1);
-        sinrList.push_back(CalculateSinr(*it, interferenceSignals));
-    }
-    return GetMaxValue(sinrList);
+void
+NrRadioGeoEnvironmentMapHelper::StoreRxPower(std::size_t rtdIndex, const SpectrumValue& rxPsd)
+{
+    const std::size_t numRb = m_noise.size();
+    NS_ASSERT_MSG(rxPsd.GetValuesN() == numRb, "Received PSD does not match the RRD spectrum");
+    std::copy(rxPsd.ConstValuesBegin(),
+              rxPsd.ConstValuesEnd(),
+              m_rxPowerMatrix.begin() + rtdIndex * numRb);
 }
 
-double
-NrRadioGeoEnvironmentMapHelper::CalculateMaxSir(
-    const std::list<Ptr<SpectrumValue>>& receivedPowerList) const
+void
+NrRadioGeoEnvironmentMapHelper::ReduceRxPowerMatrix()
 {
-    // we calculate sinr considering for each RTD as if it would be TX device, and the rest of RTDs
-    // interferers
-    std::list<double> sirList;
+    const std::size_t numRtd = m_reduction.snrDb.size();
+    if (numRtd == 0)
+    {
+        return;
+    }
+
+    const std::size_t numRb = m_noise.size();
+    const double* power = m_rxPowerMatrix.data();
+    const double* noise = m_noise.data();
+    const double* widths = m_rbWidths.data();
+    double* interference = m_interference.data();
+    double* prefix = m_prefixRxPower.data();
 
-    for (std::list<Ptr<SpectrumValue>>::const_iterator it = receivedPowerList.begin();
-         it != receivedPowerList.end();
-         it++)
+    // Backward pass: interference of each RTD from the RTDs that follow it
+    std::fill(interference + (numRtd - 1) * numRb, interference + numRtd * numRb, 0.0);
+    for (std::size_t k = numRtd - 1; k-- > 0;)
     {
-        // all signals - rxPower = interference
-        std::list<Ptr<SpectrumValue>> interferenceSignals;
-        std::list<Ptr<SpectrumValue>>::const_iterator tempit = it;
+        const double* nextPower = power + (k + 1) * numRb;
+        const double* nextInterference = interference + (k + 1) * numRb;
+        double* rowInterference = interference + k * numRb;
+        for (std::size_t rb = 0; rb < numRb; ++rb)
+        {
+            rowInterference[rb] = nextInterference[rb] + nextPower[rb];
+        }
+    }
 
-        if (it != receivedPowerList.begin())
+    // Forward pass: add the RTDs that precede it and reduce all the metrics at once.
+    // Interference is never obtained as (total - own power), which would cancel
+    // catastrophically when a single RTD dominates.
+    std::fill(prefix, prefix + numRb, 0.0);
+    m_reduction.aggregatedRxPower = 0.0;
+    m_reduction.strongestRtd = 0;
+    for (std::size_t k = 0; k < numRtd; ++k)
+    {
+        const double* rowPower = power + k * numRb;
+        double* rowInterference = interference + k * numRb;
+        double signal = 0.0;
+        double snr = 0.0;
+        double sinr = 0.0;
+        double sir = 0.0;
+        double rxPower = 0.0;
+        for (std::size_t rb = 0; rb < numRb; ++rb)
         {
-            interferenceSignals.insert(interferenceSignals.begin(), receivedPowerList.begin(), it);
+            const double p = rowPower[rb];
+            const double i = rowInterference[rb] + prefix[rb];
+            signal += p;
+            snr += p / noise[rb];
+            sinr += p / (i + noise[rb]);
+            sir += p / i;
+            rxPower += p * widths[rb];
+            prefix[rb] += p;
         }
 
-        interferenceSignals.insert(interferenceSignals.end(), ++tempit, receivedPowerList.end());
-        NS_ASSERT(interferenceSignals.size() == receivedPowerList.size() - 1);
-        sirList.push_back(CalculateSir(*it, interferenceSignals));
+        m_reduction.snrDb[k] = RatioToDb(snr / numRb);
+        m_reduction.sinrDb[k] = RatioToDb(sinr / numRb);
+        // Without interferers the SIR degenerates to the average received power
+        m_reduction.sirDb[k] = RatioToDb((numRtd > 1 ? sir : signal) / numRb);
+        m_reduction.rxPower[k] = rxPower;
+        m_reduction.aggregatedRxPower += rxPower;
+        if (rxPower > m_reduction.rxPower[m_reduction.strongestRtd])
+        {
+            m_reduction.strongestRtd = k;
+        }
     }
-    return GetMaxValue(sirList);
 }
 
 void
-NrRadioGeoEnvironmentMapHelper::CalcBeamShapeRemMap()
+NrRadioGeoEnvironmentMapHelper::CalcRemPoint(std::size_t p)
+{
+    std::fill(m_rtdScore.begin(), m_rtdScore.end(), 0.0);
+
+    if (m_remMode == COVERAGE_AREA)
+    {
+        CalcCoverageAreaRemPoint(p);
+    }
+    else if (m_remMode == BEAM_SHAPE)
+    {
+        CalcBeamShapeRemPoint(p);
+    }
+    else if (m_remMode == UE_COVERAGE)
+    {
+        CalcUeCoverageRemPoint(p);
+    }
+    else
+    {
+        NS_FATAL_ERROR("Unknown REM mode");
+    }
+
+    m_rem.bestRtd[p] = static_cast<uint32_t>(
+        std::distance(m_rtdScore.begin(), std::max_element(m_rtdScore.begin(), m_rtdScore.end())));
+}
+
+void
+NrRadioGeoEnvironmentMapHelper::CalcUniformRemMap()
 {
     NS_LOG_FUNCTION(this);
 
-    uint32_t remSizeNextReport = m_rem.size() / 100;
+    uint32_t remSizeNextReport = m_rem.Size() / 100;
     uint32_t remPointCounter = 0;
 
-    for (std::list<RemPoint>::iterator itRemPoint = m_rem.begin(); itRemPoint != m_rem.end();
-         ++itRemPoint)
+    for (std::size_t p = 0; p < m_rem.Size(); ++p)
     {
-        // perform calculation m_numOfIterationsToAverage times and get the average value
-        double sumSnr = 0.0;
-        double sumSinr = 0.0;
-        double sumSir = 0.0;
-        std::list<double> rxPsdsListPerIt; // list to save the summed rxPower in each RemPoint for
-                                           // each Iteration (linear)
-        // Use ECEF directly with GeocentricMobilityModel
-        m_rrd.mob->SetPosition(itRemPoint->pos, PositionType::GEOCENTRIC);
-
-        Ptr<MobilityBuildingInfo> buildingInfo = m_rrd.mob->GetObject<MobilityBuildingInfo>();
-        buildingInfo->MakeConsistent(m_rrd.mob);
-        NS_ASSERT_MSG(buildingInfo, "buildingInfo is null");
+        CalcRemPoint(p);
 
-        for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
+        if (++remPointCounter == remSizeNextReport)
         {
-            std::list<Ptr<SpectrumValue>>
-                receivedPowerList; // RTD node id, rxPsd of the signal coming from that node
+            PrintProgressReport(&remSizeNextReport);
+        }
+    } // end for RemPoints
 
-            for (auto& itRtd : m_remDev)
-            {
-                // calculate received power from the current RTD device
-                receivedPowerList.push_back(CalcRxPsdValue(itRtd, m_rrd));
-            } // end for std::list<RemDev>::iterator  (RTDs)
+    auto remEndTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> remElapsedSeconds = remEndTime - m_remStartTime;
+    std::cout << "\n REM map created. Total time needed to create the REM map: "
+              << remElapsedSeconds.count() << " seconds." << std::endl;
+}
 
-            sumSnr += CalculateMaxSnr(receivedPowerList);
-            sumSinr += CalculateMaxSinr(receivedPowerList);
-            sumSir += CalculateMaxSir(receivedPowerList);
+void
+NrRadioGeoEnvironmentMapHelper::CalcAdaptiveRemMap()
+{
+    NS_LOG_FUNCTION(this);
 
-            // Sum all the rxPowers (for this RemPoint) and put the result to the list for each
-            // Iteration (linear)
-            rxPsdsListPerIt.push_back(CalculateAggregatedIpsd(receivedPowerList));
+    NS_ASSERT_MSG(m_maxLon > m_minLon, "MaxLon must be higher than MinLon");
+    NS_ASSERT_MSG(m_maxLat > m_minLat, "MaxLat must be higher than MinLat");
+    NS_ABORT_MSG_IF(m_maxRefinementLevel > 16, "MaxRefinementLevel cannot be higher than 16");
 
-            receivedPowerList.clear();
-        } // end for m_numOfIterationsToAverage  (Average)
+    // XRes and YRes define the coarse grid, each refinement level halves its step
+    m_lonStep = (m_maxLon - m_minLon) / (m_xRes);
+    m_latStep = (m_maxLat - m_minLat) / (m_yRes);
+    const uint32_t scale = 1U << m_maxRefinementLevel;
+    const double fineLonStep = m_lonStep / scale;
+    const double fineLatStep = m_latStep / scale;
+
+    NS_LOG_INFO("m_lonStep: " << m_lonStep << " m_latStep: " << m_latStep
+                              << " finest lonStep: " << fineLonStep
+                              << " finest latStep: " << fineLatStep);
+
+    // Rem Points live on the finest lattice, they are evaluated on demand and shared
+    // by all the tiles having them as a corner
+    std::unordered_map<uint64_t, std::size_t> lattice;
+    auto getPoint = [&](uint32_t i, uint32_t j) {
+        const uint64_t key = (static_cast<uint64_t>(i) << 32) | j;
+        auto it = lattice.find(key);
+        if (it != lattice.end())
+        {
+            return it->second;
+        }
 
-        // Sum the rxPower for all the Iterations (linear)
-        double rxPsdsAllIt = SumListElements(rxPsdsListPerIt);
+        Vector pos = GeographicPositions::GeographicToCartesianCoordinates(
+            m_minLat + j * fineLatStep,
+            m_minLon + i * fineLonStep,
+            m_altitude,
+            GeographicPositions::SPHERE);
 
-        itRemPoint->avgSnrDb = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
-        itRemPoint->avgSinrDb = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
-        itRemPoint->avgSirDb = sumSir / static_cast<double>(m_numOfIterationsToAverage);
-        // do the average (for the rxPowers in each RemPoint) in linear and then convert to dBm
-        itRemPoint->avRxPowerDbm =
-            WToDbm(rxPsdsAllIt / static_cast<double>(m_numOfIterationsToAverage));
+        std::size_t p = NO_REM_POINT;
+        // In case a REM Point is in the same position as a rtd, ignore this point
+        if (!IsRtdPosition(pos))
+        {
+            p = m_rem.Size();
+            m_rem.Add(pos);
+            CalcRemPoint(p);
+        }
+        lattice.emplace(key, p);
+        return p;
+    };
 
-        NS_LOG_INFO("Avg snr value saved:" << itRemPoint->avgSnrDb);
-        NS_LOG_INFO("Avg sinr value saved:" << itRemPoint->avgSinrDb);
-        NS_LOG_INFO("Avg ipsd value saved (dBm):" << itRemPoint->avRxPowerDbm);
+    std::vector<RemTile> tiles;
+    for (uint32_t i = 0; i < m_xRes; ++i)
+    {
+        for (uint32_t j = 0; j < m_yRes; ++j)
+        {
+            tiles.push_back({i * scale, j * scale, scale});
+        }
+    }
 
-        if (++remPointCounter == remSizeNextReport)
+    for (uint16_t level = 0; !tiles.empty(); ++level)
+    {
+        std::vector<RemTile> refinedTiles;
+        for (auto& tile : tiles)
         {
-            PrintProgressReport(&remSizeNextReport);
+            tile.corners = {getPoint(tile.i, tile.j),
+                            getPoint(tile.i + tile.size, tile.j),
+                            getPoint(tile.i, tile.j + tile.size),
+                            getPoint(tile.i + tile.size, tile.j + tile.size)};
+
+            if (tile.size > 1 && NeedsRefinement(tile))
+            {
+                const uint32_t half = tile.size / 2;
+                refinedTiles.push_back({tile.i, tile.j, half});
+                refinedTiles.push_back({tile.i + half, tile.j, half});
+                refinedTiles.push_back({tile.i, tile.j + half, half});
+                refinedTiles.push_back({tile.i + half, tile.j + half, half});
+            }
+            else
+            {
+                m_remTiles.push_back(tile);
+            }
         }
 
-    } // end for std::list<RemPoint>::iterator  (RemPoints)
+        std::cout << "\n REM refinement level " << level << ": " << tiles.size()
+                  << " tiles checked, " << refinedTiles.size() / 4 << " refined, "
+                  << m_rem.Size() << " points evaluated." << std::flush;
+        tiles = std::move(refinedTiles);
+    }
 
     auto remEndTime = std::chrono::system_clock::now();
     std::chrono::duration<double> remElapsedSeconds = remEndTime - m_remStartTime;
-    NS_LOG_INFO("REM map created. Total time needed to create the REM map:"
-                << remElapsedSeconds.count() / 60 << " minutes.");
+    std::cout << "\n REM map created. Total time needed to create the REM map: "
+              << remElapsedSeconds.count() << " seconds." << std::endl;
 }
 
-double
-NrRadioGeoEnvironmentMapHelper::GetMaxValue(const std::list<double>& listOfValues) const
+bool
+NrRadioGeoEnvironmentMapHelper::NeedsRefinement(const RemTile& tile) const
 {
-    NS_ABORT_MSG_IF(listOfValues.empty(),
-                    "GetMaxValue should not be called "
-                    "with an empty list.");
-
-    double maxValue = *(listOfValues.begin());
-    // start from second element, the first is already taken into account
-    for (auto it = ++listOfValues.begin(); it != listOfValues.end(); ++it)
+    double minSinr = std::numeric_limits<double>::infinity();
+    double maxSinr = -std::numeric_limits<double>::infinity();
+    for (auto p : tile.corners)
     {
-        if (*it > maxValue)
+        // a corner that could not be evaluated hides what happens in the tile
+        if (p == NO_REM_POINT)
+        {
+            return true;
+        }
+        // the serving RTD changes inside the tile, hence it contains a cell edge
+        if (m_rem.bestRtd[p] != m_rem.bestRtd[tile.corners[0]])
         {
-            maxValue = *it;
+            return true;
         }
+        minSinr = std::min(minSinr, m_rem.avgSinrDb[p]);
+        maxSinr = std::max(maxSinr, m_rem.avgSinrDb[p]);
     }
-    return maxValue;
+    return maxSinr - minSinr > m_refinementThresholdDb;
 }
 
-double
-NrRadioGeoEnvironmentMapHelper::CalculateAggregatedIpsd(
-    const std::list<Ptr<SpectrumValue>>& receivedSignals)
+void
+NrRadioGeoEnvironmentMapHelper::CalcBeamShapeRemPoint(std::size_t p)
 {
-    Ptr<SpectrumValue> sumRxPowers = nullptr;
-    sumRxPowers = Create<SpectrumValue>(m_rrd.spectrumModel);
-
-    // sum the received power of all the rtds
-    for (auto rxPowersIt : receivedSignals)
+    // perform calculation m_numOfIterationsToAverage times and get the average value
+    double sumSnr = 0.0;
+    double sumSinr = 0.0;
+    double sumSir = 0.0;
+    double sumRxPower = 0.0; // summed rxPower in this RemPoint over the Iterations (linear)
+    // Use ECEF directly with GeocentricMobilityModel
+    m_rrd.mob->SetPosition(m_rem.pos[p], PositionType::GEOCENTRIC);
+
+    Ptr<MobilityBuildingInfo> buildingInfo = m_rrd.mob->GetObject<MobilityBuildingInfo>();
+    buildingInfo->MakeConsistent(m_rrd.mob);
+    NS_ASSERT_MSG(buildingInfo, "buildingInfo is null");
+
+    for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
     {
-        *sumRxPowers += (*rxPowersIt);
-    }
-
-    SpectrumValue sumRxPowersSv = (*sumRxPowers);
-
-    return (Integral(sumRxPowersSv));
-}
+        PropagationModels propModels = CreateTemporalPropagationModels();
 
-double
-NrRadioGeoEnvironmentMapHelper::SumListElements(const std::list<double>& listOfValues)
-{
-    NS_ABORT_MSG_IF(listOfValues.empty(),
-                    "SumListElements should not be called "
-                    "with an empty list.");
+        std::size_t rtdIndex = 0;
+        for (auto& itRtd : m_remDev)
+        {
+            // calculate received power from the current RTD device
+            StoreRxPower(rtdIndex++, *CalcRxPsdValue(itRtd, m_rrd, propModels));
+        } // end for std::list<RemDev>::iterator  (RTDs)
+
+        ReduceRxPowerMatrix();
+
+        // SNR of the strongest RTD, best SINR and SIR among RTDs
+        sumSnr += m_reduction.snrDb[m_reduction.strongestRtd];
+        sumSinr += *std::max_element(m_reduction.sinrDb.begin(), m_reduction.sinrDb.end());
+        sumSir += *std::max_element(m_reduction.sirDb.begin(), m_reduction.sirDb.end());
+        sumRxPower += m_reduction.aggregatedRxPower;
+        // the serving RTD is the strongest one
+        for (std::size_t k = 0; k < m_rtdScore.size(); ++k)
+        {
+            m_rtdScore[k] += m_reduction.rxPower[k];
+        }
+    } // end for m_numOfIterationsToAverage  (Average)
 
-    double sum = 0;
+    m_rem.avgSnrDb[p] = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
+    m_rem.avgSinrDb[p] = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
+    m_rem.avgSirDb[p] = sumSir / static_cast<double>(m_numOfIterationsToAverage);
+    // do the average (for the rxPowers in each RemPoint) in linear and then convert to dBm
+    m_rem.avRxPowerDbm[p] = WToDbm(sumRxPower / static_cast<double>(m_numOfIterationsToAverage));
 
-    for (double listOfValue : listOfValues)
-    {
-        sum += listOfValue;
-    }
-    return sum;
+    NS_LOG_INFO("Avg snr value saved:" << m_rem.avgSnrDb[p]);
+    NS_LOG_INFO("Avg sinr value saved:" << m_rem.avgSinrDb[p]);
+    NS_LOG_INFO("Avg ipsd value saved (dBm):" << m_rem.avRxPowerDbm[p]);
 }
 
 void
-NrRadioGeoEnvironmentMapHelper::CalcCoverageAreaRemMap()
+NrRadioGeoEnvironmentMapHelper::CalcCoverageAreaRemPoint(std::size_t p)
 {
-    NS_LOG_FUNCTION(this);
-    uint16_t calcRxPsdCounter = 0;
-    uint32_t remSizeNextReport = m_rem.size() / 100;
-    uint32_t remPointCounter = 0;
-
-    for (std::list<RemPoint>::iterator itRemPoint = m_rem.begin(); itRemPoint != m_rem.end();
-         ++itRemPoint)
+    // perform calculation m_numOfIterationsToAverage times and get the average value
+    double sumSnr = 0.0;
+    double sumSinr = 0.0;
+    double sumRxPower = 0.0; // summed rxPower in this RemPoint over the Iterations (linear)
+    // Use ECEF directly with GeocentricMobilityModel
+    m_rrd.mob->SetPosition(m_rem.pos[p], PositionType::GEOCENTRIC);
+
+    // all RTDs should point toward that RemPoint with DirectPah beam, this is definition of
+    // worst-case scenario
+    for (auto& itRtd : m_remDev)
     {
-        // perform calculation m_numOfIterationsToAverage times and get the average value
-        double sumSnr = 0.0;
-        double sumSinr = 0.0;
-        // Use ECEF directly with GeocentricMobilityModel
-        m_rrd.mob->SetPosition(itRemPoint->pos, PositionType::GEOCENTRIC);
+        ConfigureDirectPathBfv(itRtd, m_rrd, itRtd.antenna);
+    }
 
-        // all RTDs should point toward that RemPoint with DirectPah beam, this is definition of
-        // worst-case scenario
-        for (auto& itRtd : m_remDev)
+    for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
+    {
+        PropagationModels propModels = CreateTemporalPropagationModels();
+        double maxSnr = -std::numeric_limits<double>::infinity();
+        double maxSinr = -std::numeric_limits<double>::infinity();
+
+        // For each beam configuration at RemPoint/RRD we should calculate SINR, there are as
+        // many beam configurations at RemPoint as many RTDs
+        std::size_t beamIndex = 0;
+        for (auto itRtdBeam = m_remDev.begin(); itRtdBeam != m_remDev.end();
+             ++itRtdBeam, ++beamIndex)
         {
-            ConfigureDirectPathBfv(itRtd, m_rrd, itRtd.antenna);
-        }
+            // configure RRD beam toward RTD
+            ConfigureDirectPathBfv(m_rrd, *itRtdBeam, m_rrd.antenna);
+
+            // For this configuration of beam at RRD, we need to calculate RX PSD,
+            // and in order to be able to calculate SINR for that beam,
+            // we need to calculate received PSD for each RTD using this beam at RRD
+            std::size_t rtdIndex = 0;
+            for (auto& itRtdCalc : m_remDev)
+            {
+                // calculate received power from the current RTD device
+                StoreRxPower(rtdIndex++, *CalcRxPsdValue(itRtdCalc, m_rrd, propModels));
+            } // end for std::list<RemDev>::iterator itRtdCalc (RTDs)
 
-        std::list<double> rxPsdsListPerIt; // list to save the summed rxPower in each RemPoint for
-                                           // each Iteration (linear)
+            ReduceRxPowerMatrix();
 
-        for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
-        {
-            std::list<double> sinrsPerBeam; // vector in which we will save sinr per each RRD beam
-            std::list<double> snrsPerBeam;  // vector in which we will save snr per each RRD beam
+            // the RTD toward which the beam points is the useful signal, the rest interfere
+            maxSnr = std::max(maxSnr, m_reduction.snrDb[beamIndex]);
+            maxSinr = std::max(maxSinr, m_reduction.sinrDb[beamIndex]);
+            // sum the rxPowers received through each beam (linear)
+            sumRxPower += m_reduction.rxPower[beamIndex];
+            // the serving RTD is the one reached by the best beam
+            m_rtdScore[beamIndex] += m_reduction.sinrDb[beamIndex];
 
-            std::list<Ptr<SpectrumValue>> rxPsdsList; // vector in which we will save the sum of
-                                                      // rxPowers per remPoint (linear)
+            NS_LOG_DEBUG("beam node: " << itRtdBeam->dev->GetNode()->GetId()
+                                       << " is Rxed in RemPoint with Rx Power in W: "
+                                       << m_reduction.rxPower[beamIndex]);
+            NS_LOG_DEBUG("RxPower in dBm: " << WToDbm(m_reduction.rxPower[beamIndex]));
 
-            // For each beam configuration at RemPoint/RRD we should calculate SINR, there are as
-            // many beam configurations at RemPoint as many RTDs
-            for (std::list<RemDevice>::iterator itRtdBeam = m_remDev.begin();
-                 itRtdBeam != m_remDev.end();
-                 ++itRtdBeam)
-            {
-                // configure RRD beam toward RTD
-                ConfigureDirectPathBfv(m_rrd, *itRtdBeam, m_rrd.antenna);
-
-                // Calculate the received power from this RTD for this RemPoint
-                Ptr<SpectrumValue> receivedPowerFromRtd = CalcRxPsdValue(*itRtdBeam, m_rrd);
-                // and put it to the list of the received powers for this RemPoint (to sum all
-                // later)
-                rxPsdsList.push_back(receivedPowerFromRtd);
-
-                NS_LOG_DEBUG("beam node: " << itRtdBeam->dev->GetNode()->GetId()
-                                           << " is Rxed in RemPoint with Rx Power in W: "
-                                           << (Integral(*receivedPowerFromRtd)));
-                NS_LOG_DEBUG("RxPower in dBm: " << WToDbm(Integral(*receivedPowerFromRtd)));
-
-                std::list<Ptr<SpectrumValue>> interferenceSignalsRxPsds;
-                Ptr<SpectrumValue> usefulSignalRxPsd;
-
-                // For this configuration of beam at RRD, we need to calculate RX PSD,
-                // and in order to be able to calculate SINR for that beam,
-                // we need to calculate received PSD for each RTD using this beam at RRD
-                for (auto& itRtdCalc : m_remDev)
-                {
-                    // increase counter of calcRxPsd calls
-                    calcRxPsdCounter++;
-                    // calculate received power from the current RTD device
-                    Ptr<SpectrumValue> receivedPower = CalcRxPsdValue(itRtdCalc, m_rrd);
-
-                    // is this received power useful signal (from RTD for which I configured my
-                    // beam) or is interference signal
-
-                    if (itRtdBeam->dev->GetNode()->GetId() == itRtdCalc.dev->GetNode()->GetId())
-                    {
-                        if (usefulSignalRxPsd != nullptr)
-                        {
-                            NS_FATAL_ERROR("Already assigned usefulSignal!");
-                        }
-                        usefulSignalRxPsd = receivedPower;
-                    }
-                    else
-                    {
-                        interferenceSignalsRxPsds.push_back(receivedPower); // interference
-                    }
-
-                } // end for std::list<RemDev>::iterator itRtdCalc (RTDs)
-
-                sinrsPerBeam.push_back(CalculateSinr(usefulSignalRxPsd, interferenceSignalsRxPsds));
-                snrsPerBeam.push_back(CalculateSnr(usefulSignalRxPsd));
-
-                NS_LOG_INFO("Done:" << (double)calcRxPsdCounter /
-                                           (m_rem.size() * m_numOfIterationsToAverage *
-                                            m_remDev.size() * m_remDev.size()) *
-                                           100
-                                    << " %."); // how many times will be called CalcRxPsdValues
-
-            } // end for std::list<RemDev>::iterator itRtdBeam (RTDs)
-
-            sumSnr += GetMaxValue(snrsPerBeam);
-            sumSinr += GetMaxValue(sinrsPerBeam);
-
-            // Sum all the rxPowers (for this RemPoint) and put the result to the list for each
-            // Iteration (linear)
-            rxPsdsListPerIt.push_back(CalculateAggregatedIpsd(rxPsdsList));
-
-        } // end for m_numOfIterationsToAverage  (Average)
-
-        // Sum the rxPower for all the Iterations (linear)
-        double rxPsdsAllIt = SumListElements(rxPsdsListPerIt);
-
-        itRemPoint->avgSnrDb = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
-        itRemPoint->avgSinrDb = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
-        // do the average (for the rxPowers in each RemPoint) in linear and then convert to dBm
-        itRemPoint->avRxPowerDbm =
-            WToDbm(rxPsdsAllIt / static_cast<double>(m_numOfIterationsToAverage));
+        } // end for std::list<RemDev>::iterator itRtdBeam (RTDs)
 
-        if (++remPointCounter == remSizeNextReport)
-        {
-            PrintProgressReport(&remSizeNextReport);
-        }
+        sumSnr += maxSnr;
+        sumSinr += maxSinr;
 
-        NS_LOG_DEBUG("itRemPoint->avRxPowerDb  in dB: " << itRemPoint->avRxPowerDbm);
+    } // end for m_numOfIterationsToAverage  (Average)
 
-    } // end for std::list<RemPoint>::iterator  (RemPoints)
+    m_rem.avgSnrDb[p] = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
+    m_rem.avgSinrDb[p] = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
+    // do the average (for the rxPowers in each RemPoint) in linear and then convert to dBm
+    m_rem.avRxPowerDbm[p] = WToDbm(sumRxPower / static_cast<double>(m_numOfIterationsToAverage));
 
-    auto remEndTime = std::chrono::system_clock::now();
-    std::chrono::duration<double> remElapsedSeconds = remEndTime - m_remStartTime;
-    NS_LOG_INFO("REM map created. Total time needed to create the REM map:"
-                << remElapsedSeconds.count() / 60 << " minutes.");
+    NS_LOG_DEBUG("avRxPowerDbm in dB: " << m_rem.avRxPowerDbm[p]);
 }
 
 void
@@ -1404,108 +1517,88 @@ NrRadioGeoEnvironmentMapHelper::PrintProgressReport(uint32_t* remSizeNextReport)
     std::chrono::duration<double> remElapsedSecondsUpToNow = remTimeUpToNow - m_remStartTime;
     double minutesUpToNow = ((double)remElapsedSecondsUpToNow.count()) / 60;
     double minutesLeftEstimated =
-        ((double)(minutesUpToNow) / *remSizeNextReport) * ((m_rem.size() - *remSizeNextReport));
-    std::cout << "\n REM done:" << ceil(((double)*remSizeNextReport / m_rem.size()) * 100) << " %."
+        ((double)(minutesUpToNow) / *remSizeNextReport) * ((m_rem.Size() - *remSizeNextReport));
+    std::cout << "\n REM done:" << ceil(((double)*remSizeNextReport / m_rem.Size()) * 100) << " %."
               << " Minutes up to now: " << minutesUpToNow
               << ". Minutes left estimated:" << minutesLeftEstimated
               << "."; // how many times will be called CalcRxPsdValues
     // we want progress report for 1%, 10%, 20%, 30%, and so on
-    if (*remSizeNextReport < m_rem.size() / 10)
+    if (*remSizeNextReport < m_rem.Size() / 10)
     {
-        *remSizeNextReport = m_rem.size() / 10;
+        *remSizeNextReport = m_rem.Size() / 10;
     }
     else
     {
-        *remSizeNextReport += m_rem.size() / 10;
+        *remSizeNextReport += m_rem.Size() / 10;
     }
 }
 
 void
-NrRadioGeoEnvironmentMapHelper::CalcUeCoverageRemMap()
+NrRadioGeoEnvironmentMapHelper::CalcUeCoverageRemPoint(std::size_t p)
 {
-    NS_LOG_FUNCTION(this);
+    // perform calculation m_numOfIterationsToAverage times and get the average value
+    double sumSnr = 0.0;
+    double sumSinr = 0.0;
 
-    uint32_t remSizeNextReport = m_rem.size() / 100;
-    uint32_t remPointCounter = 0;
+    // Use ECEF directly with GeocentricMobilityModel
+    m_rrd.mob->SetPosition(m_rem.pos[p], PositionType::GEOCENTRIC);
 
-    for (auto& itRemPoint : m_rem)
+    for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
     {
-        // perform calculation m_numOfIterationsToAverage times and get the average value
-        double sumSnr = 0.0;
-        double sumSinr = 0.0;
-
-        // Use ECEF directly with GeocentricMobilityModel
-        m_rrd.mob->SetPosition(itRemPoint.pos, PositionType::GEOCENTRIC);
+        PropagationModels propModels = CreateTemporalPropagationModels();
+        double maxSnr = -std::numeric_limits<double>::infinity();
+        double maxSinr = -std::numeric_limits<double>::infinity();
 
-        for (uint16_t i = 0; i < m_numOfIterationsToAverage; i++)
+        //"Associate" UE (RemPoint) with this RTD
+        std::size_t associatedIndex = 0;
+        for (auto& itRtdAssociated : m_remDev)
         {
-            std::list<double> sinrsPerBeam; // vector in which we will save sinr per each RRD beam
-            std::list<double> snrsPerBeam;  // vector in which we will save snr per each RRD beam
-
-            //"Associate" UE (RemPoint) with this RTD
-            for (auto& itRtdAssociated : m_remDev)
+            // configure RRD (RemPoint) beam toward RTD (itRtdAssociated)
+            ConfigureDirectPathBfv(m_rrd, itRtdAssociated, m_rrd.antenna);
+            // configure RTD (itRtdAssociated) beam toward RRD (RemPoint)
+            ConfigureDirectPathBfv(itRtdAssociated, m_rrd, itRtdAssociated.antenna);
+
+            // the row of the associated RTD holds the useful signal from the RRD, the
+            // other rows the interference from the other RTDs
+            std::size_t rtdIndex = 0;
+            for (auto& itRtdInterferer : m_remDev)
             {
-                // configure RRD (RemPoint) beam toward RTD (itRtdAssociated)
-                ConfigureDirectPathBfv(m_rrd, itRtdAssociated, m_rrd.antenna);
-                // configure RTD (itRtdAssociated) beam toward RRD (RemPoint)
-                ConfigureDirectPathBfv(itRtdAssociated, m_rrd, itRtdAssociated.antenna);
+                if (rtdIndex != associatedIndex)
+                {
+                    // configure RTD (itRtdInterferer) beam toward RTD (itRtdAssociated)
+                    ConfigureDirectPathBfv(itRtdInterferer,
+                                           itRtdAssociated,
+                                           itRtdInterferer.antenna);
+
+                    // calculate received power (interference) from the current RTD device
+                    StoreRxPower(rtdIndex,
+                                 *CalcRxPsdValue(itRtdInterferer, itRtdAssociated, propModels));
+                }
+                else
+                {
+                    // calculate received power (useful Signal) from the current RRD device
+                    StoreRxPower(rtdIndex, *CalcRxPsdValue(m_rrd, itRtdAssociated, propModels));
+                }
+                ++rtdIndex;
 
-                std::list<Ptr<SpectrumValue>> interferenceSignalsRxPsds;
-                Ptr<SpectrumValue> usefulSignalRxPsd;
+            } // end for std::list<RemDev>::iterator itRtdInterferer (RTD)
 
-                for (auto& itRtdInterferer : m_remDev)
-                {
-                    if (itRtdAssociated.dev->GetNode()->GetId() !=
-                        itRtdInterferer.dev->GetNode()->GetId())
-                    {
-                        // configure RTD (itRtdInterferer) beam toward RTD (itRtdAssociated)
-                        ConfigureDirectPathBfv(itRtdInterferer,
-                                               itRtdAssociated,
-                                               itRtdInterferer.antenna);
-
-                        // calculate received power (interference) from the current RTD device
-                        Ptr<SpectrumValue> receivedPower =
-                            CalcRxPsdValue(itRtdInterferer, itRtdAssociated);
-
-                        interferenceSignalsRxPsds.push_back(receivedPower); // interference
-                    }
-                    else
-                    {
-                        // calculate received power (useful Signal) from the current RRD device
-                        Ptr<SpectrumValue> receivedPower = CalcRxPsdValue(m_rrd, itRtdAssociated);
-                        if (usefulSignalRxPsd != nullptr)
-                        {
-                            NS_FATAL_ERROR("Already assigned usefulSignal!");
-                        }
-                        usefulSignalRxPsd = receivedPower;
-                    }
-
-                } // end for std::list<RemDev>::iterator itRtdInterferer (RTD)
-
-                sinrsPerBeam.push_back(CalculateSinr(usefulSignalRxPsd, interferenceSignalsRxPsds));
-                snrsPerBeam.push_back(CalculateSnr(usefulSignalRxPsd));
-
-            } // end for std::list<RemDev>::iterator itRtdAssociated (RTD)
-
-            sumSnr += GetMaxValue(snrsPerBeam);
-            sumSinr += GetMaxValue(sinrsPerBeam);
-
-        } // end for m_numOfIterationsToAverage  (Average)
-
-        itRemPoint.avgSnrDb = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
-        itRemPoint.avgSinrDb = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
+            ReduceRxPowerMatrix();
+            maxSnr = std::max(maxSnr, m_reduction.snrDb[associatedIndex]);
+            maxSinr = std::max(maxSinr, m_reduction.sinrDb[associatedIndex]);
+            // the serving RTD is the one with the best SINR
+            m_rtdScore[associatedIndex] += m_reduction.sinrDb[associatedIndex];
+            ++associatedIndex;
 
-        if (++remPointCounter == remSizeNextReport)
-        {
-            PrintProgressReport(&remSizeNextReport);
-        }
+        } // end for std::list<RemDev>::iterator itRtdAssociated (RTD)
 
-    } // end for std::list<RemPoint>::iterator  (RemPoints)
+        sumSnr += maxSnr;
+        sumSinr += maxSinr;
 
-    auto remEndTime = std::chrono::system_clock::now();
-    std::chrono::duration<double> remElapsedSeconds = remEndTime - m_remStartTime;
-    NS_LOG_INFO("REM map created. Total time needed to create the REM map:"
-                << remElapsedSeconds.count() / 60 << " minutes.");
+    } // end for m_numOfIterationsToAverage  (Average)
+
+    m_rem.avgSnrDb[p] = sumSnr / static_cast<double>(m_numOfIterationsToAverage);
+    m_rem.avgSinrDb[p] = sumSinr / static_cast<double>(m_numOfIterationsToAverage);
 }
 
 NrRadioGeoEnvironmentMapHelper::PropagationModels
@@ -1519,13 +1612,12 @@ NrRadioGeoEnvironmentMapHelper::CreateTemporalPropagationModels() const
         m_channelConditionModelFactory.Create<ChannelConditionModel>();
 
     // create rem copy of propagation model
-    ObjectFactory propLossModelFactory = ConfigureObjectFactory(m_propagationLossModel);
     propModels.remPropagationLossModelCopy =
-        propLossModelFactory.Create<ThreeGppPropagationLossModel>();
+        m_propagationLossModelFactory.Create<ThreeGppPropagationLossModel>();
     propModels.remPropagationLossModelCopy->SetChannelConditionModel(condModelCopy);
 
     // create rem copy of spectrum loss model
-    ObjectFactory spectrumLossModelFactory = ConfigureObjectFactory(m_phasedArraySpectrumLossModel);
+    ObjectFactory spectrumLossModelFactory = m_spectrumLossModelFactory;
     if (spectrumLossModelFactory.IsTypeIdSet())
     {
         Ptr<MatrixBasedChannelModel> channelModelCopy =
@@ -1605,20 +1697,29 @@ NrRadioGeoEnvironmentMapHelper::PrintRemToFile()
         return;
     }
 
-    for (auto& it : m_rem)
+    RemPlyWriter plyWriter(m_rem.Size());
+    for (std::size_t p = 0; p < m_rem.Size(); ++p)
     {
         // Convert back to Geo for printing: X=Lat, Y=Lon, Z=Alt
         Vector geo =
-            GeographicPositions::CartesianToGeographicCoordinates(it.pos,
+            GeographicPositions::CartesianToGeographicCoordinates(m_rem.pos[p],
                                                                   GeographicPositions::SPHERE);
         // Print Lon (geo.y) first, then Lat (geo.x)
-        outFile << geo.y << "\t" << geo.x << "\t" << geo.z << "\t" << it.avgSnrDb << "\t"
-                << it.avgSinrDb << "\t" << it.avRxPowerDbm << "\t" << it.avgSirDb << "\t"
-                << std::endl;
+        outFile << geo.y << "\t" << geo.x << "\t" << geo.z << "\t" << m_rem.avgSnrDb[p] << "\t"
+                << m_rem.avgSinrDb[p] << "\t" << m_rem.avRxPowerDbm[p] << "\t"
+                << m_rem.avgSirDb[p] << "\t"
+                << "\n";
+        plyWriter.Add(geo.y, geo.x, geo.z, m_rem.avgSinrDb[p]);
     }
 
     outFile.close();
 
+    std::string plyError;
+    if (!plyWriter.Write(RemPlyWriter::GetPlyFileName(outputFile), plyError))
+    {
+        NS_LOG_ERROR("Can't write PLY file for " << outputFile << ": " << plyError);
+    }
+
     Finalize();
 }
 
@@ -1655,19 +1756,88 @@ NrRadioGeoEnvironmentMapHelper::PrintGeocentricRemToFile()
     // Header: X Y Z SNR SINR RxPwr SIR Lat Lon Alt
     // Format: X \t Y \t Z \t SNR \t SINR \t RxPwr \t SIR \t Lat \t Lon \t Alt
 
-    for (auto& it : m_rem)
+    for (std::size_t p = 0; p < m_rem.Size(); ++p)
     {
-        // it.pos is already in ECEF (Geocentric) coordinates
+        // pos is already in ECEF (Geocentric) coordinates
+        const Vector& pos = m_rem.pos[p];
 
         // Calculate Lat/Lon/Alt for this point
         Vector geo =
-            GeographicPositions::CartesianToGeographicCoordinates(it.pos,
+            GeographicPositions::CartesianToGeographicCoordinates(pos,
                                                                   GeographicPositions::SPHERE);
 
-        outFile << it.pos.x << "\t" << it.pos.y << "\t" << it.pos.z << "\t" << it.avgSnrDb << "\t"
-                << it.avgSinrDb << "\t" << it.avRxPowerDbm << "\t" << it.avgSirDb << "\t" << geo.x
-                << "\t" << geo.y << "\t" << geo.z // Latitude, Longitude, Altitude
-                << std::endl;
+        outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t" << m_rem.avgSnrDb[p] << "\t"
+                << m_rem.avgSinrDb[p] << "\t" << m_rem.avRxPowerDbm[p] << "\t"
+                << m_rem.avgSirDb[p] << "\t" << geo.x << "\t" << geo.y << "\t"
+                << geo.z // Latitude, Longitude, Altitude
+                << "\n";
+    }
+
+    outFile.close();
+}
+
+void
+NrRadioGeoEnvironmentMapHelper::PrintRemTilesToFile()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::ostringstream oss;
+    oss << "nr-rem-" << m_simTag.c_str() << "-tiles.out";
+
+    std::ofstream outFile;
+    std::string outputFile = oss.str();
+    outFile.open(outputFile.c_str());
+
+    if (!outFile.is_open())
+    {
+        NS_FATAL_ERROR("Can't open file " << (outputFile));
+        return;
+    }
+
+    // Format: MinLon \t MinLat \t MaxLon \t MaxLat \t Level \t SNR \t SINR \t RxPwr \t SIR \t
+    // BestRtd, where values are the average of the corners of the tile, except BestRtd that is
+    // the one of its first valid corner
+    const double fineLonStep = m_lonStep / (1U << m_maxRefinementLevel);
+    const double fineLatStep = m_latStep / (1U << m_maxRefinementLevel);
+    for (const auto& tile : m_remTiles)
+    {
+        double snr = 0;
+        double sinr = 0;
+        double rxPower = 0;
+        double sir = 0;
+        uint32_t corners = 0;
+        std::size_t first = NO_REM_POINT;
+        for (auto p : tile.corners)
+        {
+            if (p != NO_REM_POINT)
+            {
+                if (corners == 0)
+                {
+                    first = p;
+                }
+                snr += m_rem.avgSnrDb[p];
+                sinr += m_rem.avgSinrDb[p];
+                rxPower += m_rem.avRxPowerDbm[p];
+                sir += m_rem.avgSirDb[p];
+                ++corners;
+            }
+        }
+        if (corners == 0)
+        {
+            continue;
+        }
+
+        uint16_t level = m_maxRefinementLevel;
+        for (uint32_t size = tile.size; size > 1; size /= 2)
+        {
+            --level;
+        }
+
+        outFile << m_minLon + tile.i * fineLonStep << "\t" << m_minLat + tile.j * fineLatStep
+                << "\t" << m_minLon + (tile.i + tile.size) * fineLonStep << "\t"
+                << m_minLat + (tile.j + tile.size) * fineLatStep << "\t" << level << "\t"
+                << snr / corners << "\t" << sinr / corners << "\t" << rxPower / corners << "\t"
+                << sir / corners << "\t" << m_rem.bestRtd[first] << "\n";
     }
 
     outFile.close();
@@ -17,8 +17,11 @@
 #include "ns3/three-gpp-propagation-loss-model.h"
 #include "ns3/three-gpp-spectrum-propagation-loss-model.h"
 
+#include <array>
 #include <chrono>
 #include <fstream>
+#include <limits>
+#include <map>
 
 namespace ns3
 {
@@ -287,6 +290,22 @@ class NrRadioGeoEnvironmentMapHelper : public Object
                    uint8_t bwpId = 0,
                    bool isDl = true);
 
+    /**
+     * @brief Calculate the SINR of every UE toward every gNB at the current time.
+     *
+     * Device descriptors and propagation models are resolved once for the whole batch,
+     * instead of once per pair as when calling GetSinr repeatedly.
+     * @param ueDevices The UE devices
+     * @param gnbDevices The gNB devices
+     * @param bwpId The Bandwidth Part ID
+     * @param isDl True for Downlink (gNB->UE), False for Uplink (UE->gNB)
+     * @return The SINR in dB, indexed as [ue][gnb]
+     */
+    std::vector<std::vector<double>> GetSinrMatrix(const NetDeviceContainer& ueDevices,
+                                                   const NetDeviceContainer& gnbDevices,
+                                                   uint8_t bwpId = 0,
+                                                   bool isDl = true);
+
     /**
      * @brief Configure the list of interfering devices for GetSinr.
      * @param interferers The container of interfering devices
@@ -296,16 +315,64 @@ class NrRadioGeoEnvironmentMapHelper : public Object
 
   private:
     /**
-     * @brief This struct includes the coordinates of each Rem Point
-     * and the SNR/SINR/IPSD values as resulted from the calculations
+     * @brief This struct includes the coordinates of the Rem Points and the
+     * SNR/SINR/IPSD values as resulted from the calculations, each one stored
+     * in a contiguous array indexed by Rem Point
      */
-    struct RemPoint
+    struct RemGrid
     {
-        Vector pos{0, 0, 0};
-        double avgSnrDb{0};
-        double avgSinrDb{0};
-        double avgSirDb{0};
-        double avRxPowerDbm{0};
+        std::vector<Vector> pos;
+        std::vector<double> avgSnrDb;
+        std::vector<double> avgSinrDb;
+        std::vector<double> avgSirDb;
+        std::vector<double> avRxPowerDbm;
+        std::vector<uint32_t> bestRtd;
+
+        std::size_t Size() const
+        {
+            return pos.size();
+        }
+
+        void Add(const Vector& point)
+        {
+            pos.push_back(point);
+            avgSnrDb.push_back(0);
+            avgSinrDb.push_back(0);
+            avgSirDb.push_back(0);
+            avRxPowerDbm.push_back(0);
+            bestRtd.push_back(0);
+        }
+    };
+
+    /**
+     * @brief A square tile of an adaptive REM. Coordinates and size are
+     * expressed in steps of the finest lattice, i.e., the coarse grid step
+     * divided by 2^MaxRefinementLevel
+     */
+    struct RemTile
+    {
+        uint32_t i;                           ///< Longitude index of the lower-left corner
+        uint32_t j;                           ///< Latitude index of the lower-left corner
+        uint32_t size;                        ///< Side of the tile
+        std::array<std::size_t, 4> corners{}; ///< Rem Point index of each corner
+    };
+
+    /// Rem Point index of a tile corner that is not evaluated (e.g., a RTD position)
+    static constexpr std::size_t NO_REM_POINT = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief This struct includes the metrics obtained from the received power
+     * matrix of a Rem Point, considering each RTD as the useful signal and all
+     * the other RTDs as interferers
+     */
+    struct RxPowerReduction
+    {
+        std::vector<double> snrDb;   ///< SNR of each RTD, in dB
+        std::vector<double> sinrDb;  ///< SINR of each RTD against the others, in dB
+        std::vector<double> sirDb;   ///< SIR of each RTD against the others, in dB
+        std::vector<double> rxPower; ///< Received power of each RTD, in W
+        std::size_t strongestRtd{0}; ///< Index of the RTD with the highest received power
+        double aggregatedRxPower{0}; ///< Received power summed over all the RTDs, in W
     };
 
     /**
@@ -323,6 +390,9 @@ class NrRadioGeoEnvironmentMapHelper : public Object
         double frequency{0};
         uint16_t numerology{0};
         Ptr<const SpectrumModel> spectrumModel{};
+        Ptr<const SpectrumValue> txPsd{}; ///< TX PSD over all RBs, built once per device
+        /// TX PSD converted to the spectrum model of each receiver, keyed by model UID
+        std::map<SpectrumModelUid_t, Ptr<const SpectrumValue>> convertedTxPsd{};
 
         RemDevice()
         {
@@ -338,6 +408,27 @@ class NrRadioGeoEnvironmentMapHelper : public Object
 
             mob = node->GetObject<GeocentricMobilityModel>();
         }
+
+        /**
+         * Describe an existing node, using its live mobility model instead of a private copy
+         */
+        explicit RemDevice(const Ptr<Node>& existingNode)
+            : node(existingNode),
+              mob(existingNode->GetObject<GeocentricMobilityModel>())
+        {
+        }
+    };
+
+    /**
+     * @brief This struct caches the REM descriptor of a simulated device, so that
+     * GetSinr does not have to copy its antenna at each call
+     */
+    struct RemDeviceCacheEntry
+    {
+        RemDevice device;
+        Ptr<NrPhy> phy;
+        std::string antennaSignature; ///< Serialized attributes of the copied antenna
+        PhasedArrayModel::ComplexVector beamformingVector; ///< BF vector of the copied antenna
     };
 
     /**
@@ -357,6 +448,13 @@ class NrRadioGeoEnvironmentMapHelper : public Object
      */
     void CreateListOfRemPoints();
 
+    /**
+     * @brief Check whether a position is occupied by one of the RTDs
+     * @param pos the position to check
+     * @return true if a RTD is placed in pos, false otherwise
+     */
+    bool IsRtdPosition(const Vector& pos) const;
+
     /**
      * @brief Configures the REM Receiving Device (RRD)
      */
@@ -387,72 +485,125 @@ class NrRadioGeoEnvironmentMapHelper : public Object
                                           const Ptr<NetDevice>& rrdDevice);
 
     /**
-     * @brief This function generates a BeamShape map. Using the configuration
-     * of antennas as have been set in the user scenario script, it calculates
-     * the SNR/SINR/IPSD.
+     * @brief This function evaluates every Rem Point of the uniform grid
+     * created by CreateListOfRemPoints.
+     */
+    void CalcUniformRemMap();
+
+    /**
+     * @brief This function generates an adaptive REM. Tiles of the coarse grid
+     * defined by XRes/YRes are recursively split in four, up to MaxRefinementLevel
+     * times, whenever their corners are served by different RTDs or their SINR
+     * varies more than RefinementThreshold. Corners are evaluated once and shared
+     * among neighbouring tiles, and the final tiles are stored in m_remTiles.
+     */
+    void CalcAdaptiveRemMap();
+
+    /**
+     * @brief Check whether an adaptive REM tile has to be split further
+     * @param tile the tile, whose corners have already been evaluated
+     * @return true if the tile has to be refined, false otherwise
+     */
+    bool NeedsRefinement(const RemTile& tile) const;
+
+    /**
+     * @brief This function calculates the values of a Rem Point according to
+     * the REM mode, and records the RTD that serves it.
+     * @param p the index of the Rem Point
+     */
+    void CalcRemPoint(std::size_t p);
+
+    /**
+     * @brief This function calculates a Rem Point of a BeamShape map. Using the
+     * configuration of antennas as have been set in the user scenario script, it
+     * calculates the SNR/SINR/IPSD.
+     * @param p the index of the Rem Point
      */
-    void CalcBeamShapeRemMap();
+    void CalcBeamShapeRemPoint(std::size_t p);
 
     /**
-     * @brief This function generates a CoverageArea map. In this case, all the
-     * antennas of the rtds are set to point towards the rem point and the antenna
-     * of the rem point towards each rtd device.
+     * @brief This function calculates a Rem Point of a CoverageArea map. In this
+     * case, all the antennas of the rtds are set to point towards the rem point
+     * and the antenna of the rem point towards each rtd device.
+     * @param p the index of the Rem Point
      */
-    void CalcCoverageAreaRemMap();
+    void CalcCoverageAreaRemPoint(std::size_t p);
 
     /**
-     * @brief This function generates a Ue Coverage map that depicts the SNR of
-     * this UE with respect to its UL transmission towards the gNB form various
-     * points on the map.
+     * @brief This function calculates a Rem Point of a Ue Coverage map that
+     * depicts the SNR of this UE with respect to its UL transmission towards the
+     * gNB form various points on the map.
      * An additional SINR map is also generated that can be used in mixed TDD/FDD
      * scenarios considering interference from neighbor gNBs that transmit in DL.
+     * @param p the index of the Rem Point
+     */
+    void CalcUeCoverageRemPoint(std::size_t p);
+
+    /**
+     * @brief Get the TX PSD of a device expressed in the spectrum model of the receiver.
+     *
+     * The TX PSD and its conversions do not depend on positions, hence they are built on
+     * first use and cached in the device descriptor.
+     * @param device the transmitting device
+     * @param otherDevice the receiving device
+     * @return The TX PSD in the spectrum model of otherDevice
      */
-    void CalcUeCoverageRemMap();
+    Ptr<const SpectrumValue> GetTxPsd(RemDevice& device, const RemDevice& otherDevice) const;
 
     /**
      * @brief This method calculates the PSD
+     * @param device the transmitting device
+     * @param otherDevice the receiving device
+     * @param propModels the propagation models of the current REM point and iteration
      * @return The PSD (spectrumValue)
      */
-    Ptr<SpectrumValue> CalcRxPsdValue(RemDevice& device, RemDevice& otherDevice) const;
+    Ptr<SpectrumValue> CalcRxPsdValue(RemDevice& device,
+                                      RemDevice& otherDevice,
+                                      const PropagationModels& propModels) const;
 
     /**
-     * @brief This function calculates the SNR.
-     * @param usefulSignal The useful Signal
-     * @return The snr
+     * @brief Get the cached REM descriptor of a simulated device, creating it or
+     * refreshing it if its antenna has changed since the last call.
+     * @param device the NR UE or gNB net device
+     * @param bwpId the Bandwidth Part ID
+     * @return The cache entry of the device
      */
-    double CalculateSnr(const Ptr<SpectrumValue>& usefulSignal) const;
+    RemDeviceCacheEntry& GetRemDevice(const Ptr<NetDevice>& device, uint8_t bwpId);
 
     /**
-     * @brief This function finds the max value in a space of frequency-dependent
-     * values (such as PSD).
-     * @param values The list of spectrumValues for which we want to find the max
-     * @return The max spectrumValue
+     * @brief Serialize the attributes of an antenna that affect its radiation pattern.
+     * @param antenna the antenna
+     * @return The serialized attributes
      */
-    Ptr<SpectrumValue> GetMaxValue(const std::list<Ptr<SpectrumValue>>& values) const;
+    std::string GetAntennaSignature(const Ptr<const UniformPlanarArray>& antenna) const;
 
     /**
-     * @brief This function finds the max value in a space of frequency-dependent
-     * values (such as PSD).
-     * @param values The list of spectrumValues for which we want to find the max
-     * @return The max value (snr)
+     * @brief Configure propagation model factories and noise PSD on the first SINR request.
+     * @param uePhy the phy of the UE
+     * @param gnbPhy the phy of the gNB
+     * @param isDl True for Downlink (gNB->UE), False for Uplink (UE->gNB)
      */
-    double CalculateMaxSnr(const std::list<Ptr<SpectrumValue>>& receivedPowerList) const;
+    void PrepareSinrCalculation(const Ptr<NrPhy>& uePhy, const Ptr<NrPhy>& gnbPhy, bool isDl);
 
     /**
-     * @brief This function finds the max value in a space of frequency-dependent
-     * values (such as PSD).
-     * @param values The list of spectrumValues for which we want to find the max
-     * @return The max value (sinr)
+     * @brief Calculate the SINR of a UE-gNB link against the configured interferers.
+     * @param ue the UE descriptor
+     * @param gnb the gNB descriptor
+     * @param isDl True for Downlink (gNB->UE), False for Uplink (UE->gNB)
+     * @param propModels the propagation models shared by the links of this evaluation
+     * @return The SINR in dB
      */
-    double CalculateMaxSinr(const std::list<Ptr<SpectrumValue>>& receivedPowerList) const;
+    double CalcLinkSinr(RemDevice& ue,
+                        RemDevice& gnb,
+                        bool isDl,
+                        const PropagationModels& propModels);
 
     /**
-     * @brief This function finds the max value in a space of frequency-dependent
-     * values (such as PSD).
-     * @param values The list of spectrumValues for which we want to find the max
-     * @return The max value (sinr)
+     * @brief This function calculates the SNR.
+     * @param usefulSignal The useful Signal
+     * @return The snr
      */
-    double CalculateMaxSir(const std::list<Ptr<SpectrumValue>>& receivedPowerList) const;
+    double CalculateSnr(const Ptr<SpectrumValue>& usefulSignal) const;
 
     /**
      * @brief This function calculates the SINR for a given space of frequency-dependent
@@ -465,34 +616,23 @@ class NrRadioGeoEnvironmentMapHelper : public Object
                          const std::list<Ptr<SpectrumValue>>& interferenceSignals) const;
 
     /**
-     * @brief This function calculates the SIR for a given space of frequency-dependent
-     * values (such as PSD).
-     * @param usefulSignal The spectrumValue considered as useful signal
-     * @param interferenceSignals The list of spectrumValues considered as interference
-     * @return The max value (sir)
-     */
-    double CalculateSir(const Ptr<SpectrumValue>& usefulSignal,
-                        const std::list<Ptr<SpectrumValue>>& interferenceSignals) const;
-
-    /**
-     * @brief This function finds the max value in a list of double values.
-     * @param values The list of double values
-     * @return The max value
+     * @brief Allocate the received power matrix [RTD x RB] and the buffers used
+     * to reduce it, once RRD and RTDs have been configured.
      */
-    double GetMaxValue(const std::list<double>& listOfValues) const;
+    void InitRxPowerMatrix();
 
     /**
-     * @brief This function returns the integral of the sum of the elements of a
-     * list of SpectrumValues
-     * @return The integral of the sum of the elements of the list
+     * @brief Store the received PSD of an RTD in its row of the received power matrix.
+     * @param rtdIndex the row of the RTD
+     * @param rxPsd the received PSD, in the spectrum model of the receiver
      */
-    double CalculateAggregatedIpsd(const std::list<Ptr<SpectrumValue>>& interferenceSignals);
+    void StoreRxPower(std::size_t rtdIndex, const SpectrumValue& rxPsd);
 
     /**
-     * @brief This function returns the sum of the elements of a list of double values
-     * @return The sum of the elements of the list
+     * @brief Compute SNR, SINR, SIR and received power of every RTD from the
+     * received power matrix in a single pass, storing them in m_reduction.
      */
-    double SumListElements(const std::list<double>& listOfValues);
+    void ReduceRxPowerMatrix();
 
     /**
      * @brief Configures propagation loss model factories
@@ -509,7 +649,7 @@ class NrRadioGeoEnvironmentMapHelper : public Object
     /**
      * @brief This method creates the temporal Propagation Models
      * @return The struct with the temporal propagation models (created for each
-     * rem point)
+     * rem point and averaging iteration, and shared by all the links evaluated in it)
      */
     PropagationModels CreateTemporalPropagationModels() const;
 
@@ -545,6 +685,12 @@ class NrRadioGeoEnvironmentMapHelper : public Object
      */
     void PrintGeocentricRemToFile();
 
+    /**
+     * @brief this method prints the tiles of an adaptive REM, along with the
+     * SNR/SINR/IPSD/SIR values averaged on their corners and the serving RTD.
+     */
+    void PrintRemTilesToFile();
+
     /**
      * @brief Called when the map generation procedure has been completed.
      */
@@ -566,8 +712,17 @@ class NrRadioGeoEnvironmentMapHelper : public Object
                                 const RemDevice& otherDevice,
                                 const Ptr<const UniformPlanarArray>& antenna);
 
-    std::list<RemDevice> m_remDev; ///< List of REM Transmitting Devices (RTDs).
-    std::list<RemPoint> m_rem;     ///< List of REM points.
+    std::list<RemDevice> m_remDev;   ///< List of REM Transmitting Devices (RTDs).
+    RemGrid m_rem;                   ///< REM points.
+    std::vector<RemTile> m_remTiles; ///< Tiles of the adaptive REM.
+
+    std::vector<double> m_rxPowerMatrix; ///< Received power [RTD x RB] at the current point
+    std::vector<double> m_interference;  ///< Interference [RTD x RB] seen by each RTD
+    std::vector<double> m_prefixRxPower; ///< Running sum over RTDs of the received power per RB
+    std::vector<double> m_noise;         ///< Noise power per RB
+    std::vector<double> m_rbWidths;      ///< Width of each RB, in Hz
+    RxPowerReduction m_reduction;        ///< Metrics of the current received power matrix
+    std::vector<double> m_rtdScore;      ///< Score of each RTD as server of the current point
 
     std::chrono::system_clock::time_point
         m_remStartTime; //!< Time at which REM generation has started
@@ -588,6 +743,8 @@ class NrRadioGeoEnvironmentMapHelper : public Object
     uint16_t m_numOfIterationsToAverage{1};
     Time m_installationDelay{Seconds(0)};
     bool m_logGeocentricRem{false};
+    uint16_t m_maxRefinementLevel{0};    ///< The `MaxRefinementLevel` attribute.
+    double m_refinementThresholdDb{3.0}; ///< The `RefinementThreshold` attribute.
 
 public:
     /**
@@ -610,11 +767,15 @@ private:
     std::map<const Ptr<NetDevice>, Ptr<NrPhy>>
         m_rtdDeviceToPhy; ///< Map for storing the phy of each RTD device
     std::map<const Ptr<NetDevice>, Ptr<UniformPlanarArray>> m_deviceToAntenna;
+    /// REM descriptors of the devices queried through GetSinr, keyed by device and bwpId
+    std::map<std::pair<Ptr<NetDevice>, uint8_t>, RemDeviceCacheEntry> m_remDeviceCache;
 
     Ptr<PropagationLossModel> m_propagationLossModel;
     Ptr<PhasedArraySpectrumPropagationLossModel> m_phasedArraySpectrumLossModel;
     ObjectFactory m_channelConditionModelFactory;
     ObjectFactory m_matrixBasedChannelModelFactory;
+    ObjectFactory m_propagationLossModelFactory;
+    ObjectFactory m_spectrumLossModelFactory;
 
     Ptr<SpectrumValue> m_noisePsd; // noise figure PSD that will be used for calculations
 
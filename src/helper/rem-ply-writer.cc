@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "rem-ply-writer.h"
+
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+RemPlyWriter::RemPlyWriter(std::size_t expectedPoints)
+{
+    m_vertices.reserve(expectedPoints * 4);
+}
+
+void
+RemPlyWriter::Add(double x, double y, double z, double intensity)
+{
+    m_vertices.push_back(static_cast<float>(x));
+    m_vertices.push_back(static_cast<float>(y));
+    m_vertices.push_back(static_cast<float>(z));
+    m_vertices.push_back(static_cast<float>(intensity));
+}
+
+std::size_t
+RemPlyWriter::GetN() const
+{
+    return m_vertices.size() / 4;
+}
+
+void
+RemPlyWriter::Clear()
+{
+    m_vertices.clear();
+}
+
+bool
+RemPlyWriter::Write(const std::string& filename, std::string& error) const
+{
+    std::ofstream out(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out.is_open())
+    {
+        error = "Can't open file " + filename;
+        return false;
+    }
+
+    out << "ply\n"
+        << "format binary_little_endian 1.0\n"
+        << "element vertex " << GetN() << "\n"
+        << "property float x\n"
+        << "property float y\n"
+        << "property float z\n"
+        << "property float intensity\n"
+        << "end_header\n";
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        out.write(reinterpret_cast<const char*>(m_vertices.data()),
+                  m_vertices.size() * sizeof(float));
+    }
+    else
+    {
+        std::vector<char> buffer(m_vertices.size() * sizeof(float));
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            char* dst = buffer.data() + i * sizeof(float);
+            std::memcpy(dst, &m_vertices[i], sizeof(float));
+            std::reverse(dst, dst + sizeof(float));
+        }
+        out.write(buffer.data(), buffer.size());
+    }
+
+    if (!out.good())
+    {
+        error = "Can't write file " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool
+RemPlyWriter::ConvertFromText(const std::string& txtFile,
+                              uint32_t intensityColumn,
+                              std::string& error)
+{
+    NS_ASSERT_MSG(intensityColumn >= 3, "Intensity column cannot overlap with coordinates");
+
+    std::ifstream in(txtFile);
+    if (!in.is_open())
+    {
+        error = "Can't open file " + txtFile;
+        return false;
+    }
+
+    RemPlyWriter writer;
+    std::vector<double> columns(intensityColumn + 1);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        for (auto& c : columns)
+        {
+            if (!(iss >> c))
+            {
+                error = "Malformed line in " + txtFile + ": " + line;
+                return false;
+            }
+        }
+
+        writer.Add(columns[0], columns[1], columns[2], columns[intensityColumn]);
+    }
+
+    return writer.Write(GetPlyFileName(txtFile), error);
+}
+
+std::string
+RemPlyWriter::GetPlyFileName(const std::string& file)
+{
+    const auto dot = file.find_last_of('.');
+    const auto slash = file.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return file + ".ply";
+    }
+
+    return file.substr(0, dot) + ".ply";
+}
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REM_PLY_WRITER_H
+#define REM_PLY_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Accumulate Radio Environment Map samples and store them as a binary PLY point cloud.
+ *
+ * Each vertex carries the float properties x, y, z and intensity, matching the layout
+ * historically produced by analysis/txt2ply.py, but encoded as binary_little_endian so that
+ * large maps are written with a single buffered write instead of a text round-trip.
+ */
+class RemPlyWriter
+{
+  public:
+    /**
+     * \brief Default constructor.
+     *
+     * \param expectedPoints number of vertices to reserve room for.
+     */
+    explicit RemPlyWriter(std::size_t expectedPoints = 0);
+
+    /**
+     * \brief Append a vertex to the point cloud.
+     */
+    void Add(double x, double y, double z, double intensity);
+
+    /**
+     * \return the number of vertices collected so far.
+     */
+    std::size_t GetN() const;
+
+    /**
+     * \brief Drop all the collected vertices.
+     */
+    void Clear();
+
+    /**
+     * \brief Write the collected vertices to a binary PLY file.
+     *
+     * Nothing is logged, so that files can be written by worker threads: the reason of a
+     * failure is returned to the caller instead.
+     *
+     * \param filename path of the .ply file to be created.
+     * \param error set to the reason of the failure, if any.
+     * \return true if the file has been written successfully.
+     */
+    bool Write(const std::string& filename, std::string& error) const;
+
+    /**
+     * \brief Convert a tab-separated REM text output into a binary PLY file.
+     *
+     * The first three columns are used as coordinates, while the intensity is taken from the
+     * given column. The PLY file is placed next to the source, as returned by GetPlyFileName.
+     * Like Write, it does not log and can run in worker threads.
+     *
+     * \param txtFile path of the text REM.
+     * \param intensityColumn zero-based index of the column to be used as intensity.
+     * \param error set to the reason of the failure, if any.
+     * \return true if the conversion succeeded.
+     */
+    static bool ConvertFromText(const std::string& txtFile,
+                                uint32_t intensityColumn,
+                                std::string& error);
+
+    /**
+     * \return the given path with its extension replaced by ".ply".
+     */
+    static std::string GetPlyFileName(const std::string& file);
+
+  private:
+    std::vector<float> m_vertices; ///< Interleaved x, y, z, intensity values
+};
+
+} // namespace ns3
+
+#endif /* REM_PLY_WRITER_H */
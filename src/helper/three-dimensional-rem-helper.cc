@@ -21,25 +21,43 @@
 #include "three-dimensional-rem-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
+#include <ns3/building-index.h>
+#include <ns3/building-list.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/component-carrier-enb.h>
 #include <ns3/config.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/node-list.h>
 #include <ns3/node.h>
+#include <ns3/object-factory.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-signal-parameters.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <numeric>
+#include <thread>
 
 namespace ns3
 {
@@ -177,7 +195,20 @@ ThreeDimensionalRemHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&ThreeDimensionalRemHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("Analytic",
+                          "If true, the SINR of each point is computed directly from the TX PSD "
+                          "of the eNBs and the propagation models of the channel, assuming all "
+                          "the RBs are in use, instead of listening to actual transmissions.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeDimensionalRemHelper::m_analytic),
+                          MakeBooleanChecker())
+            .AddAttribute("NumThreads",
+                          "Number of threads computing the z-slices of an Analytic REM. "
+                          "0 means one per hardware thread.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeDimensionalRemHelper::m_numThreads),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -217,7 +248,7 @@ void
 ThreeDimensionalRemHelper::Install()
 {
     NS_LOG_FUNCTION(this);
-    if (!m_rem.empty())
+    if (!m_rem.empty() || !m_transmitters.empty())
     {
         NS_FATAL_ERROR("only one REM supported per instance of ThreeDimensionalRemHelper");
     }
@@ -260,6 +291,12 @@ ThreeDimensionalRemHelper::DelayedInstall()
     m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
     m_zStep = (m_zMax - m_zMin) / (m_zRes - 1);
 
+    if (m_analytic)
+    {
+        RunAnalytic();
+        return;
+    }
+
     if (((double)m_xRes * (double)m_yRes < (double)m_pointsPerIteration) ||
         !((m_xRes * m_yRes) % m_pointsPerIteration == 0))
     {
@@ -325,6 +362,286 @@ ThreeDimensionalRemHelper::DelayedInstall()
     Simulator::Schedule(Seconds(remIterationStartTime), &ThreeDimensionalRemHelper::Finalize, this);
 }
 
+void
+ThreeDimensionalRemHelper::RunAnalytic()
+{
+    NS_LOG_FUNCTION(this);
+
+    ConfigureTransmitters();
+
+    uint32_t numWorkers = m_numThreads;
+    if (numWorkers == 0)
+    {
+        numWorkers = std::max(1U, std::thread::hardware_concurrency());
+    }
+    numWorkers = std::min<uint32_t>(numWorkers, m_zRes);
+
+    // ns-3 objects are not thread safe: each worker needs its own propagation models and
+    // mobility models. Buildings and spectrum loss models are shared, so keep them sequential.
+    std::vector<Ptr<PropagationLossModel>> propagationLossCopies;
+    if (numWorkers > 1 && !m_spectrumLoss && BuildingList::GetNBuildings() == 0)
+    {
+        for (uint32_t w = 0; w < numWorkers; ++w)
+        {
+            Ptr<PropagationLossModel> copy = CopyPropagationLossModel();
+            if (!copy)
+            {
+                break;
+            }
+            propagationLossCopies.push_back(copy);
+        }
+    }
+    if (propagationLossCopies.size() != numWorkers)
+    {
+        if (numWorkers > 1)
+        {
+            NS_LOG_WARN("The propagation models of the channel cannot be copied for each "
+                        "thread, computing the REM sequentially");
+        }
+        numWorkers = 1;
+        propagationLossCopies.assign(1, m_channel->GetPropagationLossModel());
+    }
+
+    std::vector<AnalyticWorker> workers(numWorkers);
+    for (uint32_t w = 0; w < numWorkers; ++w)
+    {
+        workers[w].propagationLoss = propagationLossCopies[w];
+        for (const auto& tx : m_transmitters)
+        {
+            Ptr<MobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel>();
+            txMobility->SetPosition(tx.mob->GetPosition());
+            Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo>();
+            txMobility->AggregateObject(buildingInfo);
+            buildingInfo->MakeConsistent(txMobility);
+            workers[w].txMobility.push_back(txMobility);
+        }
+        workers[w].rxMobility = CreateObject<ConstantPositionMobilityModel>();
+        workers[w].rxMobility->AggregateObject(CreateObject<MobilityBuildingInfo>());
+    }
+
+    // the workers may query the building index, which must not be rebuilt concurrently
+    BuildingIndex::Update();
+    const auto policy = numWorkers > 1 ? std::launch::async : std::launch::deferred;
+    for (uint32_t zFirst = 0; zFirst < m_zRes; zFirst += numWorkers)
+    {
+        std::vector<std::future<std::vector<RemVoxel>>> slices;
+        for (uint32_t w = 0; w < numWorkers && zFirst + w < m_zRes; ++w)
+        {
+            slices.push_back(std::async(policy,
+                                        &ThreeDimensionalRemHelper::CalcSlice,
+                                        this,
+                                        zFirst + w,
+                                        std::ref(workers[w])));
+        }
+
+        // stream the slices in z order, so that only one wave is kept in memory
+        for (uint32_t w = 0; w < slices.size(); ++w)
+        {
+            std::cout << "Computing SINR for z = " << m_zMin + (zFirst + w) * m_zStep
+                      << std::endl;
+            for (const auto& voxel : slices[w].get())
+            {
+                m_outFile << voxel.pos.x << "\t" << voxel.pos.y << "\t" << voxel.pos.z << "\t"
+                          << voxel.sinr << "\n";
+                m_plyWriter.Add(voxel.pos.x, voxel.pos.y, voxel.pos.z, voxel.sinr);
+            }
+        }
+    }
+
+    Finalize();
+}
+
+void
+ThreeDimensionalRemHelper::ConfigureTransmitters()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<SpectrumModel> remSpectrumModel =
+        LteSpectrumValueHelper::GetSpectrumModel(m_earfcn, m_bandwidth);
+
+    for (auto node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>((*node)->GetDevice(i));
+            if (!enbDev)
+            {
+                continue;
+            }
+
+            for (const auto& [ccId, cc] : enbDev->GetCcMap())
+            {
+                Ptr<LteEnbPhy> phy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+                Ptr<LteSpectrumPhy> dlPhy = phy->GetDownlinkSpectrumPhy();
+                if (dlPhy->GetChannel() != m_channel)
+                {
+                    continue;
+                }
+
+                // control frames span the whole band, data frames are assumed to be full buffer
+                std::vector<int> activeRbs(cc->GetDlBandwidth());
+                std::iota(activeRbs.begin(), activeRbs.end(), 0);
+                Ptr<SpectrumValue> txPsd =
+                    LteSpectrumValueHelper::CreateTxPowerSpectralDensity(cc->GetDlEarfcn(),
+                                                                         cc->GetDlBandwidth(),
+                                                                         phy->GetTxPower(),
+                                                                         activeRbs);
+                if (txPsd->GetSpectrumModelUid() != remSpectrumModel->GetUid())
+                {
+                    SpectrumConverter converter(txPsd->GetSpectrumModel(), remSpectrumModel);
+                    txPsd = converter.Convert(txPsd);
+                }
+
+                RemTransmitter tx;
+                tx.mob = (*node)->GetObject<MobilityModel>();
+                tx.antenna = DynamicCast<AntennaModel>(dlPhy->GetAntenna());
+                tx.phy = dlPhy;
+                tx.txPsd = txPsd;
+                tx.refSignalPower = GetReferenceSignalPower(*txPsd);
+                m_transmitters.push_back(tx);
+            }
+        }
+    }
+    NS_ABORT_MSG_IF(m_transmitters.empty(), "No eNB is transmitting on the REM channel");
+
+    m_spectrumLoss = m_channel->GetSpectrumPropagationLossModel();
+    NS_ABORT_MSG_IF(m_channel->GetPhasedArraySpectrumPropagationLossModel(),
+                    "Phased array spectrum propagation loss models are not supported by the "
+                    "Analytic REM");
+    DoubleValue maxLossDb;
+    m_channel->GetAttribute("MaxLossDb", maxLossDb);
+    m_maxLossDb = maxLossDb.Get();
+}
+
+Ptr<PropagationLossModel>
+ThreeDimensionalRemHelper::CopyPropagationLossModel() const
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<PropagationLossModel> first;
+    Ptr<PropagationLossModel> last;
+    for (Ptr<PropagationLossModel> model = m_channel->GetPropagationLossModel(); model;
+         model = model->GetNext())
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(model->GetInstanceTypeId());
+        for (TypeId tid = model->GetInstanceTypeId();; tid = tid.GetParent())
+        {
+            for (std::size_t i = 0; i < tid.GetAttributeN(); ++i)
+            {
+                TypeId::AttributeInformation info = tid.GetAttribute(i);
+                if (info.checker->GetValueTypeName() == "ns3::PointerValue")
+                {
+                    // the referenced object would be shared among the copies
+                    return nullptr;
+                }
+                if (!(info.flags & TypeId::ATTR_GET) || !(info.flags & TypeId::ATTR_CONSTRUCT))
+                {
+                    continue;
+                }
+                Ptr<AttributeValue> value = info.checker->Create();
+                model->GetAttribute(info.name, *value);
+                factory.Set(info.name, *value);
+            }
+            if (!tid.HasParent())
+            {
+                break;
+            }
+        }
+
+        Ptr<PropagationLossModel> copy = factory.Create<PropagationLossModel>();
+        if (last)
+        {
+            last->SetNext(copy);
+        }
+        else
+        {
+            first = copy;
+        }
+        last = copy;
+    }
+    return first;
+}
+
+std::vector<ThreeDimensionalRemHelper::RemVoxel>
+ThreeDimensionalRemHelper::CalcSlice(uint16_t zIdx, AnalyticWorker& worker) const
+{
+    const double z = m_zMin + zIdx * m_zStep;
+    Ptr<MobilityBuildingInfo> buildingInfo = worker.rxMobility->GetObject<MobilityBuildingInfo>();
+
+    std::vector<RemVoxel> voxels;
+    for (uint16_t xIdx = 0; xIdx < m_xRes; ++xIdx)
+    {
+        for (uint16_t yIdx = 0; yIdx < m_yRes; ++yIdx)
+        {
+            Vector pos(m_xMin + xIdx * m_xStep, m_yMin + yIdx * m_yStep, z);
+            worker.rxMobility->SetPosition(pos);
+            buildingInfo->MakeConsistent(worker.rxMobility);
+
+            // same accounting as RemSpectrumPhy: the strongest eNB is the useful signal
+            double sumPower = 0.0;
+            double refSignalPower = 0.0;
+            for (std::size_t k = 0; k < m_transmitters.size(); ++k)
+            {
+                const RemTransmitter& tx = m_transmitters[k];
+                const Ptr<MobilityModel>& txMobility = worker.txMobility[k];
+
+                // same steps as MultiModelSpectrumChannel::StartTx
+                double pathLossDb = 0.0;
+                if (tx.antenna)
+                {
+                    pathLossDb -= tx.antenna->GetGainDb(Angles(pos, txMobility->GetPosition()));
+                }
+                if (worker.propagationLoss)
+                {
+                    pathLossDb -=
+                        worker.propagationLoss->CalcRxPower(0, txMobility, worker.rxMobility);
+                }
+                if (pathLossDb > m_maxLossDb)
+                {
+                    continue;
+                }
+                const double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+
+                double power = tx.refSignalPower * pathGainLinear;
+                if (m_spectrumLoss)
+                {
+                    Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+                    params->psd = tx.txPsd->Copy();
+                    *(params->psd) *= pathGainLinear;
+                    params->txPhy = tx.phy;
+                    params->txAntenna = tx.antenna;
+                    power = GetReferenceSignalPower(
+                        *m_spectrumLoss->CalcRxPowerSpectralDensity(params,
+                                                                    txMobility,
+                                                                    worker.rxMobility));
+                }
+
+                sumPower += power;
+                refSignalPower = std::max(refSignalPower, power);
+            }
+
+            const double sinr = refSignalPower / (sumPower - refSignalPower + m_noisePower);
+            if (std::isgreaterequal(sinr, m_threshold))
+            {
+                voxels.push_back({pos, sinr});
+            }
+        }
+    }
+    return voxels;
+}
+
+double
+ThreeDimensionalRemHelper::GetReferenceSignalPower(const SpectrumValue& psd) const
+{
+    if (m_rbId == -1)
+    {
+        return Integral(psd);
+    }
+    // 180 kHz per RB, as in RemSpectrumPhy
+    return psd[m_rbId] * 180000;
+}
+
 void
 ThreeDimensionalRemHelper::RunOneIteration(double xMin,
                                            double xMax,
@@ -373,8 +690,9 @@ ThreeDimensionalRemHelper::PrintAndReset()
             Vector pos = it->bmm->GetPosition();
             NS_LOG_LOGIC("output: " << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
                                     << it->phy->GetSinr(m_noisePower));
-            m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
-                      << it->phy->GetSinr(m_noisePower) << std::endl;
+            double sinr = it->phy->GetSinr(m_noisePower);
+            m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t" << sinr << "\n";
+            m_plyWriter.Add(pos.x, pos.y, pos.z, sinr);
         }
         it->phy->Reset();
     }
@@ -385,6 +703,12 @@ ThreeDimensionalRemHelper::Finalize()
 {
     NS_LOG_FUNCTION(this);
     m_outFile.close();
+    std::string plyError;
+    if (!m_plyWriter.Write(RemPlyWriter::GetPlyFileName(m_outputFile), plyError))
+    {
+        NS_LOG_ERROR("Can't write PLY file for " << m_outputFile << ": " << plyError);
+    }
+    m_plyWriter.Clear();
     if (m_stopWhenDone)
     {
         Simulator::Stop();
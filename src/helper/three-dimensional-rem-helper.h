@@ -21,9 +21,13 @@
 #define THREE_DIMENSIONAL_REM_HELPER_H
 
 #include <ns3/object.h>
+#include <ns3/rem-ply-writer.h>
 #include <ns3/rem-spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/vector.h>
 
 #include <fstream>
+#include <vector>
 
 namespace ns3
 {
@@ -32,12 +36,22 @@ class Node;
 class NetDevice;
 class SpectrumChannel;
 class MobilityModel;
+class AntennaModel;
+class SpectrumPhy;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
 
 /**
  * \ingroup lte
  *
  * Generates a 3D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system.
+ *
+ * By default the map is sampled by moving RemSpectrumPhy listeners around and
+ * collecting the frames actually transmitted on the channel. If the `Analytic`
+ * attribute is set, the SINR of each voxel is instead computed directly from
+ * the eNB TX PSDs and the propagation models of the channel, assuming all the
+ * RBs are in use, and the z-slices of the map are computed in parallel.
  */
 class ThreeDimensionalRemHelper : public Object
 {
@@ -108,6 +122,65 @@ class ThreeDimensionalRemHelper : public Object
     /// Set threshold parameter in dB
     void SetThresholdDb(double threshDb);
 
+    /// An eNB transmitting on the DL channel, as seen by the analytic REM.
+    struct RemTransmitter
+    {
+        Ptr<MobilityModel> mob;         ///< Mobility of the eNB
+        Ptr<AntennaModel> antenna;      ///< Antenna of the eNB, if any
+        Ptr<SpectrumPhy> phy;           ///< DL spectrum phy of the eNB
+        Ptr<const SpectrumValue> txPsd; ///< TX PSD in the spectrum model of the REM
+        double refSignalPower;          ///< Reference signal power before any loss, in W
+    };
+
+    /// The state owned by each thread of the analytic REM.
+    struct AnalyticWorker
+    {
+        Ptr<PropagationLossModel> propagationLoss;  ///< Propagation loss model of the channel
+        std::vector<Ptr<MobilityModel>> txMobility; ///< Snapshot of the eNB positions
+        Ptr<MobilityModel> rxMobility;              ///< Position of the current voxel
+    };
+
+    /// A voxel of the analytic REM whose SINR is above the threshold.
+    struct RemVoxel
+    {
+        Vector pos;  ///< Position of the voxel
+        double sinr; ///< Linear SINR of the strongest eNB
+    };
+
+    /**
+     * Compute the whole map without transmitting on the channel. The
+     * z-slices are distributed among the workers in waves and each wave is
+     * streamed to the output as soon as it is completed.
+     */
+    void RunAnalytic();
+
+    /// Collect the eNBs transmitting on the DL channel and build their TX PSDs.
+    void ConfigureTransmitters();
+
+    /**
+     * Copy the propagation loss model chain of the channel, so that each
+     * worker evaluates its own instances.
+     *
+     * \return The copy, or nullptr if the chain holds models that cannot be
+     * copied by attributes (e.g., because they reference other objects).
+     */
+    Ptr<PropagationLossModel> CopyPropagationLossModel() const;
+
+    /**
+     * Compute the SINR of every voxel of a z-slice.
+     *
+     * \param zIdx index of the slice along the z axis.
+     * \param worker the state owned by the calling thread.
+     * \return The voxels whose SINR is above the threshold, in x-major order.
+     */
+    std::vector<RemVoxel> CalcSlice(uint16_t zIdx, AnalyticWorker& worker) const;
+
+    /**
+     * \param psd the PSD received from an eNB.
+     * \return The received power, over all the RBs or only over `RbId`, in W.
+     */
+    double GetReferenceSignalPower(const SpectrumValue& psd) const;
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -165,9 +238,18 @@ class ThreeDimensionalRemHelper : public Object
 
     std::ofstream m_outFile; ///< Stream the output to a file.
 
+    RemPlyWriter m_plyWriter; ///< Binary PLY copy of the output, written on Finalize.
+
     bool m_useDataChannel; ///< The `UseDataChannel` attribute.
     int32_t m_rbId;        ///< The `RbId` attribute.
 
+    bool m_analytic;       ///< The `Analytic` attribute.
+    uint32_t m_numThreads; ///< The `NumThreads` attribute.
+
+    std::vector<RemTransmitter> m_transmitters;       ///< eNBs considered by the analytic REM.
+    Ptr<SpectrumPropagationLossModel> m_spectrumLoss; ///< Spectrum loss model of the channel.
+    double m_maxLossDb;                               ///< Loss above which signals are dropped.
+
 }; // end of `class ThreeDimensionalRemHelper`
 
 } // namespace ns3
@@ -24,9 +24,9 @@
 #include <ns3/angles.h>
 #include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
-#include <ns3/buildings-channel-condition-model.h>
 #include <ns3/double.h>
 #include <ns3/enum.h>
+#include <ns3/indexed-buildings-channel-condition-model.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
 #include <ns3/net-device.h>
@@ -181,8 +181,8 @@ IrsAssistedSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         std::vector<std::vector<double>> d_RG, etav, K_RG;
         std::vector<std::vector<Angles>> a_RG;
         Vector IrsPosition, TxPosition, RxPosition;
-        Ptr<BuildingsChannelConditionModel> condModel =
-            CreateObject<BuildingsChannelConditionModel>();
+        Ptr<IndexedBuildingsChannelConditionModel> condModel =
+            CreateObject<IndexedBuildingsChannelConditionModel>();
 
         const auto n_irs = IrsList::GetN();                 // Number of Irs
         const auto n_users = rxInfo.second.m_rxPhys.size(); // Number of receiving Phy layer
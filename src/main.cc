@@ -70,8 +70,10 @@
 #include <ns3/null-ntn-demo-mac-layer-configuration.h>
 #include <ns3/null-ntn-demo-mac-layer-simulation-helper.h>
 #include <ns3/object-factory.h>
+#include <ns3/position-snapshot.h>
 #include <ns3/ptr.h>
 #include <ns3/radio-environment-map-helper.h>
+#include <ns3/rem-ply-writer.h>
 #include <ns3/remote-list.h>
 #include <ns3/report.h>
 #include <ns3/rng-seed-manager.h>
@@ -96,6 +98,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
@@ -203,6 +206,10 @@ class Scenario
     Ptr<OutputStreamWrapper> m_leoSatTraceStream;
     Ptr<OutputStreamWrapper> m_vehicleTraceStream;
 
+    // Positions of LEO satellites and vehicles, LEO satellites first
+    Ptr<PositionSnapshot> m_positions;
+    uint32_t m_nLeoSatPositions = 0;
+
     // NR gNB and UE tracking for proper attachment
     std::map<uint32_t, std::vector<NetDeviceContainer>> m_nrGnbDevices;
     std::map<uint32_t, std::vector<Ptr<NetDevice>>> m_nrUeDevices;
@@ -215,6 +222,9 @@ class Scenario
 
     // Track active SINR attachment loops to avoid duplicates
     std::set<uint32_t> m_sinrAttachmentRunning;
+
+    // SINR estimators of the attachment loops, kept across evaluations to reuse device state
+    std::map<uint32_t, Ptr<NrRadioGeoEnvironmentMapHelper>> m_sinrAttachmentHelpers;
 };
 
 NS_LOG_COMPONENT_DEFINE("Scenario");
@@ -237,6 +247,7 @@ Scenario::Scenario(int argc, char** argv)
     m_leoSats.Create(CONFIGURATOR->GetN("leo-sats"));
     m_vehicles.Create(CONFIGURATOR->GetN("vehicles"));
     m_backbone.Add(m_remoteNodes);
+    m_positions = CreateObject<PositionSnapshot>();
 
     // Register created entities in their lists
     for (auto drone = m_drones.Begin(); drone != m_drones.End(); drone++)
@@ -330,6 +341,8 @@ Scenario::operator()()
             std::string file;
             std::string type;
             bool is3D;
+            bool nativePly; // the helper already wrote the binary PLY next to the file
+            bool preview;
         };
 
         NS_LOG_INFO("Generating Radio Maps...");
@@ -342,6 +355,7 @@ Scenario::operator()()
         {
             if (config.type == "nr")
             {
+                bool nativePly = false;
                 NetDeviceContainer txDevs;
                 for (const auto& [netId, containers] : m_nrGnbDevices)
                 {
@@ -392,6 +406,7 @@ Scenario::operator()()
                     }
 
                     remHelper->CreateRem(txDevs, rxDev, config.bwpId);
+                    nativePly = true;
                 }
                 else
                 {
@@ -412,7 +427,11 @@ Scenario::operator()()
                 std::string filename =
                     CONFIGURATOR->GetResultsPath() + "nr-rem-" + ss.str() + ".out";
                 generatedFiles.push_back(filename);
-                plotFiles.push_back({.file = filename, .type = "nr", .is3D = false});
+                plotFiles.push_back({.file = filename,
+                                     .type = "nr",
+                                     .is3D = false,
+                                     .nativePly = nativePly,
+                                     .preview = config.preview});
             }
             else if (config.type == "lte")
             {
@@ -434,7 +453,11 @@ Scenario::operator()()
                     remHelper->SetAttribute("OutputFile", StringValue(filename));
                     remHelper->Install();
                     generatedFiles.push_back(filename);
-                    plotFiles.push_back({.file = filename, .type = "lte", .is3D = true});
+                    plotFiles.push_back({.file = filename,
+                                         .type = "lte",
+                                         .is3D = true,
+                                         .nativePly = true,
+                                         .preview = config.preview});
                 }
                 else
                 {
@@ -453,7 +476,11 @@ Scenario::operator()()
                     remHelper->SetAttribute("OutputFile", StringValue(filename));
                     remHelper->Install();
                     generatedFiles.push_back(filename);
-                    plotFiles.push_back({.file = filename, .type = "lte", .is3D = false});
+                    plotFiles.push_back({.file = filename,
+                                         .type = "lte",
+                                         .is3D = false,
+                                         .nativePly = false,
+                                         .preview = config.preview});
                 }
             }
             else
@@ -466,38 +493,52 @@ Scenario::operator()()
         Simulator::Run();
         Simulator::Destroy();
 
+        // Maps are independent of each other, so their post-processing runs concurrently.
+        // Workers do not log: they return their errors, which are logged here.
+        const std::string analysisPath = CONFIGURATOR->GetResultsPath() + "../../analysis/";
+        std::vector<std::future<std::vector<std::string>>> postProcessing;
         for (const auto& plotConf : plotFiles)
         {
-            std::string cmd = "python " + CONFIGURATOR->GetResultsPath() +
-                              "../../analysis/txt2ply.py " + plotConf.file;
+            postProcessing.push_back(std::async(std::launch::async, [plotConf, analysisPath]() {
+                std::vector<std::string> errors;
+                const bool isNrMap = plotConf.type == "nr";
+                const std::string plyFile = RemPlyWriter::GetPlyFileName(plotConf.file);
+
+                std::string plyError;
+                if (!plotConf.nativePly &&
+                    !RemPlyWriter::ConvertFromText(plotConf.file, isNrMap ? 4 : 3, plyError))
+                {
+                    errors.push_back("Something went wrong while generating the ply file for " +
+                                     plotConf.file + ": " + plyError);
+                }
 
-            bool addNrFlag = plotConf.type == "nr";
-            if (addNrFlag)
-            {
-                cmd += " --nrMap";
-            }
+                if (!plotConf.preview)
+                {
+                    return errors;
+                }
 
-            int plyRet = system(cmd.c_str());
-            if (plyRet != 0)
-            {
-                NS_LOG_ERROR("Something went wrong while generating the ply file for "
-                             << plotConf.file);
-            }
+                std::string plotCmd =
+                    plotConf.is3D ? "python " + analysisPath + "rem-3d-preview.py " + plyFile
+                                  : "python " + analysisPath + "rem-2d-preview.py " + plotConf.file;
+                if (isNrMap)
+                {
+                    plotCmd += " --nrMap";
+                }
+                int plotRet = system(plotCmd.c_str());
+                if (plotRet != 0)
+                {
+                    errors.push_back("Something went wrong while generating the plot for " +
+                                     plotConf.file);
+                }
+                return errors;
+            }));
+        }
 
-            std::string plotCmd = plotConf.is3D
-                                      ? "python " + CONFIGURATOR->GetResultsPath() +
-                                            "../../analysis/rem-3d-preview.py " + plotConf.file
-                                      : "python " + CONFIGURATOR->GetResultsPath() +
-                                            "../../analysis/rem-2d-preview.py " + plotConf.file;
-            if (addNrFlag)
-            {
-                plotCmd += " --nrMap";
-            }
-            int plotRet = system(plotCmd.c_str());
-            if (plotRet != 0)
+        for (auto& task : postProcessing)
+        {
+            for (const auto& error : task.get())
             {
-                NS_LOG_ERROR("Something went wrong while generating the plot for "
-                             << plotConf.file);
+                NS_LOG_ERROR(error);
             }
         }
     }
@@ -547,7 +588,8 @@ Scenario::ConfigureWorld()
 {
     NS_LOG_FUNCTION_NOARGS();
 
-    CONFIGURATOR->GetBuildings(); // buildings created here are automatically added to BuildingsList
+    // buildings created here are automatically added to BuildingsList and to the BuildingIndex
+    CONFIGURATOR->GetBuildings();
 }
 
 void
@@ -1090,6 +1132,11 @@ Scenario::ConfigureEntityMobility(const std::string& entityKey,
     {
         auto node = m_leoSats.Get(entityId);
         mobility.Install(node);
+        // Satellites are configured before vehicles, so their rows come first
+        if (m_positions->Add(node) != PositionSnapshot::NO_INDEX)
+        {
+            m_nLeoSatPositions++;
+        }
         std::ostringstream oss;
         oss << "/LeoSatList/" << entityId << "/$ns3::MobilityModel/CourseChange";
 
@@ -1102,6 +1149,7 @@ Scenario::ConfigureEntityMobility(const std::string& entityKey,
     {
         auto vehicle = m_vehicles.Get(entityId);
         mobility.Install(vehicle);
+        m_positions->Add(vehicle);
         std::ostringstream oss;
         oss << "/VehicleList/" << entityId << "/$ns3::MobilityModel/CourseChange";
         auto mob = vehicle->GetObject<MobilityModel>();
@@ -1861,24 +1909,24 @@ Scenario::ConfigureRegionsOfInterest()
     {
         reg = irc->Create(region);
     }
+    irc->BuildIndex();
 }
 
 void
 Scenario::LeoSatCourseChange(std::string context, Ptr<const MobilityModel> model)
 {
-    auto mobility = DynamicCast<const GeocentricMobilityModel>(model);
-    if (mobility)
+    const uint32_t row = m_positions->GetIndex(model);
+    if (row != PositionSnapshot::NO_INDEX)
     {
-        auto pos = mobility->GetPosition(ns3::PositionType::GEOCENTRIC);
-        auto geo = mobility->GetPosition(ns3::PositionType::GEOGRAPHIC);
-        Ptr<const Node> node = model->GetObject<Node>();
+        auto pos = m_positions->GetGeocentric(row);
+        auto geo = m_positions->GetGeographic(row);
         // Write to CSV file: Time,Node,X,Y,Z,Latitude,Longitude,Altitude
         if (m_leoSatTraceStream)
         {
             *m_leoSatTraceStream->GetStream()
-                << Simulator::Now().GetSeconds() << "," << node->GetId() << "," << pos.x << ","
-                << pos.y << "," << pos.z << "," << geo.x << "," << geo.y << "," << geo.z
-                << std::endl;
+                << Simulator::Now().GetSeconds() << "," << m_positions->GetNodeId(row) << ","
+                << pos.x << "," << pos.y << "," << pos.z << "," << geo.x << "," << geo.y << ","
+                << geo.z << std::endl;
         }
     }
 }
@@ -1886,46 +1934,27 @@ Scenario::LeoSatCourseChange(std::string context, Ptr<const MobilityModel> model
 void
 Scenario::VehicleCourseChange(std::string context, Ptr<const MobilityModel> model)
 {
-    auto mobility = DynamicCast<GeocentricMobilityModel>(ConstCast<MobilityModel>(model));
-    if (mobility)
+    const uint32_t row = m_positions->GetIndex(model);
+    if (row != PositionSnapshot::NO_INDEX)
     {
-        auto pos = mobility->GetPosition(ns3::PositionType::GEOCENTRIC);
-        auto geo = mobility->GetPosition(ns3::PositionType::GEOGRAPHIC);
-        Ptr<const Node> node = model->GetObject<Node>();
+        auto pos = m_positions->GetGeocentric(row);
+        auto geo = m_positions->GetGeographic(row);
         // Write to CSV file: Time,Node,X,Y,Z,Latitude,Longitude,Altitude,ElevationAngle
-        double minDistance = std::numeric_limits<double>::max();
-        Ptr<const GeocentricMobilityModel> nearestSat = nullptr;
+        const uint32_t nearestSat = m_positions->GetNearest(pos, 0, m_nLeoSatPositions);
         int32_t nearestSatId = -1;
-
-        for (uint32_t i = 0; i < m_leoSats.GetN(); ++i)
-        {
-            Ptr<Node> satNode = m_leoSats.Get(i);
-            Ptr<const GeocentricMobilityModel> satMobility =
-                satNode->GetObject<GeocentricMobilityModel>();
-            if (satMobility)
-            {
-                double dist = mobility->GetDistanceFrom(satMobility);
-                if (dist < minDistance)
-                {
-                    minDistance = dist;
-                    nearestSat = satMobility;
-                    nearestSatId = satNode->GetId();
-                }
-            }
-        }
-
         double elevationAngle = 0.0;
-        if (nearestSat)
+        if (nearestSat != PositionSnapshot::NO_INDEX)
         {
-            elevationAngle = mobility->GetElevationAngle(nearestSat);
+            nearestSatId = m_positions->GetNodeId(nearestSat);
+            elevationAngle = m_positions->GetElevationAngle(row, nearestSat);
         }
 
         if (m_vehicleTraceStream)
         {
             *m_vehicleTraceStream->GetStream()
-                << Simulator::Now().GetSeconds() << "," << node->GetId() << "," << pos.x << ","
-                << pos.y << "," << pos.z << "," << geo.x << "," << geo.y << "," << geo.z << ","
-                << nearestSatId << "," << elevationAngle << std::endl;
+                << Simulator::Now().GetSeconds() << "," << m_positions->GetNodeId(row) << ","
+                << pos.x << "," << pos.y << "," << pos.z << "," << geo.x << "," << geo.y << ","
+                << geo.z << "," << nearestSatId << "," << elevationAngle << std::endl;
         }
     }
 }
@@ -1947,11 +1976,11 @@ Scenario::DroneCourseChange(std::string context, Ptr<const MobilityModel> model)
     {
         peripheral = *i;
         regionindex = peripheral->GetRegionsOfInterest();
-        int status = irc->IsInRegions(regionindex, position);
         if (regionindex.empty())
         {
             continue;
         }
+        int status = irc->IsInRegions(regionindex, position);
         if (status >= 0 || status == -2)
         {
             if (peripheral->GetState() != DronePeripheral::PeripheralState::ON)
@@ -2136,7 +2165,11 @@ Scenario::EvaluateSinrDistanceAttachment(const uint32_t netId)
     auto nrHelper = nrPhySim->GetNrHelper();
 
     // Prepare REM Helper for SINR calculations
-    Ptr<NrRadioGeoEnvironmentMapHelper> remHelper = CreateObject<NrRadioGeoEnvironmentMapHelper>();
+    Ptr<NrRadioGeoEnvironmentMapHelper>& remHelper = m_sinrAttachmentHelpers[netId];
+    if (!remHelper)
+    {
+        remHelper = CreateObject<NrRadioGeoEnvironmentMapHelper>();
+    }
     remHelper->SetInterferers(allGnbDevices, 0); // Configure interferers (all gNBs)
 
     // Iterate over all UEs
@@ -2159,7 +2192,10 @@ Scenario::EvaluateSinrDistanceAttachment(const uint32_t netId)
         double bestSnr = -std::numeric_limits<double>::infinity();
         double bestDistance = std::numeric_limits<double>::infinity();
 
-        // Check all gNBs
+        // Select the gNBs within range, with the min SINR required at their distance
+        NetDeviceContainer candidateGnbs;
+        std::vector<double> candidateDistances;
+        std::vector<double> candidateMinSinr;
         for (auto gnbDeviceIt = allGnbDevices.Begin(); gnbDeviceIt != allGnbDevices.End();
              ++gnbDeviceIt)
         {
@@ -2177,9 +2213,6 @@ Scenario::EvaluateSinrDistanceAttachment(const uint32_t netId)
 
             double distance = ueMobility->GetDistanceFrom(gnbMobility);
 
-            // Find required min SINR for this distance
-            double minSinrRequired = std::numeric_limits<double>::max();
-
             const SinrDistanceTableEntry* bestEntry = nullptr;
             double rangeDiff = std::numeric_limits<double>::max();
 
@@ -2203,13 +2236,21 @@ Scenario::EvaluateSinrDistanceAttachment(const uint32_t netId)
                 continue;
             }
 
-            minSinrRequired = bestEntry->minSinr;
+            candidateGnbs.Add(gnbDevice);
+            candidateDistances.push_back(distance);
+            candidateMinSinr.push_back(bestEntry->minSinr);
+        }
 
-            // ---- CUSTOM SNR CALC REPLACED BY HELPER ----
-            // Use IsDl = true (Downlink) for attachment decision normally
-            double estimatedSnr = remHelper->GetSinr(ueDevice, gnbDevice, 0, true);
+        // Use IsDl = true (Downlink) for attachment decision normally
+        auto estimatedSnrs =
+            remHelper->GetSinrMatrix(NetDeviceContainer(ueDevice), candidateGnbs, 0, true);
 
-            // ---- END OF CUSTOM SNR CALC ----
+        for (uint32_t i = 0; i < candidateGnbs.GetN(); ++i)
+        {
+            Ptr<NrGnbNetDevice> gnbDevice = DynamicCast<NrGnbNetDevice>(candidateGnbs.Get(i));
+            double distance = candidateDistances[i];
+            double minSinrRequired = candidateMinSinr[i];
+            double estimatedSnr = estimatedSnrs.front()[i];
 
             // Checking if SNR is above the required threshold
             if (estimatedSnr >= minSinrRequired)
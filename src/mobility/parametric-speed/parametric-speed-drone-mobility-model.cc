@@ -73,6 +73,7 @@ ParametricSpeedDroneMobilityModel::GetTypeId()
 ParametricSpeedDroneMobilityModel::ParametricSpeedDroneMobilityModel()
     : m_flightParams{{}},
       m_lastUpdate{-1},
+      m_nUpdates{0},
       m_useGeodedicSystem{false}
 {
 }
@@ -161,21 +162,34 @@ ParametricSpeedDroneMobilityModel::DoGetPosition(PositionType type) const
     if (!m_useGeodedicSystem)
         return m_position;
 
+    Vector position;
+    m_positionCache.SetFrame(GetEarthSpheroidType(), GetGeographicReferencePoint());
+    if (m_positionCache.Get(m_nUpdates, type, position))
+        return position;
+
     switch (type)
     {
     case PositionType::TOPOCENTRIC:
-        return GeographicPositions::GeographicToTopocentricCoordinates(
-            m_position,
-            GetGeographicReferencePoint(),
-            GetEarthSpheroidType());
+        return m_positionCache.Set(m_nUpdates,
+                                   type,
+                                   GeographicPositions::GeographicToTopocentricCoordinates(
+                                       m_position,
+                                       GetGeographicReferencePoint(),
+                                       GetEarthSpheroidType()));
     case PositionType::GEOCENTRIC:
-        return GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
-                                                                     m_position.y,
-                                                                     m_position.z,
-                                                                     GetEarthSpheroidType());
+        return m_positionCache.Set(
+            m_nUpdates,
+            type,
+            GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
+                                                                  m_position.y,
+                                                                  m_position.z,
+                                                                  GetEarthSpheroidType()));
     case PositionType::PROJECTED:
-        return GeographicPositions::GeographicToProjectedCoordinates(m_position,
-                                                                     GetEarthSpheroidType());
+        return m_positionCache.Set(
+            m_nUpdates,
+            type,
+            GeographicPositions::GeographicToProjectedCoordinates(m_position,
+                                                                  GetEarthSpheroidType()));
     case PositionType::GEOGRAPHIC:
     default:
         return m_position;
@@ -226,6 +240,7 @@ ParametricSpeedDroneMobilityModel::DoSetPosition(const Vector& position, Positio
         m_position = position;
     }
 
+    m_nUpdates++;
     NotifyCourseChange();
 }
 
@@ -255,11 +270,20 @@ ParametricSpeedDroneMobilityModel::Update() const
     m_lastUpdate = t;
 
     m_planner.Update(t);
-    m_position =
-        (m_useGeodedicSystem)
-            ? GeographicPositions::ProjectedToGeographicCoordinates(m_planner.GetPosition(),
-                                                                    GetEarthSpheroidType())
-            : m_planner.GetPosition();
+    m_nUpdates++;
+    if (m_useGeodedicSystem)
+    {
+        // The planner works in projected coordinates, keep them to avoid converting back
+        const Vector projected = m_planner.GetPosition();
+        m_position =
+            GeographicPositions::ProjectedToGeographicCoordinates(projected,
+                                                                  GetEarthSpheroidType());
+        m_positionCache.Set(m_nUpdates, PositionType::PROJECTED, projected);
+    }
+    else
+    {
+        m_position = m_planner.GetPosition();
+    }
     m_velocity = m_planner.GetVelocity();
 
     NotifyCourseChange();
@@ -24,6 +24,7 @@
 #include <ns3/double-vector.h>
 #include <ns3/flight-plan.h>
 #include <ns3/geocentric-mobility-model.h>
+#include <ns3/geocentric-position-cache.h>
 #include <ns3/planner.h>
 #include <ns3/proto-point.h>
 #include <ns3/vector.h>
@@ -78,6 +79,10 @@ class ParametricSpeedDroneMobilityModel : public GeocentricMobilityModel
     Planner<ParametricSpeedParam, ParametricSpeedFlight> m_planner;
 
     mutable Time m_lastUpdate;
+    /// Number of position changes, keys m_positionCache
+    mutable int64_t m_nUpdates;
+    /// Position in each requested frame, when using the geodedic system
+    mutable GeocentricPositionCache m_positionCache;
 
     float m_curveStep;
     bool m_useGeodedicSystem;
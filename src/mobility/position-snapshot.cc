@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "position-snapshot.h"
+
+#include <ns3/log.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PositionSnapshot");
+
+NS_OBJECT_ENSURE_REGISTERED(PositionSnapshot);
+
+TypeId
+PositionSnapshot::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PositionSnapshot")
+                            .SetParent<Object>()
+                            .SetGroupName("Mobility")
+                            .AddConstructor<PositionSnapshot>();
+    return tid;
+}
+
+PositionSnapshot::PositionSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PositionSnapshot::~PositionSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PositionSnapshot::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& model : m_models)
+    {
+        model->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&PositionSnapshot::CourseChanged, this));
+    }
+    m_models.clear();
+    m_indices.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+PositionSnapshot::Add(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    Ptr<GeocentricMobilityModel> model = node->GetObject<GeocentricMobilityModel>();
+    if (!model)
+    {
+        NS_LOG_WARN("Node " << node->GetId() << " has no GeocentricMobilityModel, skipping it");
+        return NO_INDEX;
+    }
+
+    auto it = m_indices.find(PeekPointer(model));
+    if (it != m_indices.end())
+    {
+        return it->second;
+    }
+
+    const uint32_t index = m_models.size();
+    m_models.push_back(model);
+    m_nodeIds.push_back(node->GetId());
+    m_x.push_back(0.0);
+    m_y.push_back(0.0);
+    m_z.push_back(0.0);
+    m_stamps.push_back(OUTDATED);
+    m_geographic.emplace_back();
+    m_geoStamps.push_back(OUTDATED);
+    m_indices.emplace(PeekPointer(model), index);
+
+    model->TraceConnectWithoutContext("CourseChange",
+                                      MakeCallback(&PositionSnapshot::CourseChanged, this));
+    return index;
+}
+
+uint32_t
+PositionSnapshot::Add(const NodeContainer& nodes)
+{
+    NS_LOG_FUNCTION(this << nodes.GetN());
+    const uint32_t first = GetN();
+    for (auto node = nodes.Begin(); node != nodes.End(); node++)
+    {
+        Add(*node);
+    }
+    return first;
+}
+
+uint32_t
+PositionSnapshot::GetN() const
+{
+    return m_models.size();
+}
+
+uint32_t
+PositionSnapshot::GetIndex(Ptr<const MobilityModel> model) const
+{
+    auto it = m_indices.find(PeekPointer(model));
+    return it == m_indices.end() ? NO_INDEX : it->second;
+}
+
+uint32_t
+PositionSnapshot::GetNodeId(uint32_t index) const
+{
+    NS_ASSERT_MSG(index < GetN(), "Row " << index << " is not in the table");
+    return m_nodeIds[index];
+}
+
+Vector
+PositionSnapshot::GetGeocentric(uint32_t index)
+{
+    NS_ASSERT_MSG(index < GetN(), "Row " << index << " is not in the table");
+    RefreshRow(index, Simulator::Now().GetTimeStep());
+    return Vector(m_x[index], m_y[index], m_z[index]);
+}
+
+Vector
+PositionSnapshot::GetGeographic(uint32_t index)
+{
+    NS_ASSERT_MSG(index < GetN(), "Row " << index << " is not in the table");
+    const int64_t now = Simulator::Now().GetTimeStep();
+    if (m_geoStamps[index] != now)
+    {
+        m_geographic[index] = m_models[index]->GetPosition(PositionType::GEOGRAPHIC);
+        m_geoStamps[index] = now;
+    }
+    return m_geographic[index];
+}
+
+void
+PositionSnapshot::Refresh()
+{
+    const int64_t now = Simulator::Now().GetTimeStep();
+    for (uint32_t i = 0; i < GetN(); i++)
+    {
+        RefreshRow(i, now);
+    }
+}
+
+const double*
+PositionSnapshot::GetX() const
+{
+    return m_x.data();
+}
+
+const double*
+PositionSnapshot::GetY() const
+{
+    return m_y.data();
+}
+
+const double*
+PositionSnapshot::GetZ() const
+{
+    return m_z.data();
+}
+
+uint32_t
+PositionSnapshot::GetNearest(const Vector& position, uint32_t first, uint32_t count)
+{
+    NS_ASSERT_MSG(first + count <= GetN(), "Range exceeds the table");
+    const int64_t now = Simulator::Now().GetTimeStep();
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        RefreshRow(i, now);
+    }
+
+    uint32_t nearest = NO_INDEX;
+    double minDistance = std::numeric_limits<double>::max();
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        const double dx = m_x[i] - position.x;
+        const double dy = m_y[i] - position.y;
+        const double dz = m_z[i] - position.z;
+        const double distance = dx * dx + dy * dy + dz * dz;
+        if (distance < minDistance)
+        {
+            minDistance = distance;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+double
+PositionSnapshot::GetElevationAngle(uint32_t a, uint32_t b)
+{
+    Vector me = GetGeocentric(a);
+    Vector them = GetGeocentric(b);
+
+    // lower is assumed to be the terminal with the lowest altitude
+    const Vector& lower = (me.z < them.z ? me : them);
+    const Vector& upper = (me.z < them.z ? them : me);
+
+    Vector upperMinusLower = upper - lower;
+    double x = std::abs(lower * upperMinusLower) /
+               (lower.GetLength() * upperMinusLower.GetLength());
+    x = std::max(std::min(x, 1.0), -1.0);
+
+    return std::abs((180.0 * M_1_PI) * std::asin(x));
+}
+
+void
+PositionSnapshot::RefreshRow(uint32_t index, int64_t now)
+{
+    if (m_stamps[index] == now)
+    {
+        return;
+    }
+    const Vector position = m_models[index]->GetPosition(PositionType::GEOCENTRIC);
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+    m_z[index] = position.z;
+    m_stamps[index] = now;
+}
+
+void
+PositionSnapshot::CourseChanged(Ptr<const MobilityModel> model)
+{
+    auto it = m_indices.find(PeekPointer(model));
+    if (it != m_indices.end())
+    {
+        m_stamps[it->second] = OUTDATED;
+        m_geoStamps[it->second] = OUTDATED;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef POSITION_SNAPSHOT_H
+#define POSITION_SNAPSHOT_H
+
+#include <ns3/geocentric-mobility-model.h>
+#include <ns3/node-container.h>
+#include <ns3/object.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Table of the geocentric (ECEF) and geographic positions of a set of nodes.
+ *
+ * Rows are stored contiguously and read by index, so that loops over many nodes do not go
+ * through the mobility models at each access. A row is read from its GeocentricMobilityModel
+ * at most once per simulation time step: it is refreshed lazily at the first access of each
+ * time step, or after the model notifies a course change. The geographic position of a row is
+ * converted only when it is requested.
+ *
+ * Course changes are followed through the CourseChange trace source of the models, so a
+ * consumer connected to the same trace source after the node has been added reads the new
+ * position from its callback.
+ */
+class PositionSnapshot : public Object
+{
+  public:
+    /// Marker of a model that is not in the table
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+    static TypeId GetTypeId();
+
+    PositionSnapshot();
+    ~PositionSnapshot() override;
+
+    /**
+     * \brief Add the GeocentricMobilityModel of a node to the table.
+     * \param node the node, which is skipped if it has no GeocentricMobilityModel.
+     * \return the index of the node in the table, or NO_INDEX if it has been skipped.
+     */
+    uint32_t Add(Ptr<Node> node);
+
+    /**
+     * \brief Add the nodes of a container in order, skipping the ones without a
+     *        GeocentricMobilityModel.
+     * \param nodes the nodes to be added.
+     * \return the index of the first node added, which is GetN() if none has been added.
+     */
+    uint32_t Add(const NodeContainer& nodes);
+
+    /// \return the number of rows in the table.
+    uint32_t GetN() const;
+
+    /**
+     * \param model a mobility model.
+     * \return the index of the row of the model, or NO_INDEX if it is not in the table.
+     */
+    uint32_t GetIndex(Ptr<const MobilityModel> model) const;
+
+    /**
+     * \param index a row of the table.
+     * \return the id of the node of the row.
+     */
+    uint32_t GetNodeId(uint32_t index) const;
+
+    /**
+     * \param index a row of the table.
+     * \return the geocentric (ECEF) position of the row at the current time.
+     */
+    Vector GetGeocentric(uint32_t index);
+
+    /**
+     * \param index a row of the table.
+     * \return the geographic position (latitude, longitude, altitude) of the row at the current
+     *         time.
+     */
+    Vector GetGeographic(uint32_t index);
+
+    /**
+     * \brief Refresh all the outdated rows, so that GetX(), GetY() and GetZ() hold the
+     *        positions at the current time.
+     */
+    void Refresh();
+
+    /// \return the ECEF x coordinates of the rows, up to date after Refresh().
+    const double* GetX() const;
+    /// \return the ECEF y coordinates of the rows, up to date after Refresh().
+    const double* GetY() const;
+    /// \return the ECEF z coordinates of the rows, up to date after Refresh().
+    const double* GetZ() const;
+
+    /**
+     * \brief Find the row closest to a geocentric position among a range of rows.
+     * \param position the geocentric (ECEF) position.
+     * \param first the first row of the range.
+     * \param count the number of rows in the range.
+     * \return the index of the closest row, or NO_INDEX if the range is empty.
+     */
+    uint32_t GetNearest(const Vector& position, uint32_t first, uint32_t count);
+
+    /**
+     * \brief Compute the elevation angle between two rows, as
+     *        GeocentricMobilityModel::GetElevationAngle does from their models.
+     * \param a a row of the table.
+     * \param b another row of the table.
+     * \return the elevation angle in degrees.
+     */
+    double GetElevationAngle(uint32_t a, uint32_t b);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Read the geocentric position of a row from its model if it is outdated.
+    void RefreshRow(uint32_t index, int64_t now);
+
+    /// Mark the row of a model as outdated after a course change.
+    void CourseChanged(Ptr<const MobilityModel> model);
+
+    /// Marker of a row that has to be read again from its model
+    static constexpr int64_t OUTDATED = INT64_MIN;
+
+    std::vector<Ptr<GeocentricMobilityModel>> m_models; //!< Mobility model of each row
+    std::vector<uint32_t> m_nodeIds;                     //!< Node id of each row
+    std::vector<double> m_x;                             //!< ECEF x of each row
+    std::vector<double> m_y;                             //!< ECEF y of each row
+    std::vector<double> m_z;                             //!< ECEF z of each row
+    std::vector<int64_t> m_stamps;         //!< Time step of the ECEF position of each row
+    std::vector<Vector> m_geographic;      //!< Geographic position of each row
+    std::vector<int64_t> m_geoStamps;      //!< Time step of the geographic position of each row
+    std::unordered_map<const MobilityModel*, uint32_t> m_indices; //!< Model to row
+};
+
+} // namespace ns3
+
+#endif /* POSITION_SNAPSHOT_H */
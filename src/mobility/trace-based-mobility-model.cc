@@ -2,11 +2,14 @@
 
 #include "trace-reader.h"
 
+#include "ns3/double.h"
 #include "ns3/geographic-positions.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -37,14 +40,34 @@ TraceBasedMobilityModel::GetTypeId(void)
                           "arbitrary precision",
                           TimeValue(Seconds(1)),
                           MakeTimeAccessor(&TraceBasedMobilityModel::SetPrecision),
+                          MakeTimeChecker())
+            .AddAttribute("CourseChangeTolerance",
+                          "If positive, positions are computed on demand and CourseChange is only "
+                          "notified once the device has moved by this distance in meters. The "
+                          "position is checked when the device is expected to have covered it, "
+                          "instead of at each Precision. 0 means fixed Precision updates",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&TraceBasedMobilityModel::SetCourseChangeTolerance,
+                                             &TraceBasedMobilityModel::GetCourseChangeTolerance),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxUpdateInterval",
+                          "The longest time between two position checks when "
+                          "CourseChangeTolerance is positive. Until the speed of the device has "
+                          "been measured, checks are at most Precision (or 1 s, if Precision is "
+                          "0) apart",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&TraceBasedMobilityModel::m_maxUpdateInterval),
                           MakeTimeChecker());
     return tid;
 }
 
 TraceBasedMobilityModel::TraceBasedMobilityModel()
     : m_precision(Seconds(1)),
+      m_courseChangeTolerance(0.0),
+      m_maxUpdateInterval(Seconds(60)),
       m_lastTime(Seconds(0)),
-      m_firstUpdate(true)
+      m_firstUpdate(true),
+      m_nUpdates(0)
 {
 }
 
@@ -62,6 +85,7 @@ TraceBasedMobilityModel::SetTraceFile(std::string file)
         if (TraceReader::Get()->Register(m_traceFile, m_deviceId, initialPosition))
         {
             m_position = initialPosition;
+            m_positionCache.Invalidate();
             NS_LOG_INFO("Set initial position for device "
                         << m_deviceId << " to (" << initialPosition.x << ", " << initialPosition.y
                         << ", " << initialPosition.z << ")");
@@ -84,6 +108,7 @@ TraceBasedMobilityModel::SetDeviceId(std::string deviceId)
         if (TraceReader::Get()->Register(m_traceFile, m_deviceId, initialPosition))
         {
             m_position = initialPosition;
+            m_positionCache.Invalidate();
             NS_LOG_INFO("Set initial position for device "
                         << m_deviceId << " to (" << initialPosition.x << ", " << initialPosition.y
                         << ", " << initialPosition.z << ")");
@@ -109,6 +134,19 @@ TraceBasedMobilityModel::GetPrecision() const
     return m_precision;
 }
 
+void
+TraceBasedMobilityModel::SetCourseChangeTolerance(double tolerance)
+{
+    m_courseChangeTolerance = tolerance;
+    Update();
+}
+
+double
+TraceBasedMobilityModel::GetCourseChangeTolerance() const
+{
+    return m_courseChangeTolerance;
+}
+
 void
 TraceBasedMobilityModel::Update()
 {
@@ -179,6 +217,8 @@ TraceBasedMobilityModel::Update()
 
     m_position = newGeoPos;
     m_lastTime = now;
+    m_nUpdates++;
+    m_positionCache.Invalidate();
 
     NotifyCourseChange();
     if (m_updateEvent.IsPending())
@@ -186,12 +226,64 @@ TraceBasedMobilityModel::Update()
         Simulator::Cancel(m_updateEvent);
         m_updateEvent = EventId();
     }
-    if (m_precision > Seconds(0))
+    if (m_courseChangeTolerance > 0)
+    {
+        m_adaptiveUpdate.Notified(DoGetPosition(PositionType::GEOCENTRIC), now);
+        m_updateEvent = Simulator::Schedule(m_adaptiveUpdate.GetNextDelay(m_velocity.GetLength(),
+                                                                          m_courseChangeTolerance,
+                                                                          GetMaxCheckInterval()),
+                                            &TraceBasedMobilityModel::CheckCourseChange,
+                                            this);
+    }
+    else if (m_precision > Seconds(0))
     {
         m_updateEvent = Simulator::Schedule(m_precision, &TraceBasedMobilityModel::Update, this);
     }
 }
 
+void
+TraceBasedMobilityModel::CheckCourseChange()
+{
+    if (m_adaptiveUpdate.Check(DoGetPosition(PositionType::GEOCENTRIC),
+                               Simulator::Now(),
+                               m_courseChangeTolerance))
+    {
+        Update();
+        return;
+    }
+    m_updateEvent = Simulator::Schedule(m_adaptiveUpdate.GetNextDelay(m_velocity.GetLength(),
+                                                                      m_courseChangeTolerance,
+                                                                      GetMaxCheckInterval()),
+                                        &TraceBasedMobilityModel::CheckCourseChange,
+                                        this);
+}
+
+Time
+TraceBasedMobilityModel::GetMaxCheckInterval() const
+{
+    // Until the speed has been measured, the device is not known to be stationary, so the
+    // first check is at most one Precision (or one second, if arbitrary) away
+    if (m_velocity.GetLength() == 0 && !m_adaptiveUpdate.HasObservedSpeed())
+    {
+        return std::min(m_maxUpdateInterval, m_precision > Seconds(0) ? m_precision : Seconds(1));
+    }
+    // A still device can only start moving after its next trace sample
+    const Time now = Simulator::Now();
+    Time nextSample;
+    if (m_velocity.GetLength() == 0 &&
+        TraceReader::Get()->GetNextSampleTime(m_traceFile, m_deviceId, now, nextSample))
+    {
+        return std::min(m_maxUpdateInterval, nextSample - now);
+    }
+    return m_maxUpdateInterval;
+}
+
+bool
+TraceBasedMobilityModel::IsOnDemand() const
+{
+    return m_precision == Time(0) || m_courseChangeTolerance > 0;
+}
+
 Vector
 TraceBasedMobilityModel::CalcPosition(Time t) const
 {
@@ -206,33 +298,44 @@ TraceBasedMobilityModel::CalcPosition(Time t) const
 Vector
 TraceBasedMobilityModel::DoGetPosition(PositionType type) const
 {
-    Vector geoPos;
-    if (m_precision == Time(0))
+    // Positions computed on demand change with time, the others at each Update
+    const int64_t key = IsOnDemand() ? Simulator::Now().GetTimeStep() : m_nUpdates;
+    Vector position;
+    m_positionCache.SetFrame(GetEarthSpheroidType(), GetGeographicReferencePoint());
+    if (m_positionCache.Get(key, type, position))
     {
-        geoPos = CalcPosition(Simulator::Now());
-    }
-    else
-    {
-        geoPos = m_position;
+        return position;
     }
 
     switch (type)
     {
-    case PositionType::GEOCENTRIC:
-        return GeographicPositions::GeographicToCartesianCoordinates(geoPos.x,
-                                                                     geoPos.y,
-                                                                     geoPos.z,
-                                                                     GetEarthSpheroidType());
     case PositionType::GEOGRAPHIC:
-        return geoPos;
+        return m_positionCache.Set(key,
+                                   type,
+                                   IsOnDemand() ? CalcPosition(Simulator::Now()) : m_position);
+    case PositionType::GEOCENTRIC: {
+        const Vector geoPos = DoGetPosition(PositionType::GEOGRAPHIC);
+        return m_positionCache.Set(
+            key,
+            type,
+            GeographicPositions::GeographicToCartesianCoordinates(geoPos.x,
+                                                                  geoPos.y,
+                                                                  geoPos.z,
+                                                                  GetEarthSpheroidType()));
+    }
     case PositionType::TOPOCENTRIC:
-        return GeographicPositions::GeographicToTopocentricCoordinates(
-            geoPos,
-            GetGeographicReferencePoint(),
-            GetEarthSpheroidType());
+        return m_positionCache.Set(key,
+                                   type,
+                                   GeographicPositions::GeographicToTopocentricCoordinates(
+                                       DoGetPosition(PositionType::GEOGRAPHIC),
+                                       GetGeographicReferencePoint(),
+                                       GetEarthSpheroidType()));
     case PositionType::PROJECTED:
-        return GeographicPositions::GeographicToProjectedCoordinates(geoPos,
-                                                                     GetEarthSpheroidType());
+        return m_positionCache.Set(key,
+                                   type,
+                                   GeographicPositions::GeographicToProjectedCoordinates(
+                                       DoGetPosition(PositionType::GEOGRAPHIC),
+                                       GetEarthSpheroidType()));
     default:
         NS_FATAL_ERROR("Unknown/unsupported position type");
         return Vector();
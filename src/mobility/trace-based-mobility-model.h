@@ -1,8 +1,10 @@
 #ifndef TRACE_BASED_MOBILITY_MODEL_H
 #define TRACE_BASED_MOBILITY_MODEL_H
 
+#include "ns3/adaptive-update-policy.h"
 #include "ns3/event-id.h"
 #include "ns3/geocentric-mobility-model.h"
+#include "ns3/geocentric-position-cache.h"
 #include "ns3/nstime.h"
 
 #include <string>
@@ -24,6 +26,9 @@ class TraceBasedMobilityModel : public GeocentricMobilityModel
     void SetPrecision(Time precision);
     Time GetPrecision() const;
 
+    void SetCourseChangeTolerance(double tolerance);
+    double GetCourseChangeTolerance() const;
+
   private:
     Vector DoGetPosition(PositionType type) const override;
     void DoSetPosition(const Vector& position, PositionType type) override;
@@ -31,17 +36,25 @@ class TraceBasedMobilityModel : public GeocentricMobilityModel
     int64_t DoAssignStreams(int64_t) override;
 
     void Update();
+    void CheckCourseChange();
+    Time GetMaxCheckInterval() const;
+    bool IsOnDemand() const;
     Vector CalcPosition(Time t) const;
 
     std::string m_traceFile;
     std::string m_deviceId;
 
     Time m_precision;
+    double m_courseChangeTolerance; // Distance before notifying CourseChange, 0 to disable
+    Time m_maxUpdateInterval;       // Longest time between two position checks
+    AdaptiveUpdatePolicy m_adaptiveUpdate;
     EventId m_updateEvent;
     Vector m_position; // Cached geographic position (Lat, Lon, Alt)
     Vector m_velocity; // Calculated velocity
     Time m_lastTime;   // Last update time
     bool m_firstUpdate;
+    int64_t m_nUpdates;                              // Number of calls to Update
+    mutable GeocentricPositionCache m_positionCache; // Position in each requested frame
 };
 
 } // namespace ns3
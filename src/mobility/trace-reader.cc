@@ -480,4 +480,27 @@ TraceReader::GetNextPoint(const std::string& traceFile,
     return true;
 }
 
+bool
+TraceReader::GetNextSampleTime(const std::string& traceFile,
+                               const std::string& deviceId,
+                               Time currentTime,
+                               Time& nextTime)
+{
+    if (m_traceFiles.find(traceFile) == m_traceFiles.end())
+    {
+        return false;
+    }
+
+    ReadUntil(traceFile, deviceId, currentTime);
+    for (const auto& point : m_traceFiles[traceFile].buffers[deviceId])
+    {
+        if (point.time > currentTime)
+        {
+            nextTime = point.time;
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace ns3
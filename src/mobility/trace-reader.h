@@ -58,6 +58,19 @@ class TraceReader
                       Time currentTime,
                       Vector& position);
 
+    /**
+     * \brief Get the time of the first sample of a device after the given time.
+     * \param traceFile The path to the trace file (tar.gz)
+     * \param deviceId The device ID
+     * \param currentTime The time after which the sample is looked for
+     * \param nextTime Set to the time of the sample
+     * \return false if the trace of the device has no sample after currentTime
+     */
+    bool GetNextSampleTime(const std::string& traceFile,
+                           const std::string& deviceId,
+                           Time currentTime,
+                           Time& nextTime);
+
   private:
     TraceReader();
     ~TraceReader();
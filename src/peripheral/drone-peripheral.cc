@@ -43,7 +43,11 @@ DronePeripheral::GetTypeId()
                           "Indexes of Regions of Interest",
                           IntVectorValue(),
                           MakeIntVectorAccessor(&DronePeripheral::SetRegionsOfInterest),
-                          MakeIntVectorChecker());
+                          MakeIntVectorChecker())
+            .AddTraceSource("CurrentPowerConsumption",
+                            "Power consumption of the peripheral in its current state.",
+                            MakeTraceSourceAccessor(&DronePeripheral::m_powerConsumption),
+                            "ns3::TracedValueCallback::Double");
     return tid;
 }
 
@@ -24,6 +24,7 @@
 #include <ns3/int-vector.h>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
+#include <ns3/traced-value.h>
 
 namespace ns3
 {
@@ -143,7 +144,7 @@ class DronePeripheral : public Object
 
   private:
     Ptr<Drone> m_drone;                           //!< Pointer to the drone.
-    double m_powerConsumption;                    //!< Constant power consumption in Watt.
+    TracedValue<double> m_powerConsumption;       //!< Constant power consumption in Watt.
     PeripheralState m_state;                      //!< Current peripheral state
     std::vector<double> m_powerConsumptionStates; //!< Power consumptions for each state
     std::vector<int> m_roi;                       //!< Regions of interest indexes
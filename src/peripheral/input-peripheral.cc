@@ -21,6 +21,8 @@
 #include <ns3/integer.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -44,11 +46,19 @@ InputPeripheral::GetTypeId()
                           "The time interval occurring between any data acquisition",
                           TimeValue(Seconds(1.0)),
                           MakeTimeAccessor(&InputPeripheral::m_acquisitionTimeInterval),
-                          MakeTimeChecker())
+                          MakeTimeChecker(TimeStep(1)))
             .AddAttribute("HasStorage",
                           "Acquired data are offloaded to the StoragePeripheral",
                           BooleanValue(false),
                           MakeBooleanAccessor(&InputPeripheral::m_hasStorage),
+                          MakeBooleanChecker())
+            .AddAttribute("AnalyticAcquisition",
+                          "Compute the data acquired in closed form instead of scheduling an "
+                          "event for each acquisition. The storage RemainingCapacity is then "
+                          "updated only when accessed or when the storage becomes full. The "
+                          "full instant is exact when a single peripheral writes to the storage.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&InputPeripheral::m_analyticAcquisition),
                           MakeBooleanChecker());
     return tid;
 }
@@ -62,6 +72,12 @@ InputPeripheral::DoInitialize(void)
 void
 InputPeripheral::DoDispose(void)
 {
+    m_dataAcquisitionEvent.Cancel();
+    m_storageFullEvent.Cancel();
+    if (m_storage)
+        m_storage->RemoveLazyWriter(MakeCallback(&InputPeripheral::CommitAcquiredData, this),
+                                    MakeCallback(&InputPeripheral::ScheduleStorageFull, this));
+    m_storage = nullptr;
     DronePeripheral::DoDispose();
 }
 
@@ -70,7 +86,12 @@ InputPeripheral::SetStorage(Ptr<StoragePeripheral> storage)
 {
     NS_ASSERT(storage);
     NS_ASSERT(storage->GetDrone() == this->GetDrone());
+    if (m_storage)
+        m_storage->RemoveLazyWriter(MakeCallback(&InputPeripheral::CommitAcquiredData, this),
+                                    MakeCallback(&InputPeripheral::ScheduleStorageFull, this));
     m_storage = storage;
+    m_storage->AddLazyWriter(MakeCallback(&InputPeripheral::CommitAcquiredData, this),
+                             MakeCallback(&InputPeripheral::ScheduleStorageFull, this));
 }
 
 void
@@ -108,17 +129,103 @@ InputPeripheral::OnChangeState(PeripheralState s)
     switch (s)
     {
     case OFF:
-        break;
     case IDLE:
+        if (m_analyticAcquisition)
+            StopAnalyticAcquisition();
         break;
     case ON:
-        AcquireData();
+        if (m_analyticAcquisition)
+            StartAnalyticAcquisition();
+        else
+            AcquireData();
         break;
     default:
         break;
     }
 }
 
+uint64_t
+InputPeripheral::GetAcquisitionSize()
+{
+    return m_dataRate * m_acquisitionTimeInterval.GetMilliSeconds() / 1000;
+}
+
+void
+InputPeripheral::StartAnalyticAcquisition()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_storage)
+        return;
+
+    // Commit what has been acquired so far, then restart the acquisition phase
+    // as AcquireData would do.
+    m_storage->GetRemainingCapacity();
+    m_acquiring = true;
+    m_nextAcquisition = Simulator::Now();
+    if (m_nextAcquisition < m_acquisitionTimeInterval)
+        m_nextAcquisition += m_acquisitionTimeInterval;
+
+    ScheduleStorageFull(m_storage->GetRemainingCapacity());
+}
+
+void
+InputPeripheral::StopAnalyticAcquisition()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_acquiring)
+        return;
+
+    m_storage->GetRemainingCapacity();
+    m_acquiring = false;
+    m_storageFullEvent.Cancel();
+}
+
+void
+InputPeripheral::CommitAcquiredData()
+{
+    const Time now = Simulator::Now();
+    if (!m_acquiring || now < m_nextAcquisition)
+        return;
+
+    const int64_t acquisitions = (now - m_nextAcquisition).GetTimeStep() /
+                                     m_acquisitionTimeInterval.GetTimeStep() +
+                                 1;
+    m_nextAcquisition += m_acquisitionTimeInterval * acquisitions;
+
+    const uint64_t size = GetAcquisitionSize();
+    if (size == 0)
+        return;
+
+    // Each acquisition that does not fit in the storage is dropped, hence only
+    // the first ones up to the remaining capacity are committed.
+    const uint64_t committed =
+        std::min<uint64_t>(acquisitions, m_storage->GetRemainingCapacity() / size);
+    NS_LOG_LOGIC("Committing " << committed << " of " << acquisitions << " acquisitions");
+    if (committed > 0)
+        m_storage->Alloc(committed * size, StoragePeripheral::bit);
+}
+
+void
+InputPeripheral::ScheduleStorageFull(uint64_t remainingCapacity)
+{
+    // The periodic acquisition allocates by itself, so only the analytic one has to
+    // follow the storage.
+    if (!m_analyticAcquisition)
+        return;
+
+    m_storageFullEvent.Cancel();
+
+    const uint64_t size = GetAcquisitionSize();
+    if (!m_acquiring || size == 0 || remainingCapacity < size)
+        return;
+
+    const Time last = m_nextAcquisition + m_acquisitionTimeInterval *
+                                              (int64_t)(remainingCapacity / size - 1);
+    const Time delay = (last > Simulator::Now()) ? last - Simulator::Now() : Time(0);
+    m_storageFullEvent =
+        Simulator::Schedule(delay, &StoragePeripheral::GetRemainingCapacity, m_storage);
+}
+
 double
 InputPeripheral::GetDatarate()
 {
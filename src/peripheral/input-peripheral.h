@@ -49,6 +49,9 @@ class InputPeripheral : public DronePeripheral
      *
      * This methods schedules every m_acquisitionTimeInterval an event that allocates
      * m_dataRate * m_acquisitionTimeInterval bits to the linked StoragePeripheral.
+     * When the analytic acquisition is enabled, no periodic event is scheduled: the
+     * acquired data is committed to the storage in closed form whenever it is accessed,
+     * or at the instant the storage becomes full.
      */
     void AcquireData(void);
 
@@ -90,10 +93,42 @@ class InputPeripheral : public DronePeripheral
     void DoDispose(void);
 
   private:
+    /**
+     * \return the amount of bits allocated to the storage at each acquisition.
+     */
+    uint64_t GetAcquisitionSize();
+
+    /**
+     * \brief Starts the analytic acquisition, with a first acquisition at the current time.
+     */
+    void StartAnalyticAcquisition();
+
+    /**
+     * \brief Stops the analytic acquisition, committing the data acquired so far.
+     */
+    void StopAnalyticAcquisition();
+
+    /**
+     * \brief Allocates on the storage the data of every acquisition occurred since the
+     *        last commit.
+     */
+    void CommitAcquiredData();
+
+    /**
+     * \brief Schedules the event of the last acquisition that fits in the storage.
+     *
+     * \param remainingCapacity remaining capacity of the storage in bits.
+     */
+    void ScheduleStorageFull(uint64_t remainingCapacity);
+
     Time m_acquisitionTimeInterval;
     double m_dataRate;
     bool m_hasStorage;
+    bool m_analyticAcquisition;     //!< Whether the acquisition is computed in closed form
+    bool m_acquiring = false;       //!< Whether the analytic acquisition is running
+    Time m_nextAcquisition;         //!< Time of the first acquisition not yet committed
     EventId m_dataAcquisitionEvent;
+    EventId m_storageFullEvent;     //!< Last analytic acquisition that fits in the storage
     Ptr<StoragePeripheral> m_storage;
 };
 
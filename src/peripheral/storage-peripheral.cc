@@ -74,9 +74,65 @@ StoragePeripheral::DoInitialize(void)
 void
 StoragePeripheral::DoDispose()
 {
+    m_flushCallbacks.clear();
+    m_updateCallbacks.clear();
     DronePeripheral::DoDispose();
 }
 
+uint64_t
+StoragePeripheral::GetRemainingCapacity(void)
+{
+    Flush();
+    return m_remainingCapacity;
+}
+
+void
+StoragePeripheral::AddLazyWriter(Callback<void> flush, Callback<void, uint64_t> update)
+{
+    m_flushCallbacks.push_back(flush);
+    m_updateCallbacks.push_back(update);
+}
+
+void
+StoragePeripheral::RemoveLazyWriter(Callback<void> flush, Callback<void, uint64_t> update)
+{
+    for (std::size_t i = 0; i < m_flushCallbacks.size(); i++)
+    {
+        if (m_flushCallbacks[i].IsEqual(flush) && m_updateCallbacks[i].IsEqual(update))
+        {
+            m_flushCallbacks.erase(m_flushCallbacks.begin() + i);
+            m_updateCallbacks.erase(m_updateCallbacks.begin() + i);
+            return;
+        }
+    }
+}
+
+void
+StoragePeripheral::Flush(void)
+{
+    if (m_flushing)
+        return;
+
+    const uint64_t remaining = m_remainingCapacity;
+    m_flushing = true;
+    for (auto& cb : m_flushCallbacks)
+        cb();
+    m_flushing = false;
+
+    if (m_remainingCapacity != remaining)
+        NotifyUpdate();
+}
+
+void
+StoragePeripheral::NotifyUpdate(void)
+{
+    if (m_flushing)
+        return;
+
+    for (auto& cb : m_updateCallbacks)
+        cb(m_remainingCapacity);
+}
+
 bool
 StoragePeripheral::Alloc(uint64_t amount, unit amountUnit)
 {
@@ -86,11 +142,13 @@ StoragePeripheral::Alloc(uint64_t amount, unit amountUnit)
         return false;
     }
     NS_LOG_FUNCTION(this << amount * amountUnit);
+    Flush();
     if (amount * amountUnit <= m_remainingCapacity)
     {
         m_remainingCapacity -= amount * amountUnit;
         NS_LOG_DEBUG("StoragePeripheral:Stored memory on Drone #"
                      << GetDrone()->GetId() << ": " << m_capacity - m_remainingCapacity << " bits");
+        NotifyUpdate();
         return true;
     }
     else
@@ -109,11 +167,13 @@ StoragePeripheral::Free(uint64_t amount, unit amountUnit)
         return false;
     }
     NS_LOG_FUNCTION(this << amount * amountUnit);
+    Flush();
     if (amount * amountUnit <= m_capacity - m_remainingCapacity)
     {
         m_remainingCapacity += amount * amountUnit;
         NS_LOG_DEBUG("StoragePeripheral:Stored memory on Drone #"
                      << GetDrone()->GetId() << ": " << m_capacity - m_remainingCapacity << " bits");
+        NotifyUpdate();
         return true;
     }
     else
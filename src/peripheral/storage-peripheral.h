@@ -20,8 +20,11 @@
 
 #include "drone-peripheral.h"
 
+#include <ns3/callback.h>
 #include <ns3/traced-value.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -83,13 +86,53 @@ class StoragePeripheral : public DronePeripheral
      */
     bool Free(uint64_t amount, unit amountUnit);
 
+    /**
+     * \brief Returns the remaining capacity of the drive.
+     *
+     * Any data that lazy writers have acquired up to now is committed first.
+     *
+     * \returns Remaining capacity of the drive in bits.
+     */
+    uint64_t GetRemainingCapacity(void);
+
+    /**
+     * \brief Registers a writer that accounts for its data lazily.
+     *
+     * \param flush Callback that commits the pending data of the writer. It is
+     *              invoked before any access to the remaining capacity.
+     * \param update Callback invoked with the new remaining capacity, in bits,
+     *               after it has changed.
+     */
+    void AddLazyWriter(Callback<void> flush, Callback<void, uint64_t> update);
+
+    /**
+     * \brief Unregisters a writer added with AddLazyWriter.
+     *
+     * \param flush Commit callback the writer has been registered with.
+     * \param update Update callback the writer has been registered with.
+     */
+    void RemoveLazyWriter(Callback<void> flush, Callback<void, uint64_t> update);
+
   protected:
     void DoInitialize(void);
     void DoDispose(void);
 
   private:
+    /**
+     * \brief Commits the pending data of every lazy writer.
+     */
+    void Flush(void);
+
+    /**
+     * \brief Notifies every lazy writer that the remaining capacity has changed.
+     */
+    void NotifyUpdate(void);
+
     uint64_t m_capacity;
     TracedValue<uint64_t> m_remainingCapacity;
+    std::vector<Callback<void>> m_flushCallbacks;  //!< Lazy writers commit callbacks
+    std::vector<Callback<void, uint64_t>> m_updateCallbacks; //!< Lazy writers update callbacks
+    bool m_flushing = false; //!< Guard against reentrant flushes
 };
 
 } // namespace ns3
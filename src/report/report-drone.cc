@@ -217,9 +217,9 @@ ReportDrone::DoMonitorTrajectory(const Ptr<const MobilityModel> mobility)
 
     if (m_trajectory.size() == 0 || m_trajectory.back().GetPosition() != position)
     {
-        m_trajectory.push_back(
-            ReportLocation(position, Simulator::Now(), irc->IsInRegions(position)));
-        m_roi.push_back(irc->IsInRegions(position));
+        const int roi = irc->IsInRegions(position);
+        m_trajectory.push_back(ReportLocation(position, Simulator::Now(), roi));
+        m_roi.push_back(roi);
     }
 }
 
@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/geographic-positions.h>
+#include <ns3/node-container.h>
+#include <ns3/node.h>
+#include <ns3/position-snapshot.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup tests
+ *
+ * \brief Fixed geographic position that counts how many times it is read.
+ */
+class CountingGeocentricMobilityModel : public GeocentricMobilityModel
+{
+  public:
+    static TypeId GetTypeId();
+
+    /// \return the number of positions computed since the last call.
+    uint32_t TakeReads();
+
+  private:
+    Vector DoGetPosition(PositionType type) const override;
+    void DoSetPosition(const Vector& position, PositionType type) override;
+    Vector DoGetVelocity() const override;
+
+    Vector m_position;           //!< Geographic position
+    mutable uint32_t m_reads{0}; //!< Number of positions computed
+};
+
+TypeId
+CountingGeocentricMobilityModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CountingGeocentricMobilityModel")
+                            .SetParent<GeocentricMobilityModel>()
+                            .SetGroupName("Mobility")
+                            .AddConstructor<CountingGeocentricMobilityModel>();
+    return tid;
+}
+
+uint32_t
+CountingGeocentricMobilityModel::TakeReads()
+{
+    const uint32_t reads = m_reads;
+    m_reads = 0;
+    return reads;
+}
+
+Vector
+CountingGeocentricMobilityModel::DoGetPosition(PositionType type) const
+{
+    m_reads++;
+    switch (type)
+    {
+    case PositionType::TOPOCENTRIC:
+        return GeographicPositions::GeographicToTopocentricCoordinates(
+            m_position,
+            GetGeographicReferencePoint(),
+            GetEarthSpheroidType());
+    case PositionType::GEOCENTRIC:
+        return GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
+                                                                     m_position.y,
+                                                                     m_position.z,
+                                                                     GetEarthSpheroidType());
+    case PositionType::GEOGRAPHIC:
+        return m_position;
+    default:
+        NS_ABORT_MSG("Unsupported PositionType requested");
+    }
+    return m_position;
+}
+
+void
+CountingGeocentricMobilityModel::DoSetPosition(const Vector& position, PositionType type)
+{
+    NS_ABORT_MSG_IF(type != PositionType::GEOGRAPHIC, "Only geographic positions are supported");
+    m_position = position;
+    NotifyCourseChange();
+}
+
+Vector
+CountingGeocentricMobilityModel::DoGetVelocity() const
+{
+    return Vector(0, 0, 0);
+}
+
+/**
+ * \ingroup tests
+ *
+ * \brief Rows, refresh and queries of a PositionSnapshot.
+ */
+class PositionSnapshotTestCase : public TestCase
+{
+  public:
+    PositionSnapshotTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Check the refresh of the rows in a later time step.
+    void CheckNextTimeStep();
+
+    Ptr<PositionSnapshot> m_snapshot;                           //!< Table under test
+    std::vector<Ptr<CountingGeocentricMobilityModel>> m_models; //!< Models of the rows
+};
+
+PositionSnapshotTestCase::PositionSnapshotTestCase()
+    : TestCase("PositionSnapshot reads each row once per time step")
+{
+}
+
+void
+PositionSnapshotTestCase::CheckNextTimeStep()
+{
+    m_snapshot->GetGeocentric(0);
+    m_snapshot->GetGeocentric(0);
+    NS_TEST_ASSERT_MSG_EQ(m_models[0]->TakeReads(), 1, "row not refreshed in a new time step");
+}
+
+void
+PositionSnapshotTestCase::DoRun()
+{
+    // geographic positions of the rows, around Bari
+    const std::vector<Vector> positions = {Vector(41.12, 16.87, 20.0),
+                                           Vector(41.10, 16.90, 1000.0),
+                                           Vector(40.90, 17.10, 500.0),
+                                           Vector(41.50, 16.20, 0.0)};
+    NodeContainer nodes;
+    for (const auto& position : positions)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<CountingGeocentricMobilityModel> model =
+            CreateObject<CountingGeocentricMobilityModel>();
+        model->SetPosition(position, PositionType::GEOGRAPHIC);
+        node->AggregateObject(model);
+        nodes.Add(node);
+        m_models.push_back(model);
+    }
+
+    Ptr<Node> flat = CreateObject<Node>();
+    flat->AggregateObject(CreateObject<ConstantPositionMobilityModel>());
+    Ptr<Node> still = CreateObject<Node>();
+
+    m_snapshot = CreateObject<PositionSnapshot>();
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->Add(flat),
+                          PositionSnapshot::NO_INDEX,
+                          "node without a GeocentricMobilityModel added");
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->Add(still),
+                          PositionSnapshot::NO_INDEX,
+                          "node without a mobility model added");
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->Add(nodes), 0, "rows not added from the first index");
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetN(), positions.size(), "unexpected number of rows");
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->Add(nodes.Get(2)), 2, "node added twice");
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetN(), positions.size(), "node added twice");
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetIndex(m_models[i]), i, "unexpected row of a model");
+        NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetNodeId(i),
+                              nodes.Get(i)->GetId(),
+                              "unexpected node of a row");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetIndex(flat->GetObject<MobilityModel>()),
+                          PositionSnapshot::NO_INDEX,
+                          "row found for a model not in the table");
+
+    // lazy refresh: one read per row and time step, whatever the accessor
+    for (auto& model : m_models)
+    {
+        model->TakeReads();
+    }
+    m_snapshot->GetGeocentric(0);
+    m_snapshot->GetGeocentric(0);
+    m_snapshot->Refresh();
+    m_snapshot->GetNearest(Vector(0, 0, 0), 0, m_snapshot->GetN());
+    m_snapshot->GetElevationAngle(0, 1);
+    for (auto& model : m_models)
+    {
+        NS_TEST_ASSERT_MSG_EQ(model->TakeReads(), 1, "row read more than once per time step");
+    }
+    const Vector geocentric = m_snapshot->GetGeocentric(1);
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_snapshot->GetX()[1], geocentric.x, 1e-6, "unexpected x column");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_snapshot->GetY()[1], geocentric.y, 1e-6, "unexpected y column");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_snapshot->GetZ()[1], geocentric.z, 1e-6, "unexpected z column");
+
+    // a course change in the same time step is read at the next access
+    const Vector moved(41.13, 16.88, 20.0);
+    m_models[0]->SetPosition(moved, PositionType::GEOGRAPHIC);
+    m_models[0]->TakeReads();
+    const Vector expected = m_models[0]->GetPosition(PositionType::GEOCENTRIC);
+    NS_TEST_ASSERT_MSG_LT(CalculateDistance(m_snapshot->GetGeocentric(0), expected),
+                          1e-6,
+                          "course change not followed");
+    NS_TEST_ASSERT_MSG_LT(CalculateDistance(m_snapshot->GetGeographic(0), moved),
+                          1e-9,
+                          "course change not followed");
+
+    // the nearest row is the one closest according to the mobility models
+    Ptr<CountingGeocentricMobilityModel> query = CreateObject<CountingGeocentricMobilityModel>();
+    for (const auto& position : {Vector(41.00, 17.00, 0.0), Vector(41.40, 16.30, 0.0)})
+    {
+        query->SetPosition(position, PositionType::GEOGRAPHIC);
+        uint32_t nearest = 0;
+        for (uint32_t i = 1; i < m_models.size(); i++)
+        {
+            if (m_models[i]->GetDistanceFrom(query) < m_models[nearest]->GetDistanceFrom(query))
+            {
+                nearest = i;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(
+            m_snapshot->GetNearest(query->GetPosition(PositionType::GEOCENTRIC),
+                                   0,
+                                   m_snapshot->GetN()),
+            nearest,
+            "nearest row differs from GetDistanceFrom");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_snapshot->GetNearest(Vector(0, 0, 0), 1, 0),
+                          PositionSnapshot::NO_INDEX,
+                          "nearest row found in an empty range");
+
+    m_models[0]->TakeReads();
+    Simulator::Schedule(Seconds(1), &PositionSnapshotTestCase::CheckNextTimeStep, this);
+    Simulator::Run();
+
+    m_snapshot->Dispose();
+    m_snapshot = nullptr;
+    m_models.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup tests
+ *
+ * \brief PositionSnapshot test suite.
+ */
+class PositionSnapshotTestSuite : public TestSuite
+{
+  public:
+    PositionSnapshotTestSuite();
+};
+
+PositionSnapshotTestSuite::PositionSnapshotTestSuite()
+    : TestSuite("position-snapshot", Type::UNIT)
+{
+    AddTestCase(new PositionSnapshotTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static PositionSnapshotTestSuite g_positionSnapshotTestSuite;
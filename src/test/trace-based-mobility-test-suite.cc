@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <ns3/double.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/trace-based-mobility-model.h>
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup tests
+ *
+ * \brief CourseChange of a TraceBasedMobilityModel with a CourseChangeTolerance.
+ *
+ * The device of the trace moves north along the meridian at about 110 m/s. With
+ * arbitrary precision, the tolerance alone has to schedule the position checks, and the
+ * first one must not wait for MaxUpdateInterval because the speed is not known yet.
+ * Another device is parked until 30 s, then moves like the first one: once it is known to
+ * be still, it is checked at its next trace sample rather than after MaxUpdateInterval.
+ */
+class TraceBasedMobilityToleranceTestCase : public TestCase
+{
+  public:
+    TraceBasedMobilityToleranceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Record the position of a CourseChange notification after the start.
+    void CourseChange(Ptr<const MobilityModel> model);
+
+    /// Record the time of a CourseChange notification of the parked device after the start.
+    void ParkedCourseChange(Ptr<const MobilityModel> model);
+
+    std::vector<Time> m_parkedTimes; //!< Time of each notification of the parked device
+    std::vector<Time> m_times;       //!< Time of each notification
+    std::vector<Vector> m_positions; //!< Geocentric position of each notification
+};
+
+TraceBasedMobilityToleranceTestCase::TraceBasedMobilityToleranceTestCase()
+    : TestCase("CourseChangeTolerance schedules the checks of a trace-based model")
+{
+}
+
+void
+TraceBasedMobilityToleranceTestCase::CourseChange(Ptr<const MobilityModel> model)
+{
+    if (Simulator::Now() == Time(0))
+    {
+        return;
+    }
+    m_times.push_back(Simulator::Now());
+    m_positions.push_back(
+        DynamicCast<const GeocentricMobilityModel>(model)->GetPosition(PositionType::GEOCENTRIC));
+}
+
+void
+TraceBasedMobilityToleranceTestCase::ParkedCourseChange(Ptr<const MobilityModel> model)
+{
+    if (Simulator::Now() == Time(0))
+    {
+        return;
+    }
+    m_parkedTimes.push_back(Simulator::Now());
+}
+
+void
+TraceBasedMobilityToleranceTestCase::DoRun()
+{
+    SetDataDir(NS_TEST_SOURCEDIR);
+    const double tolerance = 500.0;
+
+    Ptr<TraceBasedMobilityModel> model = CreateObject<TraceBasedMobilityModel>();
+    model->SetAttribute("TraceFile",
+                        StringValue(CreateDataDirFilename("trace-based-mobility-test.tar.gz")));
+    model->SetAttribute("DeviceId", StringValue("north"));
+    model->SetAttribute("Precision", TimeValue(Seconds(0)));
+    model->SetAttribute("CourseChangeTolerance", DoubleValue(tolerance));
+    model->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&TraceBasedMobilityToleranceTestCase::CourseChange, this));
+
+    // samples every 10 s, the first movement is seen at the one of 40 s
+    Ptr<TraceBasedMobilityModel> parked = CreateObject<TraceBasedMobilityModel>();
+    parked->SetAttribute("TraceFile",
+                         StringValue(CreateDataDirFilename("trace-based-mobility-test.tar.gz")));
+    parked->SetAttribute("DeviceId", StringValue("parked"));
+    parked->SetAttribute("Precision", TimeValue(Seconds(0)));
+    parked->SetAttribute("CourseChangeTolerance", DoubleValue(tolerance));
+    parked->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&TraceBasedMobilityToleranceTestCase::ParkedCourseChange, this));
+
+    Simulator::Stop(Seconds(60));
+    Simulator::Run();
+
+    // about 6.6 km travelled, hence one notification each 4.5 s
+    NS_TEST_ASSERT_MSG_GT(m_times.size(), 10u, "CourseChange not notified while moving");
+    NS_TEST_ASSERT_MSG_LT(m_times.size(), 16u, "CourseChange notified before the tolerance");
+    NS_TEST_ASSERT_MSG_LT(m_times.front(), Seconds(10), "first check delayed to MaxUpdateInterval");
+    for (std::size_t i = 1; i < m_positions.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(CalculateDistance(m_positions[i], m_positions[i - 1]),
+                                    tolerance - 1e-3,
+                                    "CourseChange notified before the tolerance");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_parkedTimes.empty(), false, "parked device not followed");
+    NS_TEST_ASSERT_MSG_GT(m_parkedTimes.front(), Seconds(30), "CourseChange of a parked device");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_parkedTimes.front(),
+                                Seconds(40),
+                                "check of a still device delayed past the next sample");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup tests
+ *
+ * \brief TraceBasedMobilityModel test suite.
+ */
+class TraceBasedMobilityTestSuite : public TestSuite
+{
+  public:
+    TraceBasedMobilityTestSuite();
+};
+
+TraceBasedMobilityTestSuite::TraceBasedMobilityTestSuite()
+    : TestSuite("trace-based-mobility", Type::UNIT)
+{
+    AddTestCase(new TraceBasedMobilityToleranceTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceBasedMobilityTestSuite g_traceBasedMobilityTestSuite;
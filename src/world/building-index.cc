@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "building-index.h"
+
+#include <ns3/building-list.h>
+#include <ns3/building.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BuildingIndex");
+
+std::vector<BuildingIndex::BvhNode> BuildingIndex::m_nodes;
+std::vector<BuildingIndex::Entry> BuildingIndex::m_entries;
+uint64_t BuildingIndex::m_generation = 1;
+uint64_t BuildingIndex::m_builtGeneration = 0;
+bool BuildingIndex::m_destroyScheduled = false;
+
+void
+BuildingIndex::Build()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    m_nodes.clear();
+    m_entries.clear();
+    m_entries.reserve(BuildingList::GetNBuildings());
+    for (auto it = BuildingList::Begin(); it != BuildingList::End(); ++it)
+    {
+        m_entries.push_back({(*it)->GetBoundaries(), *it});
+    }
+
+    if (!m_entries.empty())
+    {
+        // a binary tree with leaves of up to MAX_LEAF_BUILDINGS has less than 2n nodes
+        m_nodes.reserve(2 * m_entries.size());
+        BuildNode(0, m_entries.size());
+    }
+
+    m_builtGeneration = m_generation;
+    if (!m_destroyScheduled)
+    {
+        // BuildingList is emptied when the simulator is destroyed
+        Simulator::ScheduleDestroy(&BuildingIndex::Invalidate);
+        m_destroyScheduled = true;
+    }
+
+    NS_LOG_INFO("Indexed " << m_entries.size() << " buildings in " << m_nodes.size()
+                           << " nodes");
+}
+
+void
+BuildingIndex::Invalidate()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_generation++;
+    m_nodes.clear();
+    m_entries.clear();
+    m_destroyScheduled = false;
+}
+
+uint32_t
+BuildingIndex::BuildNode(uint32_t first, uint32_t last)
+{
+    Box bounds = m_entries[first].bounds;
+    Box centroids(0, 0, 0, 0, 0, 0);
+    centroids.xMin = centroids.yMin = centroids.zMin = std::numeric_limits<double>::infinity();
+    centroids.xMax = centroids.yMax = centroids.zMax = -std::numeric_limits<double>::infinity();
+    for (uint32_t i = first; i < last; ++i)
+    {
+        const Box& box = m_entries[i].bounds;
+        bounds.xMin = std::min(bounds.xMin, box.xMin);
+        bounds.xMax = std::max(bounds.xMax, box.xMax);
+        bounds.yMin = std::min(bounds.yMin, box.yMin);
+        bounds.yMax = std::max(bounds.yMax, box.yMax);
+        bounds.zMin = std::min(bounds.zMin, box.zMin);
+        bounds.zMax = std::max(bounds.zMax, box.zMax);
+
+        const double cx = (box.xMin + box.xMax) / 2;
+        const double cy = (box.yMin + box.yMax) / 2;
+        const double cz = (box.zMin + box.zMax) / 2;
+        centroids.xMin = std::min(centroids.xMin, cx);
+        centroids.xMax = std::max(centroids.xMax, cx);
+        centroids.yMin = std::min(centroids.yMin, cy);
+        centroids.yMax = std::max(centroids.yMax, cy);
+        centroids.zMin = std::min(centroids.zMin, cz);
+        centroids.zMax = std::max(centroids.zMax, cz);
+    }
+
+    const uint32_t nodeIdx = m_nodes.size();
+    m_nodes.push_back({bounds, first, last - first});
+    if (last - first <= MAX_LEAF_BUILDINGS)
+    {
+        return nodeIdx;
+    }
+
+    // split at the median centroid along the axis on which the buildings are most spread
+    const double dx = centroids.xMax - centroids.xMin;
+    const double dy = centroids.yMax - centroids.yMin;
+    const double dz = centroids.zMax - centroids.zMin;
+    auto centroid = [dx, dy, dz](const Entry& e) {
+        if (dx >= dy && dx >= dz)
+        {
+            return e.bounds.xMin + e.bounds.xMax;
+        }
+        if (dy >= dz)
+        {
+            return e.bounds.yMin + e.bounds.yMax;
+        }
+        return e.bounds.zMin + e.bounds.zMax;
+    };
+    const uint32_t mid = first + (last - first) / 2;
+    std::nth_element(m_entries.begin() + first,
+                     m_entries.begin() + mid,
+                     m_entries.begin() + last,
+                     [&centroid](const Entry& a, const Entry& b) {
+                         return centroid(a) < centroid(b);
+                     });
+
+    // the left child immediately follows its parent, the right one is referenced by first
+    BuildNode(first, mid);
+    const uint32_t right = BuildNode(mid, last);
+    m_nodes[nodeIdx].first = right;
+    m_nodes[nodeIdx].count = 0;
+    return nodeIdx;
+}
+
+void
+BuildingIndex::Update()
+{
+    if (m_builtGeneration != m_generation || m_entries.size() != BuildingList::GetNBuildings())
+    {
+        Build();
+    }
+}
+
+std::vector<uint32_t>&
+BuildingIndex::GetStack()
+{
+    // queries may come from the worker threads of the REM helpers, which bring the
+    // index up to date before starting them
+    thread_local std::vector<uint32_t> stack;
+    stack.clear();
+    return stack;
+}
+
+Ptr<Building>
+BuildingIndex::GetBuilding(const Vector& position)
+{
+    Update();
+    if (m_nodes.empty())
+    {
+        return nullptr;
+    }
+
+    std::vector<uint32_t>& stack = GetStack();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const BvhNode& node = m_nodes[stack.back()];
+        const uint32_t nodeIdx = stack.back();
+        stack.pop_back();
+        if (!node.bounds.IsInside(position))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i)
+            {
+                if (m_entries[i].building->IsInside(position))
+                {
+                    return m_entries[i].building;
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.first);
+            stack.push_back(nodeIdx + 1);
+        }
+    }
+    return nullptr;
+}
+
+bool
+BuildingIndex::IsLineOfSight(const Vector& a, const Vector& b)
+{
+    Update();
+    if (m_nodes.empty())
+    {
+        return true;
+    }
+
+    std::vector<uint32_t>& stack = GetStack();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const BvhNode& node = m_nodes[stack.back()];
+        const uint32_t nodeIdx = stack.back();
+        stack.pop_back();
+        if (!SegmentIntersectsBox(node.bounds, a, b))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i)
+            {
+                // the exact test is left to ns-3, so that results match BuildingList scans
+                if (m_entries[i].building->IsIntersect(a, b))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.first);
+            stack.push_back(nodeIdx + 1);
+        }
+    }
+    return true;
+}
+
+uint32_t
+BuildingIndex::GetN()
+{
+    Update();
+    return m_entries.size();
+}
+
+bool
+BuildingIndex::SegmentIntersectsBox(const Box& box, const Vector& a, const Vector& b)
+{
+    // slab test on the segment a + t (b - a), t in [0, 1]
+    const double origin[3] = {a.x, a.y, a.z};
+    const double dir[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    const double lo[3] = {box.xMin, box.yMin, box.zMin};
+    const double hi[3] = {box.xMax, box.yMax, box.zMax};
+
+    double tMin = 0.0;
+    double tMax = 1.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::abs(dir[axis]) < std::numeric_limits<double>::epsilon())
+        {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        double t1 = (lo[axis] - origin[axis]) / dir[axis];
+        double t2 = (hi[axis] - origin[axis]) / dir[axis];
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BUILDING_INDEX_H
+#define BUILDING_INDEX_H
+
+#include <ns3/box.h>
+#include <ns3/ptr.h>
+#include <ns3/vector.h>
+
+#include <vector>
+
+namespace ns3
+{
+
+class Building;
+
+/**
+ * \ingroup world
+ *
+ * \brief Bounding Volume Hierarchy of the buildings in BuildingList.
+ *
+ * The index answers point-in-building and segment-building intersection
+ * queries in logarithmic time with respect to the number of buildings, instead
+ * of testing every building as ns-3 building-aware models do.
+ *
+ * The index is a snapshot: it has to be built once all the buildings have been
+ * created. Buildings added to BuildingList are picked up at the next query,
+ * while Invalidate has to be called after changing the existing ones. The index
+ * is also invalidated when the simulator is destroyed.
+ *
+ * Queries may run concurrently only while the index is up to date, since a
+ * query that finds it stale rebuilds it. Code that queries from several threads
+ * has to call Update before starting them, and must not change the buildings
+ * until they are joined.
+ */
+class BuildingIndex
+{
+  public:
+    /**
+     * \brief Build the index from the buildings currently in BuildingList.
+     */
+    static void Build();
+
+    /**
+     * \brief Drop the index, so that it is rebuilt at the next query.
+     */
+    static void Invalidate();
+
+    /**
+     * \brief Build the index if it is out of date with respect to BuildingList.
+     */
+    static void Update();
+
+    /**
+     * \param position the position to look up.
+     * \return the building containing the position, or nullptr if it is outdoor.
+     */
+    static Ptr<Building> GetBuilding(const Vector& position);
+
+    /**
+     * \param a the first end of the segment.
+     * \param b the second end of the segment.
+     * \return true if the segment does not intersect any building, false otherwise.
+     */
+    static bool IsLineOfSight(const Vector& a, const Vector& b);
+
+    /**
+     * \return the number of buildings in the index.
+     */
+    static uint32_t GetN();
+
+  private:
+    /// A node of the hierarchy, it is a leaf if count is greater than 0.
+    struct BvhNode
+    {
+        Box bounds;     ///< Bounds of all the buildings below this node
+        uint32_t first; ///< Index of the first building (leaf) or of the right child (inner)
+        uint32_t count; ///< Number of buildings of the leaf, 0 for inner nodes
+    };
+
+    /**
+     * \brief Recursively build the subtree of the buildings in [first, last).
+     * \return the index of the root of the subtree.
+     */
+    static uint32_t BuildNode(uint32_t first, uint32_t last);
+
+    /**
+     * \param box the box to test.
+     * \param a the first end of the segment.
+     * \param b the second end of the segment.
+     * \return true if the segment intersects the box.
+     */
+    static bool SegmentIntersectsBox(const Box& box, const Vector& a, const Vector& b);
+
+    /// A building and its bounds, stored contiguously to speed up the leaf tests.
+    struct Entry
+    {
+        Box bounds;             ///< Bounds of the building
+        Ptr<Building> building; ///< The building
+    };
+
+    /**
+     * \return the stack of the nodes still to be visited by a query of the calling thread.
+     */
+    static std::vector<uint32_t>& GetStack();
+
+    static std::vector<BvhNode> m_nodes;              ///< Flattened hierarchy, root first
+    static std::vector<Entry> m_entries;              ///< Buildings, sorted by leaf
+    static uint64_t m_generation;                     ///< Incremented by Invalidate
+    static uint64_t m_builtGeneration;                ///< Generation of the current index
+    static bool m_destroyScheduled;                   ///< Whether Invalidate runs at destroy
+    static constexpr uint32_t MAX_LEAF_BUILDINGS = 4; ///< Buildings per leaf
+};
+
+} // namespace ns3
+
+#endif /* BUILDING_INDEX_H */
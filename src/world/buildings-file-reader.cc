@@ -0,0 +1,298 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "buildings-file-reader.h"
+
+#include <ns3/abort.h>
+#include <ns3/box.h>
+#include <ns3/building.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BuildingsFileReader");
+
+namespace
+{
+
+/// Decode a little endian unsigned integer of N bytes.
+template <typename T>
+T
+DecodeLittleEndian(const unsigned char* bytes)
+{
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+/// Parse a positive number of floors or rooms of a building from a CSV field.
+uint16_t
+ParseCount(const std::string& field,
+           const std::string& name,
+           uint64_t lineNumber,
+           const std::string& path)
+{
+    char* end = nullptr;
+    errno = 0;
+    const long value = std::strtol(field.c_str(), &end, 10);
+    NS_ABORT_MSG_IF(end == field.c_str() || *end != '\0' || errno == ERANGE || value < 1 ||
+                        value > std::numeric_limits<uint16_t>::max(),
+                    "Invalid number of " << name << " '" << field << "' at line " << lineNumber
+                                         << " of " << path);
+    return static_cast<uint16_t>(value);
+}
+
+/// Check that the xMin, xMax, yMin, yMax, zMin, zMax boundaries of a building form a box.
+void
+CheckBounds(const double* bounds, const std::string& where, const std::string& path)
+{
+    for (std::size_t i = 0; i < 6; i += 2)
+    {
+        NS_ABORT_MSG_IF(std::isnan(bounds[i]) || std::isnan(bounds[i + 1]) ||
+                            bounds[i] > bounds[i + 1],
+                        "Invalid boundaries [" << bounds[i] << ", " << bounds[i + 1] << "] "
+                                               << where << " of " << path);
+    }
+}
+
+/// Parse the building type with the names used by the JSON configuration.
+Building::BuildingType_t
+ParseBuildingType(const std::string& type, const std::string& path)
+{
+    if (type == "residential")
+    {
+        return Building::Residential;
+    }
+    if (type == "office")
+    {
+        return Building::Office;
+    }
+    NS_ABORT_MSG_IF(type != "commercial",
+                    "Unknown type of building '" << type << "' in " << path);
+    return Building::Commercial;
+}
+
+/// Parse the walls type with the names used by the JSON configuration.
+Building::ExtWallsType_t
+ParseWallsType(const std::string& walls, const std::string& path)
+{
+    if (walls == "wood")
+    {
+        return Building::Wood;
+    }
+    if (walls == "concreteWithWindows")
+    {
+        return Building::ConcreteWithWindows;
+    }
+    if (walls == "concreteWithoutWindows")
+    {
+        return Building::ConcreteWithoutWindows;
+    }
+    NS_ABORT_MSG_IF(walls != "stoneBlocks",
+                    "Unknown type of walls for a building '" << walls << "' in " << path);
+    return Building::StoneBlocks;
+}
+
+} // namespace
+
+std::vector<Ptr<Building>>
+BuildingsFileReader::Read(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+
+    std::ifstream in(path, std::ios::binary);
+    NS_ABORT_MSG_IF(!in.is_open(), "Cannot open buildings file " << path);
+
+    std::vector<Ptr<Building>> buildings;
+    const std::string csvExtension = ".csv";
+    if (path.size() >= csvExtension.size() &&
+        path.compare(path.size() - csvExtension.size(), csvExtension.size(), csvExtension) == 0)
+    {
+        ReadCsv(in, path, buildings);
+    }
+    else
+    {
+        ReadBinary(in, path, buildings);
+    }
+
+    NS_LOG_INFO("Loaded " << buildings.size() << " buildings from " << path);
+    return buildings;
+}
+
+void
+BuildingsFileReader::ReadCsv(std::istream& in,
+                             const std::string& path,
+                             std::vector<Ptr<Building>>& buildings)
+{
+    std::string line;
+    uint64_t lineNumber = 0;
+    std::vector<std::string> fields;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#' || line.rfind("xMin", 0) == 0)
+        {
+            continue;
+        }
+
+        fields.clear();
+        std::size_t start = 0;
+        while (true)
+        {
+            const std::size_t end = line.find(',', start);
+            fields.push_back(line.substr(start, end - start));
+            if (end == std::string::npos)
+            {
+                break;
+            }
+            start = end + 1;
+        }
+        NS_ABORT_MSG_IF(fields.size() < 6 || fields.size() > 11 || fields.size() == 10,
+                        "Invalid number of columns at line " << lineNumber << " of " << path);
+
+        double bounds[6];
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            char* end = nullptr;
+            bounds[i] = std::strtod(fields[i].c_str(), &end);
+            NS_ABORT_MSG_IF(end == fields[i].c_str() || *end != '\0',
+                            "Invalid boundary '" << fields[i] << "' at line " << lineNumber
+                                                 << " of " << path);
+        }
+        CheckBounds(bounds, "at line " + std::to_string(lineNumber), path);
+
+        Ptr<Building> building = CreateObject<Building>();
+        building->SetBoundaries(
+            Box(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]));
+        if (fields.size() > 6 && !fields[6].empty())
+        {
+            building->SetNFloors(ParseCount(fields[6], "floors", lineNumber, path));
+        }
+        if (fields.size() > 7 && !fields[7].empty())
+        {
+            building->SetBuildingType(ParseBuildingType(fields[7], path));
+        }
+        if (fields.size() > 8 && !fields[8].empty())
+        {
+            building->SetExtWallsType(ParseWallsType(fields[8], path));
+        }
+        if (fields.size() > 10)
+        {
+            building->SetNRoomsX(ParseCount(fields[9], "rooms along x", lineNumber, path));
+            building->SetNRoomsY(ParseCount(fields[10], "rooms along y", lineNumber, path));
+        }
+        buildings.push_back(building);
+    }
+}
+
+void
+BuildingsFileReader::ReadBinary(std::istream& in,
+                                const std::string& path,
+                                std::vector<Ptr<Building>>& buildings)
+{
+    unsigned char header[16];
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    NS_ABORT_MSG_IF(in.gcount() != sizeof(header) ||
+                        std::memcmp(header, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0,
+                    "Buildings file " << path << " is neither a .csv nor a binary buildings file");
+
+    const uint64_t count = DecodeLittleEndian<uint64_t>(header + sizeof(BINARY_MAGIC));
+
+    // A corrupted count must not drive the reservation below
+    const std::streampos recordsStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streamoff available = in.tellg() - recordsStart;
+    in.seekg(recordsStart);
+    NS_ABORT_MSG_IF(!in || count > static_cast<uint64_t>(available) / BINARY_RECORD_SIZE,
+                    "Buildings file " << path << " is truncated: expected " << count
+                                      << " buildings");
+    buildings.reserve(buildings.size() + count);
+
+    std::vector<unsigned char> chunk(BINARY_RECORD_SIZE * BINARY_RECORDS_PER_READ);
+    uint64_t remaining = count;
+    while (remaining > 0)
+    {
+        const std::size_t records =
+            std::min<uint64_t>(remaining, BINARY_RECORDS_PER_READ);
+        in.read(reinterpret_cast<char*>(chunk.data()), records * BINARY_RECORD_SIZE);
+        NS_ABORT_MSG_IF(static_cast<std::size_t>(in.gcount()) != records * BINARY_RECORD_SIZE,
+                        "Buildings file " << path << " is truncated: expected " << count
+                                          << " buildings");
+
+        for (std::size_t r = 0; r < records; ++r)
+        {
+            const unsigned char* record = chunk.data() + r * BINARY_RECORD_SIZE;
+            double bounds[6];
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                bounds[i] = std::bit_cast<double>(DecodeLittleEndian<uint64_t>(record + 8 * i));
+            }
+            CheckBounds(bounds, "in record " + std::to_string(count - remaining + r), path);
+            const uint16_t floors = DecodeLittleEndian<uint16_t>(record + 48);
+            const uint16_t roomsX = DecodeLittleEndian<uint16_t>(record + 50);
+            const uint16_t roomsY = DecodeLittleEndian<uint16_t>(record + 52);
+            const uint8_t type = record[54];
+            const uint8_t walls = record[55];
+
+            Ptr<Building> building = CreateObject<Building>();
+            building->SetBoundaries(
+                Box(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]));
+            if (floors > 0)
+            {
+                building->SetNFloors(floors);
+            }
+            if (roomsX > 0 && roomsY > 0)
+            {
+                building->SetNRoomsX(roomsX);
+                building->SetNRoomsY(roomsY);
+            }
+            if (type != 0xFF)
+            {
+                NS_ABORT_MSG_IF(type > Building::Commercial,
+                                "Invalid building type " << +type << " in " << path);
+                building->SetBuildingType(static_cast<Building::BuildingType_t>(type));
+            }
+            if (walls != 0xFF)
+            {
+                NS_ABORT_MSG_IF(walls > Building::StoneBlocks,
+                                "Invalid walls type " << +walls << " in " << path);
+                building->SetExtWallsType(static_cast<Building::ExtWallsType_t>(walls));
+            }
+            buildings.push_back(building);
+        }
+        remaining -= records;
+    }
+}
+
+} // namespace ns3
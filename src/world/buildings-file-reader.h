@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BUILDINGS_FILE_READER_H
+#define BUILDINGS_FILE_READER_H
+
+#include <ns3/ptr.h>
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Building;
+
+/**
+ * \ingroup world
+ *
+ * \brief Bulk loader of buildings from extrusion files.
+ *
+ * Two formats are supported, selected by the file extension:
+ *
+ * - `.csv`: one building per line, with the comma separated columns
+ *   `xMin,xMax,yMin,yMax,zMin,zMax[,floors[,type[,walls[,roomsX,roomsY]]]]`,
+ *   where type and walls use the same names of the `world.buildings` JSON
+ *   objects. Empty lines, lines starting with `#` and a header line starting
+ *   with `xMin` are skipped.
+ *
+ * - any other extension: a little endian binary file starting with the 8 bytes
+ *   magic `IODBLDG1` and the uint64 number of buildings, followed by one 56
+ *   bytes record per building: 6 float64 boundaries (same order as above),
+ *   uint16 floors, uint16 roomsX, uint16 roomsY, uint8 type and uint8 walls.
+ *   Zero floors or rooms and 0xFF type or walls keep the ns-3 defaults.
+ *
+ * The file is streamed, so that only a small buffer is held in memory besides
+ * the buildings themselves.
+ */
+class BuildingsFileReader
+{
+  public:
+    /**
+     * \brief Create the buildings described in a file.
+     * \param path the path of the file.
+     * \return the buildings, which are also added to BuildingList.
+     */
+    static std::vector<Ptr<Building>> Read(const std::string& path);
+
+  private:
+    /**
+     * \brief Create the buildings described in a CSV stream.
+     * \param in the stream to read.
+     * \param path the path of the file, for error messages.
+     * \param buildings the vector to append the buildings to.
+     */
+    static void ReadCsv(std::istream& in,
+                        const std::string& path,
+                        std::vector<Ptr<Building>>& buildings);
+
+    /**
+     * \brief Create the buildings described in a binary stream.
+     * \param in the stream to read.
+     * \param path the path of the file, for error messages.
+     * \param buildings the vector to append the buildings to.
+     */
+    static void ReadBinary(std::istream& in,
+                           const std::string& path,
+                           std::vector<Ptr<Building>>& buildings);
+
+    /// Magic bytes at the beginning of a binary buildings file
+    static constexpr char BINARY_MAGIC[8] = {'I', 'O', 'D', 'B', 'L', 'D', 'G', '1'};
+    static constexpr std::size_t BINARY_RECORD_SIZE = 56; ///< Bytes per building record
+    static constexpr std::size_t BINARY_RECORDS_PER_READ = 4096; ///< Records per chunk
+};
+
+} // namespace ns3
+
+#endif /* BUILDINGS_FILE_READER_H */
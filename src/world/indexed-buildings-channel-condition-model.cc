@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "indexed-buildings-channel-condition-model.h"
+
+#include "building-index.h"
+
+#include <ns3/building.h>
+#include <ns3/log.h>
+#include <ns3/mobility-model.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("IndexedBuildingsChannelConditionModel");
+
+NS_OBJECT_ENSURE_REGISTERED(IndexedBuildingsChannelConditionModel);
+
+TypeId
+IndexedBuildingsChannelConditionModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::IndexedBuildingsChannelConditionModel")
+                            .SetParent<ChannelConditionModel>()
+                            .AddConstructor<IndexedBuildingsChannelConditionModel>();
+    return tid;
+}
+
+Ptr<ChannelCondition>
+IndexedBuildingsChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
+                                                           Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << a << b);
+
+    const Vector aPos = a->GetPosition();
+    const Vector bPos = b->GetPosition();
+    const Ptr<Building> aBuilding = BuildingIndex::GetBuilding(aPos);
+    const Ptr<Building> bBuilding = BuildingIndex::GetBuilding(bPos);
+
+    Ptr<ChannelCondition> cond = CreateObject<ChannelCondition>();
+    if (!aBuilding && !bBuilding)
+    {
+        const bool los = BuildingIndex::IsLineOfSight(aPos, bPos);
+        NS_LOG_DEBUG("a and b are outdoor, los " << los);
+        cond->SetLosCondition(los ? ChannelCondition::LosConditionValue::LOS
+                                  : ChannelCondition::LosConditionValue::NLOS);
+        cond->SetO2iCondition(ChannelCondition::O2iConditionValue::O2O);
+    }
+    else if (aBuilding && bBuilding)
+    {
+        // LOS only within the same building
+        NS_LOG_DEBUG("a and b are indoor, same building " << (aBuilding == bBuilding));
+        cond->SetLosCondition(aBuilding == bBuilding ? ChannelCondition::LosConditionValue::LOS
+                                                     : ChannelCondition::LosConditionValue::NLOS);
+        cond->SetO2iCondition(ChannelCondition::O2iConditionValue::I2I);
+    }
+    else
+    {
+        NS_LOG_DEBUG("a is " << (aBuilding ? "indoor" : "outdoor") << ", b is "
+                             << (bBuilding ? "indoor" : "outdoor"));
+        cond->SetLosCondition(ChannelCondition::LosConditionValue::NLOS);
+        cond->SetO2iCondition(ChannelCondition::O2iConditionValue::O2I);
+    }
+
+    return cond;
+}
+
+int64_t
+IndexedBuildingsChannelConditionModel::AssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+} // namespace ns3
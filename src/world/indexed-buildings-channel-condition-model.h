@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (C) 2018-2026 The IoD_Sim Authors.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef INDEXED_BUILDINGS_CHANNEL_CONDITION_MODEL_H
+#define INDEXED_BUILDINGS_CHANNEL_CONDITION_MODEL_H
+
+#include <ns3/channel-condition-model.h>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup world
+ *
+ * \brief Drop-in replacement of BuildingsChannelConditionModel backed by BuildingIndex.
+ *
+ * The LOS/NLOS and O2O/O2I/I2I conditions are determined as in
+ * BuildingsChannelConditionModel, but indoor positions and obstructions are
+ * looked up in the BVH of the buildings instead of scanning BuildingList, hence
+ * the nodes do not need a MobilityBuildingInfo either.
+ */
+class IndexedBuildingsChannelConditionModel : public ChannelConditionModel
+{
+  public:
+    /**
+     * Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    IndexedBuildingsChannelConditionModel() = default;
+    ~IndexedBuildingsChannelConditionModel() override = default;
+
+    /**
+     * Computes the condition of the channel between a and b.
+     *
+     * \param a mobility model
+     * \param b mobility model
+     * \return the condition of the channel between a and b
+     */
+    Ptr<ChannelCondition> GetChannelCondition(Ptr<const MobilityModel> a,
+                                              Ptr<const MobilityModel> b) const override;
+
+    /**
+     * The model is deterministic, no random variable stream is used.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream) override;
+};
+
+} // namespace ns3
+
+#endif /* INDEXED_BUILDINGS_CHANNEL_CONDITION_MODEL_H */
@@ -18,6 +18,11 @@
 
 #include "interest-region-container.h"
 
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 
@@ -42,6 +47,7 @@ InterestRegionContainer::Create(const DoubleVector& coords)
     auto region =
         CreateObjectWithAttributes<InterestRegion>("Coordinates", DoubleVectorValue(coords));
     m_interestRegions.push_back(region);
+    m_indexValid = false;
     return region;
 }
 
@@ -74,28 +80,123 @@ InterestRegionContainer::End(void) const
 }
 
 int
-InterestRegionContainer::IsInRegions(std::vector<int> indexes, Vector& position)
+InterestRegionContainer::IsInRegions(const std::vector<int>& indexes, const Vector& position)
 {
     if (m_interestRegions.size() == 0)
         return -2;
+    const auto containing = GetContainingRegions(position);
     for (auto index : indexes)
     {
-        if (m_interestRegions[index]->IsInside(position))
+        if (std::binary_search(containing.begin(), containing.end(), index))
             return index;
     }
     return -1;
 }
 
 int
-InterestRegionContainer::IsInRegions(Vector& position)
+InterestRegionContainer::IsInRegions(const Vector& position)
 {
     if (m_interestRegions.size() == 0)
         return -2;
-    for (int index = 0; index < (int)m_interestRegions.size(); index++)
+    const auto cell = GetCell(position);
+    if (cell == nullptr)
+        return -1;
+    for (auto index : *cell)
     {
         if (m_interestRegions[index]->IsInside(position))
             return index;
     }
     return -1;
 }
+
+std::vector<int>
+InterestRegionContainer::GetContainingRegions(const Vector& position)
+{
+    std::vector<int> containing;
+    const auto cell = GetCell(position);
+    if (cell == nullptr)
+        return containing;
+    for (auto index : *cell)
+    {
+        if (m_interestRegions[index]->IsInside(position))
+            containing.push_back(index);
+    }
+    return containing;
+}
+
+void
+InterestRegionContainer::BuildIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_cells.clear();
+    m_gridNx = 0;
+    m_gridNy = 0;
+    m_indexValid = true;
+    m_indexedGeneration = InterestRegion::GetCoordinatesGeneration();
+
+    if (m_interestRegions.empty())
+        return;
+
+    double maxX = m_interestRegions[0]->GetBox().xMax;
+    double maxY = m_interestRegions[0]->GetBox().yMax;
+    m_gridMinX = m_interestRegions[0]->GetBox().xMin;
+    m_gridMinY = m_interestRegions[0]->GetBox().yMin;
+    for (const auto& region : m_interestRegions)
+    {
+        const Box& box = region->GetBox();
+        m_gridMinX = std::min(m_gridMinX, box.xMin);
+        m_gridMinY = std::min(m_gridMinY, box.yMin);
+        maxX = std::max(maxX, box.xMax);
+        maxY = std::max(maxY, box.yMax);
+    }
+
+    // A square grid with about one region per cell keeps each bucket short
+    // while bounding the memory to O(n) cells.
+    const uint32_t side = std::ceil(std::sqrt((double)m_interestRegions.size()));
+    m_gridNx = side;
+    m_gridNy = side;
+    m_cellSizeX = (maxX > m_gridMinX) ? (maxX - m_gridMinX) / m_gridNx : 1.0;
+    m_cellSizeY = (maxY > m_gridMinY) ? (maxY - m_gridMinY) / m_gridNy : 1.0;
+    m_cells.resize(m_gridNx * m_gridNy);
+
+    auto toCell = [](double v, double min, double size, uint32_t n) {
+        const auto i = (uint32_t)std::floor((v - min) / size);
+        return std::min(i, n - 1);
+    };
+
+    for (int index = 0; index < (int)m_interestRegions.size(); index++)
+    {
+        const Box& box = m_interestRegions[index]->GetBox();
+        const auto ix0 = toCell(box.xMin, m_gridMinX, m_cellSizeX, m_gridNx);
+        const auto ix1 = toCell(box.xMax, m_gridMinX, m_cellSizeX, m_gridNx);
+        const auto iy0 = toCell(box.yMin, m_gridMinY, m_cellSizeY, m_gridNy);
+        const auto iy1 = toCell(box.yMax, m_gridMinY, m_cellSizeY, m_gridNy);
+        for (auto iy = iy0; iy <= iy1; iy++)
+            for (auto ix = ix0; ix <= ix1; ix++)
+                m_cells[iy * m_gridNx + ix].push_back(index);
+    }
+
+    NS_LOG_LOGIC("Indexed " << m_interestRegions.size() << " regions over a " << m_gridNx << "x"
+                            << m_gridNy << " grid");
+}
+
+const std::vector<int>*
+InterestRegionContainer::GetCell(const Vector& position)
+{
+    if (!m_indexValid || m_indexedGeneration != InterestRegion::GetCoordinatesGeneration())
+        BuildIndex();
+    if (m_cells.empty())
+        return nullptr;
+
+    const double maxX = m_gridMinX + m_cellSizeX * m_gridNx;
+    const double maxY = m_gridMinY + m_cellSizeY * m_gridNy;
+    if (position.x < m_gridMinX || position.x > maxX || position.y < m_gridMinY ||
+        position.y > maxY)
+        return nullptr;
+
+    const auto ix = std::min((uint32_t)((position.x - m_gridMinX) / m_cellSizeX), m_gridNx - 1);
+    const auto iy = std::min((uint32_t)((position.y - m_gridMinY) / m_cellSizeY), m_gridNy - 1);
+    return &m_cells[iy * m_gridNx + ix];
+}
+
 } // namespace ns3
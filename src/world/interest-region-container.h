@@ -91,11 +91,47 @@ class InterestRegionContainer : public Singleton<InterestRegionContainer>
      *          -2 If the region vector is empty
      *          <index> If it does belong to a region
      */
-    int IsInRegions(std::vector<int> indexes, Vector& position);
-    int IsInRegions(Vector& position);
+    int IsInRegions(const std::vector<int>& indexes, const Vector& position);
+    int IsInRegions(const Vector& position);
+
+    /**
+     * \brief Retrieve every region that contains a given point.
+     *
+     * \param position Vector of 3D coordinates describing the point.
+     * \returns the indexes of the containing regions, in ascending order.
+     */
+    std::vector<int> GetContainingRegions(const Vector& position);
+
+    /**
+     * \brief Build the uniform grid spatial index over the bounding boxes of the
+     *        regions currently stored in this container.
+     *
+     * The index is rebuilt lazily on the next query if new regions are created
+     * or the coordinates of any region are changed afterwards.
+     */
+    void BuildIndex();
 
   private:
+    /**
+     * \brief Collect the candidate regions of the grid cell enclosing a point.
+     *
+     * \param position Vector of 3D coordinates describing the point.
+     * \returns the candidate region indexes of the cell, or nullptr if the point
+     *          lies outside the indexed area.
+     */
+    const std::vector<int>* GetCell(const Vector& position);
+
     std::vector<Ptr<InterestRegion>> m_interestRegions; //!< Regions smart pointers
+
+    bool m_indexValid = false;             //!< Whether the grid reflects m_interestRegions
+    uint64_t m_indexedGeneration = 0;      //!< Region coordinates generation of the grid
+    double m_gridMinX = 0.0;               //!< Lower X bound of the indexed area
+    double m_gridMinY = 0.0;               //!< Lower Y bound of the indexed area
+    double m_cellSizeX = 1.0;              //!< Grid cell width
+    double m_cellSizeY = 1.0;              //!< Grid cell height
+    uint32_t m_gridNx = 0;                 //!< Number of grid columns
+    uint32_t m_gridNy = 0;                 //!< Number of grid rows
+    std::vector<std::vector<int>> m_cells; //!< Region indexes overlapping each cell
 };
 
 } // namespace ns3
@@ -29,6 +29,8 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("InterestRegion");
 NS_OBJECT_ENSURE_REGISTERED(InterestRegion);
 
+uint64_t InterestRegion::m_coordinatesGeneration = 0;
+
 TypeId
 InterestRegion::GetTypeId(void)
 {
@@ -75,6 +77,19 @@ InterestRegion::SetCoordinates(const DoubleVector& coords)
                 m_coordinates.Get(3),
                 m_coordinates.Get(4),
                 m_coordinates.Get(5));
+    m_coordinatesGeneration++;
+}
+
+uint64_t
+InterestRegion::GetCoordinatesGeneration()
+{
+    return m_coordinatesGeneration;
+}
+
+const Box&
+InterestRegion::GetBox() const
+{
+    return m_box;
 }
 
 bool
@@ -49,8 +49,19 @@ class InterestRegion : public Object
      */
     void SetCoordinates(const DoubleVector& coords);
 
+    /**
+     * \return the box delimiting the region
+     */
+    const Box& GetBox() const;
+
     bool IsInside(const Vector& position) const;
 
+    /**
+     * \return a counter incremented whenever the coordinates of any region change,
+     *         so that spatial indexes over the regions can detect that they are stale.
+     */
+    static uint64_t GetCoordinatesGeneration();
+
   protected:
     virtual void DoDispose(void);
     virtual void DoInitialize(void);
@@ -58,6 +69,7 @@ class InterestRegion : public Object
   private:
     Box m_box;
     DoubleVector m_coordinates;
+    static uint64_t m_coordinatesGeneration; //!< Incremented by SetCoordinates
 };
 
 } // namespace ns3
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+
+# Measure the time needed to compute a geocentric NR Radio Environment Map.
+# The reference workload is scenario/leo-nr-radio-map.json, a fixed 100x100 CoverageArea grid.
+# Run it on two builds to compare them, e.g. before and after a change to the REM helper.
+
+usage() {
+    echo "Usage: $0 [--runs N] [scenario_name]"
+    echo
+    echo "Options:"
+    echo "  --runs N        Number of repetitions (default 3)."
+    echo "  scenario_name   Name of the .json file in ./scenario (default leo-nr-radio-map)."
+    exit 1
+}
+
+runs=3
+scenario="leo-nr-radio-map"
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+    --runs)
+        runs="$2"
+        shift 2
+        ;;
+    --help)
+        usage
+        ;;
+    *)
+        scenario="$1"
+        shift
+        ;;
+    esac
+done
+
+if [[ ! -f "./scenario/${scenario}.json" ]]; then
+    echo "Error: File '${scenario}.json' doesn't exist."
+    usage
+fi
+
+./ns3/ns3 build scenario || exit 1
+
+total=0
+for ((i = 1; i <= runs; i++)); do
+    elapsed=$(./ns3/ns3 run --no-build "scenario --config=../scenario/${scenario}.json --radioMaps" 2>&1 |
+        sed -n 's/.*Total time needed to create the REM map: \([0-9.e+-]*\) seconds.*/\1/p' |
+        awk '{ sum += $1 } END { print sum + 0 }')
+    echo "run ${i}: ${elapsed} s"
+    total=$(awk -v a="${total}" -v b="${elapsed}" 'BEGIN { print a + b }')
+done
+
+awk -v t="${total}" -v n="${runs}" 'BEGIN { printf "mean REM time over %d runs: %.3f s\n", n, t / n }'